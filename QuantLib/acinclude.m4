@@ -171,6 +171,35 @@ AC_DEFUN([QL_CHECK_BOOST_TEST_STREAM],
     ])
 ])
 
+# QL_CHECK_BOOST_THREAD
+# ---------------------
+# Check whether the Boost thread library is available and add it to LIBS
+AC_DEFUN([QL_CHECK_BOOST_THREAD],
+[AC_MSG_CHECKING([for Boost thread library])
+ AC_REQUIRE([AC_PROG_CC])
+ ql_original_LIBS=$LIBS
+ boost_thread_found=no
+ for boost_lib in boost_thread boost_thread-mt ; do
+     for boost_system_lib in boost_system boost_system-mt ; do
+         LIBS="$ql_original_LIBS -l$boost_lib -l$boost_system_lib"
+         AC_LINK_IFELSE([AC_LANG_PROGRAM(
+             [[@%:@include <boost/thread/recursive_mutex.hpp>]],
+             [[boost::recursive_mutex m; m.lock(); m.unlock();]])],
+             [boost_thread_found=$boost_lib
+              break 2],
+             [])
+     done
+ done
+ if test "$boost_thread_found" = no ; then
+     LIBS="$ql_original_LIBS"
+     AC_MSG_RESULT([no])
+     AC_MSG_ERROR([Boost thread library not found.
+                   It is required by the thread-safe observer pattern.])
+ else
+     AC_MSG_RESULT([$boost_thread_found])
+ fi
+])
+
 # QL_CHECK_BOOST
 # ------------------------
 # Boost-related tests
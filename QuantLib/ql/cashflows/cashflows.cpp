@@ -414,27 +414,63 @@ namespace QuantLib {
     // YieldTermStructure utility functions
     namespace {
 
+        /* collects the payment times and weights of the visited
+           cashflows; the sums are calculated afterwards with a single
+           batch evaluation of the discount curve.  Amounts are only
+           collected when requested, so that the bps alone can be
+           calculated without pricing the coupons. */
         class BPSCalculator : public AcyclicVisitor,
                               public Visitor<CashFlow>,
                               public Visitor<Coupon> {
           public:
-            BPSCalculator(const YieldTermStructure& discountCurve)
-            : discountCurve_(discountCurve), bps_(0.0), nonSensNPV_(0.0) {}
+            BPSCalculator(const YieldTermStructure& discountCurve,
+                          bool collectAmounts = true)
+            : discountCurve_(discountCurve),
+              collectAmounts_(collectAmounts), calculated_(false),
+              npv_(0.0), bps_(0.0), nonSensNPV_(0.0) {}
             void visit(Coupon& c) {
-                Real bps = c.nominal() *
-                           c.accrualPeriod() *
-                           discountCurve_.discount(c.date());
-                bps_ += bps;
+                Real amount = collectAmounts_ ? c.amount() : 0.0;
+                add(c.date(), amount, c.nominal()*c.accrualPeriod(), 0.0);
             }
             void visit(CashFlow& cf) {
-                nonSensNPV_ += cf.amount() * 
-                               discountCurve_.discount(cf.date());
+                if (!collectAmounts_)
+                    return;
+                const Real amount = cf.amount();
+                add(cf.date(), amount, 0.0, amount);
             }
-            Real bps() const { return bps_; }
-            Real nonSensNPV() const { return nonSensNPV_; }
+            Real npv() const { calculate(); return npv_; }
+            Real bps() const { calculate(); return bps_; }
+            Real nonSensNPV() const { calculate(); return nonSensNPV_; }
           private:
+            void add(const Date& d, Real amount, Real bps, Real nonSens) {
+                times_.push_back(discountCurve_.timeFromReference(d));
+                amounts_.push_back(amount);
+                bpsWeights_.push_back(bps);
+                nonSensAmounts_.push_back(nonSens);
+                calculated_ = false;
+            }
+            void calculate() const {
+                if (calculated_)
+                    return;
+                npv_ = bps_ = nonSensNPV_ = 0.0;
+                const Size n = times_.size();
+                if (n > 0) {
+                    std::vector<DiscountFactor> discounts(n);
+                    discountCurve_.discounts(times_, &discounts[0]);
+                    for (Size i=0; i<n; ++i) {
+                        npv_ += amounts_[i] * discounts[i];
+                        bps_ += bpsWeights_[i] * discounts[i];
+                        nonSensNPV_ += nonSensAmounts_[i] * discounts[i];
+                    }
+                }
+                calculated_ = true;
+            }
             const YieldTermStructure& discountCurve_;
-            Real bps_, nonSensNPV_;
+            bool collectAmounts_;
+            std::vector<Time> times_;
+            std::vector<Real> amounts_, bpsWeights_, nonSensAmounts_;
+            mutable bool calculated_;
+            mutable Real npv_, bps_, nonSensNPV_;
         };
 
         const Spread basisPoint_ = 1.0e-4;
@@ -455,13 +491,27 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real totalNPV = 0.0;
+        // discount factors are obtained with a single call
+        std::vector<Time> times;
+        std::vector<Real> amounts;
+        times.reserve(leg.size());
+        amounts.reserve(leg.size());
         for (Size i=0; i<leg.size(); ++i) {
             if (!leg[i]->hasOccurred(settlementDate,
                                      includeSettlementDateFlows) &&
-                !leg[i]->tradingExCoupon(settlementDate))
-                totalNPV += leg[i]->amount() *
-                            discountCurve.discount(leg[i]->date());
+                !leg[i]->tradingExCoupon(settlementDate)) {
+                amounts.push_back(leg[i]->amount());
+                times.push_back(
+                          discountCurve.timeFromReference(leg[i]->date()));
+            }
+        }
+
+        Real totalNPV = 0.0;
+        if (!times.empty()) {
+            std::vector<DiscountFactor> discounts(times.size());
+            discountCurve.discounts(times, &discounts[0]);
+            for (Size i=0; i<times.size(); ++i)
+                totalNPV += amounts[i] * discounts[i];
         }
 
         return totalNPV/discountCurve.discount(npvDate);
@@ -481,7 +531,7 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        BPSCalculator calc(discountCurve);
+        BPSCalculator calc(discountCurve, false);
         for (Size i=0; i<leg.size(); ++i) {
             if (!leg[i]->hasOccurred(settlementDate,
                                      includeSettlementDateFlows) &&
@@ -499,28 +549,27 @@ namespace QuantLib {
                            Real& npv,
                            Real& bps) {
 
-        npv = 0.0;
-        if (leg.empty()) {
-            bps = 0.0;
+        npv = bps = 0.0;
+        if (leg.empty())
             return;
-        }
 
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        BPSCalculator calc(discountCurve);
         for (Size i=0; i<leg.size(); ++i) {
             CashFlow& cf = *leg[i];
             if (!cf.hasOccurred(settlementDate,
                                 includeSettlementDateFlows) &&
-                !cf.tradingExCoupon(settlementDate)) {
-                boost::shared_ptr<Coupon> cp =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                Real df = discountCurve.discount(cf.date());
-                npv += cf.amount() * df;
-                if(cp != NULL)
-                    bps += cp->nominal() * cp->accrualPeriod() * df;
-            }
+                !cf.tradingExCoupon(settlementDate))
+                cf.accept(calc);
         }
         DiscountFactor d = discountCurve.discount(npvDate);
-        npv /= d;
-        bps = basisPoint_ * bps / d;
+        npv = calc.npv()/d;
+        bps = basisPoint_ * calc.bps() / d;
     }
 
     Rate CashFlows::atmRate(const Leg& leg,
@@ -536,19 +585,16 @@ namespace QuantLib {
         if (npvDate == Date())
             npvDate = settlementDate;
 
-        Real npv = 0.0;
         BPSCalculator calc(discountCurve);
         for (Size i=0; i<leg.size(); ++i) {
             CashFlow& cf = *leg[i];
             if (!cf.hasOccurred(settlementDate,
                                 includeSettlementDateFlows) &&
-                !cf.tradingExCoupon(settlementDate)) {
-                npv += cf.amount() *
-                       discountCurve.discount(cf.date());
+                !cf.tradingExCoupon(settlementDate))
                 cf.accept(calc);
-            }
         }
 
+        const Real npv = calc.npv();
         if (targetNpv==Null<Real>())
             targetNpv = npv - calc.nonSensNPV();
         else {
@@ -565,6 +611,42 @@ namespace QuantLib {
         return targetNpv/bps;
     }
 
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve) {
+        if (leg.empty())
+            return 0.0;
+
+        std::vector<Time> times(leg.size());
+        for (Size i=0; i<leg.size(); ++i)
+            times[i] = discountCurve.timeFromReference(leg.dates()[i]);
+        std::vector<DiscountFactor> discounts(leg.size());
+        discountCurve.discounts(times, &discounts[0]);
+
+        const std::vector<Real>& amounts = leg.amounts();
+        Real totalNPV = 0.0;
+        for (Size i=0; i<leg.size(); ++i)
+            totalNPV += amounts[i] * discounts[i];
+        return totalNPV/discountCurve.discount(leg.npvDate());
+    }
+
+    Real CashFlows::bps(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve) {
+        if (leg.empty())
+            return 0.0;
+
+        std::vector<Time> times(leg.size());
+        for (Size i=0; i<leg.size(); ++i)
+            times[i] = discountCurve.timeFromReference(leg.dates()[i]);
+        std::vector<DiscountFactor> discounts(leg.size());
+        discountCurve.discounts(times, &discounts[0]);
+
+        const std::vector<Real>& accruals = leg.accruals();
+        Real bps = 0.0;
+        for (Size i=0; i<leg.size(); ++i)
+            bps += accruals[i] * discounts[i];
+        return basisPoint_*bps/discountCurve.discount(leg.npvDate());
+    }
+
     // IRR utility functions
     namespace {
 
@@ -579,119 +661,54 @@ namespace QuantLib {
                 return -1;
         }
 
-        Real simpleDuration(const Leg& leg,
-                            const InterestRate& y,
-                            bool includeSettlementDateFlows,
-                            Date settlementDate,
-                            Date npvDate) {
-            if (leg.empty())
-                return 0.0;
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-            if (npvDate == Date())
-                npvDate = settlementDate;
+        /* The functions below take the cash-flow amounts and the
+           year fractions between successive payments, as returned
+           by CompiledLeg::yearFractions() for the day counter of
+           the given yield. */
+
+        Real yieldNpv(const std::vector<Real>& amounts,
+                      const std::vector<Time>& periods,
+                      const InterestRate& y) {
+            Real npv = 0.0;
+            DiscountFactor discount = 1.0;
+            for (Size i=0; i<amounts.size(); ++i) {
+                discount *= y.discountFactor(periods[i]);
+                npv += amounts[i] * discount;
+            }
+            return npv;
+        }
 
+        Real simpleDuration(const std::vector<Real>& amounts,
+                            const std::vector<Time>& periods,
+                            const InterestRate& y) {
             Real P = 0.0;
             Real dPdy = 0.0;
             Time t = 0.0;
-            Date lastDate = npvDate;
-            Date refStartDate, refEndDate;
-            const DayCounter& dc = y.dayCounter();
-            for (Size i=0; i<leg.size(); ++i) {
-                if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                    continue;
-
-                Real c = leg[i]->amount();
-                if (leg[i]->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
-                }
-
-                Date couponDate = leg[i]->date();
-                shared_ptr<Coupon> coupon =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                if (coupon) {
-                    refStartDate = coupon->referencePeriodStart();
-                    refEndDate = coupon->referencePeriodEnd();
-                } else {
-                    if (lastDate == npvDate) {
-                        // we don't have a previous coupon date,
-                        // so we fake it
-                        refStartDate = couponDate - 1*Years;
-                    } else  {
-                        refStartDate = lastDate;
-                    }
-                    refEndDate = couponDate;
-                }
-
-                t += dc.yearFraction(lastDate, couponDate,
-                                     refStartDate, refEndDate);
+            for (Size i=0; i<amounts.size(); ++i) {
+                Real c = amounts[i];
+                t += periods[i];
 
                 DiscountFactor B = y.discountFactor(t);
                 P += c * B;
                 dPdy += t * c * B;
-                
-                lastDate = couponDate;
             }
             if (P == 0.0) // no cashflows
                 return 0.0;
             return dPdy/P;
         }
 
-        Real modifiedDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
-            if (leg.empty())
-                return 0.0;
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-            if (npvDate == Date())
-                npvDate = settlementDate;
-
+        Real modifiedDuration(const std::vector<Real>& amounts,
+                              const std::vector<Time>& periods,
+                              const InterestRate& y) {
             Real P = 0.0;
             Time t = 0.0;
             Real dPdy = 0.0;
             Rate r = y.rate();
             Natural N = y.frequency();
-            Date lastDate = npvDate;
-            Date refStartDate, refEndDate;
-            const DayCounter& dc = y.dayCounter();
-            for (Size i=0; i<leg.size(); ++i) {
-                if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                    continue;
-
-                Real c = leg[i]->amount();
-                if (leg[i]->tradingExCoupon(settlementDate)) {
-                    c = 0.0;
-                }
+            for (Size i=0; i<amounts.size(); ++i) {
+                Real c = amounts[i];
+                t += periods[i];
 
-                Date couponDate = leg[i]->date();
-                shared_ptr<Coupon> coupon =
-                    boost::dynamic_pointer_cast<Coupon>(leg[i]);
-                if (coupon) {
-                    refStartDate = coupon->referencePeriodStart();
-                    refEndDate = coupon->referencePeriodEnd();
-                } else {
-                    if (lastDate == npvDate) {
-                        // we don't have a previous coupon date,
-                        // so we fake it
-                        refStartDate = couponDate - 1*Years;
-                    } else  {
-                        refStartDate = lastDate;
-                    }
-                    refEndDate = couponDate;
-                }
-                
-                t += dc.yearFraction(lastDate, couponDate,
-                                     refStartDate, refEndDate);
-                
                 DiscountFactor B = y.discountFactor(t);
                 P += c * B;
                 switch (y.compounding()) {
@@ -714,7 +731,6 @@ namespace QuantLib {
                     QL_FAIL("unknown compounding convention (" <<
                             Integer(y.compounding()) << ")");
                 }
-                lastDate = couponDate;
             }
 
             if (P == 0.0) // no cashflows
@@ -722,58 +738,80 @@ namespace QuantLib {
             return -dPdy/P; // reverse derivative sign
         }
 
-        Real macaulayDuration(const Leg& leg,
-                              const InterestRate& y,
-                              bool includeSettlementDateFlows,
-                              Date settlementDate,
-                              Date npvDate) {
+        Real macaulayDuration(const std::vector<Real>& amounts,
+                              const std::vector<Time>& periods,
+                              const InterestRate& y) {
 
             QL_REQUIRE(y.compounding() == Compounded,
                        "compounded rate required");
 
             return (1.0+y.rate()/y.frequency()) *
-                modifiedDuration(leg, y,
-                                 includeSettlementDateFlows,
-                                 settlementDate, npvDate);
+                modifiedDuration(amounts, periods, y);
+        }
+
+        Real yieldConvexity(const std::vector<Real>& amounts,
+                            const std::vector<Time>& periods,
+                            const InterestRate& y) {
+            Real P = 0.0;
+            Time t = 0.0;
+            Real d2Pdy2 = 0.0;
+            Rate r = y.rate();
+            Natural N = y.frequency();
+            for (Size i=0; i<amounts.size(); ++i) {
+                Real c = amounts[i];
+                t += periods[i];
+
+                DiscountFactor B = y.discountFactor(t);
+                P += c * B;
+                switch (y.compounding()) {
+                  case Simple:
+                    d2Pdy2 += c * 2.0*B*B*B*t*t;
+                    break;
+                  case Compounded:
+                    d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                    break;
+                  case Continuous:
+                    d2Pdy2 += c * B*t*t;
+                    break;
+                  case SimpleThenCompounded:
+                    if (t<=1.0/N)
+                        d2Pdy2 += c * 2.0*B*B*B*t*t;
+                    else
+                        d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
+                    break;
+                  default:
+                    QL_FAIL("unknown compounding convention (" <<
+                            Integer(y.compounding()) << ")");
+                }
+            }
+
+            if (P == 0.0)
+                // no cashflows
+                return 0.0;
+
+            return d2Pdy2/P;
         }
 
         class IrrFinder : public std::unary_function<Rate, Real> {
           public:
-            IrrFinder(const Leg& leg,
+            IrrFinder(const CompiledLeg& leg,
                       Real npv,
                       const DayCounter& dayCounter,
                       Compounding comp,
-                      Frequency freq,
-                      bool includeSettlementDateFlows,
-                      Date settlementDate,
-                      Date npvDate)
-            : leg_(leg), npv_(npv),
-              dayCounter_(dayCounter), compounding_(comp), frequency_(freq),
-              includeSettlementDateFlows_(includeSettlementDateFlows),
-              settlementDate_(settlementDate),
-              npvDate_(npvDate) {
-
-
-            if (settlementDate == Date())
-                settlementDate = Settings::instance().evaluationDate();
-
-                if (npvDate == Date())
-                    npvDate = settlementDate;
-
+                      Frequency freq)
+            : amounts_(leg.amounts()), periods_(leg.yearFractions(dayCounter)),
+              npv_(npv),
+              dayCounter_(dayCounter), compounding_(comp), frequency_(freq) {
                 checkSign();
             }
             Real operator()(Rate y) const {
                 InterestRate yield(y, dayCounter_, compounding_, frequency_);
-                Real NPV = CashFlows::npv(leg_, yield,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
+                Real NPV = yieldNpv(amounts_, periods_, yield);
                 return npv_ - NPV;
             }
             Real derivative(Rate y) const {
                 InterestRate yield(y, dayCounter_, compounding_, frequency_);
-                return modifiedDuration(leg_, yield,
-                                        includeSettlementDateFlows_,
-                                        settlementDate_, npvDate_);
+                return modifiedDuration(amounts_, periods_, yield);
             }
           private:
             void checkSign() const {
@@ -783,17 +821,14 @@ namespace QuantLib {
 
                 Integer lastSign = sign(-npv_),
                         signChanges = 0;
-                for (Size i = 0; i < leg_.size(); ++i) {
-                    if (!leg_[i]->hasOccurred(settlementDate_,
-                                              includeSettlementDateFlows_) &&
-                        !leg_[i]->tradingExCoupon(settlementDate_)) {
-                        Integer thisSign = sign(leg_[i]->amount());
-                        if (lastSign * thisSign < 0) // sign change
-                            signChanges++;
-
-                        if (thisSign != 0)
-                            lastSign = thisSign;
-                    }
+                for (Size i = 0; i < amounts_.size(); ++i) {
+                    // flows trading ex-coupon have a null amount
+                    Integer thisSign = sign(amounts_[i]);
+                    if (lastSign * thisSign < 0) // sign change
+                        signChanges++;
+
+                    if (thisSign != 0)
+                        lastSign = thisSign;
                 }
                 QL_REQUIRE(signChanges > 0,
                            "the given cash flows cannot result in the given market "
@@ -818,17 +853,14 @@ namespace QuantLib {
                 };
                 */
             }
-            const Leg& leg_;
+            const std::vector<Real>& amounts_;
+            std::vector<Time> periods_;
             Real npv_;
             DayCounter dayCounter_;
             Compounding compounding_;
             Frequency frequency_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
         };
 
-
-
     } // anonymous namespace ends here
 
     Real CashFlows::npv(const Leg& leg,
@@ -840,52 +872,14 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-        Real npv = 0.0;
-        DiscountFactor discount = 1.0;
-        Date lastDate = npvDate;
-        Date refStartDate, refEndDate;
-
-        for (Size i=0; i<leg.size(); ++i) {
-            if (leg[i]->hasOccurred(settlementDate,
-                                    includeSettlementDateFlows))
-                continue;
-
-            Date couponDate = leg[i]->date();
-            Real amount = leg[i]->amount();
-            if (leg[i]->tradingExCoupon(settlementDate)) {
-                amount = 0.0;
-            }
-
-            shared_ptr<Coupon> coupon =
-                boost::dynamic_pointer_cast<Coupon>(leg[i]);
-            if (coupon) {
-                refStartDate = coupon->referencePeriodStart();
-                refEndDate = coupon->referencePeriodEnd();
-            } else {
-                if (lastDate == npvDate) {
-                    // we don't have a previous coupon date,
-                    // so we fake it
-                    refStartDate = couponDate - 1*Years;
-                } else  {
-                    refStartDate = lastDate;
-                }
-                refEndDate = couponDate;
-            }
-            DiscountFactor b = y.discountFactor(lastDate, couponDate,
-                                                refStartDate, refEndDate);
-            discount *= b;
-            lastDate = couponDate;
-
-            npv += amount * discount;
-        }
+        return npv(CompiledLeg(leg, includeSettlementDateFlows,
+                               settlementDate, npvDate),
+                   y);
+    }
 
-        return npv;
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        const InterestRate& y) {
+        return yieldNpv(leg.amounts(), leg.yearFractions(y.dayCounter()), y);
     }
 
     Real CashFlows::npv(const Leg& leg,
@@ -947,13 +941,25 @@ namespace QuantLib {
                           Real accuracy,
                           Size maxIterations,
                           Rate guess) {
+        return yield(CompiledLeg(leg, includeSettlementDateFlows,
+                                 settlementDate, npvDate),
+                     npv, dayCounter, compounding, frequency,
+                     accuracy, maxIterations, guess);
+    }
+
+    Rate CashFlows::yield(const CompiledLeg& leg,
+                          Real npv,
+                          const DayCounter& dayCounter,
+                          Compounding compounding,
+                          Frequency frequency,
+                          Real accuracy,
+                          Size maxIterations,
+                          Rate guess) {
         //Brent solver;
         NewtonSafe solver;
         solver.setMaxEvaluations(maxIterations);
         IrrFinder objFunction(leg, npv,
-                              dayCounter, compounding, frequency,
-                              includeSettlementDateFlows,
-                              settlementDate, npvDate);
+                              dayCounter, compounding, frequency);
         return solver.solve(objFunction, accuracy, guess, guess/10.0);
     }
 
@@ -968,25 +974,26 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
+        return duration(CompiledLeg(leg, includeSettlementDateFlows,
+                                    settlementDate, npvDate),
+                        rate, type);
+    }
 
-        if (npvDate == Date())
-            npvDate = settlementDate;
+    Time CashFlows::duration(const CompiledLeg& leg,
+                             const InterestRate& rate,
+                             Duration::Type type) {
+
+        if (leg.empty())
+            return 0.0;
 
+        std::vector<Time> periods = leg.yearFractions(rate.dayCounter());
         switch (type) {
           case Duration::Simple:
-            return simpleDuration(leg, rate,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
+            return simpleDuration(leg.amounts(), periods, rate);
           case Duration::Modified:
-            return modifiedDuration(leg, rate,
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
+            return modifiedDuration(leg.amounts(), periods, rate);
           case Duration::Macaulay:
-            return macaulayDuration(leg, rate,
-                                    includeSettlementDateFlows,
-                                    settlementDate, npvDate);
+            return macaulayDuration(leg.amounts(), periods, rate);
           default:
             QL_FAIL("unknown duration type");
         }
@@ -1015,83 +1022,16 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-        const DayCounter& dc = y.dayCounter();
-
-        Real P = 0.0;
-        Time t = 0.0;
-        Real d2Pdy2 = 0.0;
-        Rate r = y.rate();
-        Natural N = y.frequency();
-        Date lastDate = npvDate;
-        Date refStartDate, refEndDate;
-        for (Size i=0; i<leg.size(); ++i) {
-            if (leg[i]->hasOccurred(settlementDate,
-                                        includeSettlementDateFlows))
-                continue;
-            
-            Real c = leg[i]->amount();
-            if (leg[i]->tradingExCoupon(settlementDate)) {
-                c = 0.0;
-            }
-
-            Date couponDate = leg[i]->date();
-            shared_ptr<Coupon> coupon =
-                boost::dynamic_pointer_cast<Coupon>(leg[i]);
-            if (coupon) {
-                refStartDate = coupon->referencePeriodStart();
-                refEndDate = coupon->referencePeriodEnd();
-            } else {
-                if (lastDate == npvDate) {
-                    // we don't have a previous coupon date,
-                    // so we fake it
-                    refStartDate = couponDate - 1*Years;
-                } else  {
-                    refStartDate = lastDate;
-                }
-                refEndDate = couponDate;
-            }
-            
-            t += dc.yearFraction(lastDate, couponDate,
-                                 refStartDate, refEndDate);
-            
-            DiscountFactor B = y.discountFactor(t);
-            P += c * B;
-            switch (y.compounding()) {
-              case Simple:
-                d2Pdy2 += c * 2.0*B*B*B*t*t;
-                break;
-              case Compounded:
-                d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
-                break;
-              case Continuous:
-                d2Pdy2 += c * B*t*t;
-                break;
-              case SimpleThenCompounded:
-                if (t<=1.0/N)
-                    d2Pdy2 += c * 2.0*B*B*B*t*t;
-                else
-                    d2Pdy2 += c * B*t*(N*t+1)/(N*(1+r/N)*(1+r/N));
-                break;
-              default:
-                QL_FAIL("unknown compounding convention (" <<
-                        Integer(y.compounding()) << ")");
-            }
-            lastDate = couponDate;
-        }
-
-        if (P == 0.0)
-            // no cashflows
-            return 0.0;
-
-        return d2Pdy2/P;
+        return convexity(CompiledLeg(leg, includeSettlementDateFlows,
+                                     settlementDate, npvDate),
+                         y);
     }
 
+    Real CashFlows::convexity(const CompiledLeg& leg,
+                              const InterestRate& y) {
+        return yieldConvexity(leg.amounts(),
+                              leg.yearFractions(y.dayCounter()), y);
+    }
 
     Real CashFlows::convexity(const Leg& leg,
                               Rate yield,
@@ -1114,23 +1054,19 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
+        return basisPointValue(CompiledLeg(leg, includeSettlementDateFlows,
+                                           settlementDate, npvDate),
+                               y);
+    }
 
-        if (npvDate == Date())
-            npvDate = settlementDate;
+    Real CashFlows::basisPointValue(const CompiledLeg& leg,
+                                    const InterestRate& y) {
+        std::vector<Time> periods = leg.yearFractions(y.dayCounter());
 
-        Real npv = CashFlows::npv(leg, y,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-        Real modifiedDuration = CashFlows::duration(leg, y,
-                                                    Duration::Modified,
-                                                    includeSettlementDateFlows,
-                                                    settlementDate, npvDate);
-        Real convexity = CashFlows::convexity(leg, y,
-                                              includeSettlementDateFlows,
-                                              settlementDate, npvDate);
-        Real delta = -modifiedDuration*npv;
+        Real npv = yieldNpv(leg.amounts(), periods, y);
+        Real modDuration = modifiedDuration(leg.amounts(), periods, y);
+        Real convexity = yieldConvexity(leg.amounts(), periods, y);
+        Real delta = -modDuration*npv;
         Real gamma = (convexity/100.0)*npv;
 
         Real shift = 0.0001;
@@ -1161,22 +1097,21 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
+        return yieldValueBasisPoint(
+                   CompiledLeg(leg, includeSettlementDateFlows,
+                               settlementDate, npvDate),
+                   y);
+    }
 
-        if (npvDate == Date())
-            npvDate = settlementDate;
+    Real CashFlows::yieldValueBasisPoint(const CompiledLeg& leg,
+                                         const InterestRate& y) {
+        std::vector<Time> periods = leg.yearFractions(y.dayCounter());
 
-        Real npv = CashFlows::npv(leg, y,
-                                  includeSettlementDateFlows,
-                                  settlementDate, npvDate);
-        Real modifiedDuration = CashFlows::duration(leg, y,
-                                                    Duration::Modified,
-                                                    includeSettlementDateFlows,
-                                                    settlementDate, npvDate);
+        Real npv = yieldNpv(leg.amounts(), periods, y);
+        Real modDuration = modifiedDuration(leg.amounts(), periods, y);
 
         Real shift = 0.01;
-        return (1.0/(-npv*modifiedDuration))*shift;
+        return (1.0/(-npv*modDuration))*shift;
     }
 
     Real CashFlows::yieldValueBasisPoint(const Leg& leg,
@@ -1195,49 +1130,73 @@ namespace QuantLib {
     // Z-spread utility functions
     namespace {
 
+        /* Discounts a compiled leg on the discount curve spreaded
+           as in ZeroSpreadedTermStructure. The zero rates of the
+           original curve at the payment dates are calculated once,
+           so that the npv can be obtained for any spread without
+           querying the curve again. */
+        class ZSpreadedLeg {
+          public:
+            ZSpreadedLeg(const CompiledLeg& leg,
+                         const YieldTermStructure& discountCurve,
+                         Compounding comp,
+                         Frequency freq)
+            : amounts_(leg.amounts()) {
+                // if the discount curve allows extrapolation, let's
+                // the spreaded curve do too.
+                bool extrapolate = discountCurve.allowsExtrapolation();
+                times_.reserve(leg.size()+1);
+                for (Size i=0; i<leg.size(); ++i)
+                    times_.push_back(
+                             discountCurve.timeFromReference(leg.dates()[i]));
+                times_.push_back(
+                             discountCurve.timeFromReference(leg.npvDate()));
+                zeroRates_.reserve(times_.size());
+                for (Size i=0; i<times_.size(); ++i)
+                    zeroRates_.push_back(
+                        discountCurve.zeroRate(times_[i], comp, freq,
+                                               extrapolate));
+            }
+            Real npv(Spread zSpread) const {
+                Real npv = 0.0;
+                for (Size i=0; i<amounts_.size(); ++i)
+                    npv += amounts_[i] * discount(i, zSpread);
+                return npv/discount(amounts_.size(), zSpread);
+            }
+          private:
+            DiscountFactor discount(Size i, Spread zSpread) const {
+                const Time t = times_[i];
+                if (t == 0.0)
+                    return 1.0;
+                const InterestRate& zeroRate = zeroRates_[i];
+                InterestRate spreadedRate(zeroRate + zSpread,
+                                          zeroRate.dayCounter(),
+                                          zeroRate.compounding(),
+                                          zeroRate.frequency());
+                return std::exp(
+                    -spreadedRate.equivalentRate(Continuous, NoFrequency, t)
+                    * t);
+            }
+            const std::vector<Real>& amounts_;
+            std::vector<Time> times_;
+            std::vector<InterestRate> zeroRates_;
+        };
+
         class ZSpreadFinder : public std::unary_function<Rate, Real> {
           public:
-            ZSpreadFinder(const Leg& leg,
+            ZSpreadFinder(const CompiledLeg& leg,
                           const shared_ptr<YieldTermStructure>& discountCurve,
                           Real npv,
-                          const DayCounter& dc,
                           Compounding comp,
-                          Frequency freq,
-                          bool includeSettlementDateFlows,
-                          Date settlementDate,
-                          Date npvDate)
-            : leg_(leg), npv_(npv), zSpread_(new SimpleQuote(0.0)),
-              curve_(Handle<YieldTermStructure>(discountCurve),
-                     Handle<Quote>(zSpread_), comp, freq, dc),
-              includeSettlementDateFlows_(includeSettlementDateFlows),
-              settlementDate_(settlementDate),
-              npvDate_(npvDate) {
-
-                if (settlementDate == Date())
-                    settlementDate = Settings::instance().evaluationDate();
-
-                if (npvDate == Date())
-                    npvDate = settlementDate;
-
-                // if the discount curve allows extrapolation, let's
-                // the spreaded curve do too.
-                curve_.enableExtrapolation(
-                                  discountCurve->allowsExtrapolation());
-            }
+                          Frequency freq)
+            : leg_(leg, *discountCurve, comp, freq), npv_(npv) {}
             Real operator()(Rate zSpread) const {
-                zSpread_->setValue(zSpread);
-                Real NPV = CashFlows::npv(leg_, curve_,
-                                          includeSettlementDateFlows_,
-                                          settlementDate_, npvDate_);
+                Real NPV = leg_.npv(zSpread);
                 return npv_ - NPV;
             }
           private:
-            const Leg& leg_;
+            ZSpreadedLeg leg_;
             Real npv_;
-            shared_ptr<SimpleQuote> zSpread_;
-            ZeroSpreadedTermStructure curve_;
-            bool includeSettlementDateFlows_;
-            Date settlementDate_, npvDate_;
         };
 
     } // anonymous namespace ends here
@@ -1255,25 +1214,22 @@ namespace QuantLib {
         if (leg.empty())
             return 0.0;
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
-        Handle<YieldTermStructure> discountCurveHandle(discountCurve);
-        Handle<Quote> zSpreadQuoteHandle(shared_ptr<Quote>(new
-            SimpleQuote(zSpread)));
-
-        ZeroSpreadedTermStructure spreadedCurve(discountCurveHandle,
-                                                zSpreadQuoteHandle,
-                                                comp, freq, dc);
+        return npv(CompiledLeg(leg, includeSettlementDateFlows,
+                               settlementDate, npvDate),
+                   discountCurve, zSpread, dc, comp, freq);
+    }
 
-        spreadedCurve.enableExtrapolation(discountCurveHandle->allowsExtrapolation());
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        const shared_ptr<YieldTermStructure>& discountCurve,
+                        Spread zSpread,
+                        const DayCounter&,
+                        Compounding comp,
+                        Frequency freq) {
+        // as in ZeroSpreadedTermStructure, the day counter is unused
+        if (leg.empty())
+            return 0.0;
 
-        return npv(leg, spreadedCurve,
-                   includeSettlementDateFlows,
-                   settlementDate, npvDate);
+        return ZSpreadedLeg(leg, *discountCurve, comp, freq).npv(zSpread);
     }
 
     Spread CashFlows::zSpread(const Leg& leg,
@@ -1288,20 +1244,28 @@ namespace QuantLib {
                               Real accuracy,
                               Size maxIterations,
                               Rate guess) {
+        return zSpread(CompiledLeg(leg, includeSettlementDateFlows,
+                                   settlementDate, npvDate),
+                       npv, discount,
+                       dayCounter, compounding, frequency,
+                       accuracy, maxIterations, guess);
+    }
 
-        if (settlementDate == Date())
-            settlementDate = Settings::instance().evaluationDate();
-
-        if (npvDate == Date())
-            npvDate = settlementDate;
-
+    Spread CashFlows::zSpread(const CompiledLeg& leg,
+                              Real npv,
+                              const shared_ptr<YieldTermStructure>& discount,
+                              const DayCounter&,
+                              Compounding compounding,
+                              Frequency frequency,
+                              Real accuracy,
+                              Size maxIterations,
+                              Rate guess) {
         Brent solver;
         solver.setMaxEvaluations(maxIterations);
         ZSpreadFinder objFunction(leg,
                                   discount,
                                   npv,
-                                  dayCounter, compounding, frequency, includeSettlementDateFlows,
-                                  settlementDate, npvDate);
+                                  compounding, frequency);
         Real step = 0.01;
         return solver.solve(objFunction, accuracy, guess, step);
     }
@@ -28,6 +28,7 @@
 #define quantlib_cashflows_hpp
 
 #include <ql/cashflows/duration.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflow.hpp>
 #include <ql/interestrate.hpp>
 #include <boost/shared_ptr.hpp>
@@ -400,6 +401,53 @@ namespace QuantLib {
         }
         //@}
 
+        //! \name Compiled-leg functions
+        /*! These overloads run against a CompiledLeg snapshot; the
+            settlement and npv dates are the ones it was built with.
+            The functions above taking a Leg build the snapshot once
+            per call and forward to them.
+        */
+        //@{
+        static Real npv(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve);
+        static Real bps(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve);
+        static Real npv(const CompiledLeg& leg,
+                        const InterestRate& yield);
+        static Rate yield(const CompiledLeg& leg,
+                          Real npv,
+                          const DayCounter& dayCounter,
+                          Compounding compounding,
+                          Frequency frequency,
+                          Real accuracy = 1.0e-10,
+                          Size maxIterations = 100,
+                          Rate guess = 0.05);
+        static Time duration(const CompiledLeg& leg,
+                             const InterestRate& yield,
+                             Duration::Type type);
+        static Real convexity(const CompiledLeg& leg,
+                              const InterestRate& yield);
+        static Real basisPointValue(const CompiledLeg& leg,
+                                    const InterestRate& yield);
+        static Real yieldValueBasisPoint(const CompiledLeg& leg,
+                                         const InterestRate& yield);
+        static Real npv(const CompiledLeg& leg,
+                        const boost::shared_ptr<YieldTermStructure>& discount,
+                        Spread zSpread,
+                        const DayCounter& dayCounter,
+                        Compounding compounding,
+                        Frequency frequency);
+        static Spread zSpread(const CompiledLeg& leg,
+                              Real npv,
+                              const boost::shared_ptr<YieldTermStructure>&,
+                              const DayCounter& dayCounter,
+                              Compounding compounding,
+                              Frequency frequency,
+                              Real accuracy = 1.0e-10,
+                              Size maxIterations = 100,
+                              Rate guess = 0.0);
+        //@}
+
     };
 
 }
@@ -0,0 +1,97 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/coupon.hpp>
+#include <ql/time/daycounter.hpp>
+#include <ql/settings.hpp>
+
+namespace QuantLib {
+
+    CompiledLeg::CompiledLeg(const Leg& leg,
+                             bool includeSettlementDateFlows,
+                             Date settlementDate,
+                             Date npvDate) {
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        settlementDate_ = settlementDate;
+        npvDate_ = npvDate;
+
+        dates_.reserve(leg.size());
+        amounts_.reserve(leg.size());
+        refStartDates_.reserve(leg.size());
+        refEndDates_.reserve(leg.size());
+        accruals_.reserve(leg.size());
+
+        Date lastDate = npvDate;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg[i]->hasOccurred(settlementDate,
+                                    includeSettlementDateFlows))
+                continue;
+
+            Date couponDate = leg[i]->date();
+            bool exCoupon = leg[i]->tradingExCoupon(settlementDate);
+            Real amount = exCoupon ? 0.0 : leg[i]->amount();
+
+            Date refStartDate, refEndDate;
+            Real accrual = 0.0;
+            boost::shared_ptr<Coupon> coupon =
+                boost::dynamic_pointer_cast<Coupon>(leg[i]);
+            if (coupon) {
+                refStartDate = coupon->referencePeriodStart();
+                refEndDate = coupon->referencePeriodEnd();
+                if (!exCoupon)
+                    accrual = coupon->nominal() * coupon->accrualPeriod();
+            } else {
+                if (lastDate == npvDate) {
+                    // we don't have a previous coupon date,
+                    // so we fake it
+                    refStartDate = couponDate - 1*Years;
+                } else  {
+                    refStartDate = lastDate;
+                }
+                refEndDate = couponDate;
+            }
+
+            dates_.push_back(couponDate);
+            amounts_.push_back(amount);
+            refStartDates_.push_back(refStartDate);
+            refEndDates_.push_back(refEndDate);
+            accruals_.push_back(accrual);
+
+            lastDate = couponDate;
+        }
+    }
+
+    std::vector<Time>
+    CompiledLeg::yearFractions(const DayCounter& dc) const {
+        std::vector<Time> result(dates_.size());
+        Date lastDate = npvDate_;
+        for (Size i=0; i<dates_.size(); ++i) {
+            result[i] = dc.yearFraction(lastDate, dates_[i],
+                                        refStartDates_[i], refEndDates_[i]);
+            lastDate = dates_[i];
+        }
+        return result;
+    }
+
+}
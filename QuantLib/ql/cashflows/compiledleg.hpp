@@ -0,0 +1,90 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief Flat snapshot of a leg for repeated cash-flow analysis
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class DayCounter;
+
+    //! flat snapshot of the cash flows of a leg
+    /*! The cash flows that have not occurred at the settlement date
+        are read once and their dates, amounts and accrual data are
+        stored in contiguous arrays; the analytics in the CashFlows
+        class can then run against the snapshot without further
+        virtual calls, which is convenient when the same leg is
+        evaluated many times (e.g., within a yield or z-spread solver.)
+
+        Cash flows trading ex-coupon are kept with a null amount.
+
+        \warning the snapshot does not observe the original cash
+                 flows; it must be rebuilt when their amounts change,
+                 e.g., when the evaluation date or the forecast curves
+                 of floating coupons change.
+    */
+    class CompiledLeg {
+      public:
+        CompiledLeg(const Leg& leg,
+                    bool includeSettlementDateFlows,
+                    Date settlementDate = Date(),
+                    Date npvDate = Date());
+        //! \name Inspectors
+        //@{
+        Size size() const { return dates_.size(); }
+        bool empty() const { return dates_.empty(); }
+        const Date& settlementDate() const { return settlementDate_; }
+        const Date& npvDate() const { return npvDate_; }
+        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Real>& amounts() const { return amounts_; }
+        //! reference periods used when accruing a yield between payments
+        const std::vector<Date>& referencePeriodStarts() const {
+            return refStartDates_;
+        }
+        const std::vector<Date>& referencePeriodEnds() const {
+            return refEndDates_;
+        }
+        /*! nominal times accrual period for coupons, null for other
+            cash flows and for coupons trading ex-coupon.
+        */
+        const std::vector<Real>& accruals() const { return accruals_; }
+        //@}
+        //! \name Calculations
+        //@{
+        /*! year fractions between successive payments, the first
+            one being measured from the npv date.
+        */
+        std::vector<Time> yearFractions(const DayCounter& dc) const;
+        //@}
+      private:
+        Date settlementDate_, npvDate_;
+        std::vector<Date> dates_;
+        std::vector<Real> amounts_;
+        std::vector<Date> refStartDates_, refEndDates_;
+        std::vector<Real> accruals_;
+    };
+
+}
+
+#endif
@@ -115,4 +115,10 @@ namespace QuantLib {
     }
 #endif
 
+    Disposable<std::vector<CSRMatrix> >
+    FdmExtendedOrnsteinUhlenbackOp::toCSRMatrixDecomp() const {
+        std::vector<CSRMatrix> retVal(1, mapX_.toCSRMatrix());
+        return retVal;
+    }
+
 }
@@ -60,6 +60,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<std::vector<CSRMatrix> > toCSRMatrixDecomp() const;
       private:
         const boost::shared_ptr<FdmMesher> mesher_;
         const boost::shared_ptr<ExtendedOrnsteinUhlenbeckProcess> process_;
@@ -263,4 +263,12 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<CSRMatrix> FdmExtOUJumpOp::preconditionerMatrix() const {
+        // the jump integral couples all nodes along y; only its
+        // diagonal part -lambda is kept next to the diffusion part
+        CSRMatrix retVal = ouOp_->toCSRMatrix() + dyMap_.toCSRMatrix();
+        retVal.scaleAndShift(1.0, -process_->jumpIntensity());
+        return retVal;
+    }
 }
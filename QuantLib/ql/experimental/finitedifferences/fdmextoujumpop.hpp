@@ -66,6 +66,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<CSRMatrix> preconditionerMatrix() const;
       private:
         Disposable<Array> integro(const Array& r) const;
 
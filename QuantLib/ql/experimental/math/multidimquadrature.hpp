@@ -55,18 +55,19 @@ namespace QuantLib {
             detail::DispArray operator()(const F& f) const {
                 //first one, we do not know the size of the vector returned by f
                 Integer i = order()-1;
-                std::vector<Real> term = f(x_[i]);// potential copy! @#$%^!!!
+                std::vector<Real> term = f(x()[i]);// potential copy! @#$%^!!!
                 std::for_each(term.begin(), term.end(), 
-                    std::bind1st(std::multiplies<Real>(), w_[i]));
+                    std::bind1st(std::multiplies<Real>(), weights()[i]));
                 std::vector<Real> sum = term;
            
                 for (i--; i >= 0; --i) {
-                    term = f(x_[i]);// potential copy! @#$%^!!!
-                    // sum[j] += term[j] * w_[i];
+                    term = f(x()[i]);// potential copy! @#$%^!!!
+                    // sum[j] += term[j] * weights()[i];
                     std::transform(term.begin(), term.end(), sum.begin(), 
                         sum.begin(), 
                         boost::bind(std::plus<Real>(), _2,
-                            boost::bind(std::multiplies<Real>(), w_[i], _1)));
+                            boost::bind(std::multiplies<Real>(),
+                                        weights()[i], _1)));
                 }
                 return sum;
             }
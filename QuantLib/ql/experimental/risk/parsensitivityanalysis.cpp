@@ -0,0 +1,38 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/parsensitivityanalysis.hpp>
+
+namespace QuantLib {
+
+    std::vector<Real> parAnalysis(const Matrix& nodeSensitivities,
+                                  const std::vector<Real>& nodeDeltas) {
+        QL_REQUIRE(nodeSensitivities.rows() == nodeDeltas.size(),
+                   "dimension mismatch between node sensitivities ("
+                   << nodeSensitivities.rows() << " nodes) and node "
+                   "deltas (" << nodeDeltas.size() << ")");
+
+        std::vector<Real> result(nodeSensitivities.columns(), 0.0);
+        for (Size k=0; k<nodeDeltas.size(); ++k) {
+            const Real delta = nodeDeltas[k];
+            for (Size j=0; j<result.size(); ++j)
+                result[j] += delta*nodeSensitivities[k][j];
+        }
+        return result;
+    }
+
+}
@@ -0,0 +1,181 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parsensitivityanalysis.hpp
+    \brief par-rate sensitivities from bootstrapped curves
+*/
+
+#ifndef quantlib_par_sensitivity_analysis_hpp
+#define quantlib_par_sensitivity_analysis_hpp
+
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/handle.hpp>
+
+namespace QuantLib {
+
+    //! par-rate sensitivities from curve-node sensitivities
+    /*! returns the derivatives with respect to the quotes of the
+        alive helpers given the derivatives with respect to the curve
+        nodes, i.e.,
+        \f[
+            \frac{\partial V}{\partial q_j} =
+            \sum_k \frac{\partial V}{\partial x_k}
+                   \frac{\partial x_k}{\partial q_j}
+        \f]
+        where the node sensitivities
+        \f$ \partial x_k / \partial q_j \f$ are given as returned by
+        the nodeSensitivities() method of the piecewise curves.
+    */
+    std::vector<Real> parAnalysis(const Matrix& nodeSensitivities,
+                                  const std::vector<Real>& nodeDeltas);
+
+    //! curve-node sensitivity analysis of a bootstrapped yield curve
+    /*! returns the first derivatives of the aggregated NPV of the
+        instruments with respect to the curve nodes after the
+        reference date, i.e., to curve->data()[1], data()[2], ...
+
+        The nodes are shifted one by one on copies of the curve
+        which are linked in turn to the given handle; thus, the
+        helpers are not notified and the curve is not bootstrapped
+        again. The handle is linked back to the curve afterwards.
+
+        Empty quantities vector is considered as unit vector. The same
+        if the vector is of size one.
+
+        The shifted copies use the interpolator of the curve.
+
+        \warning the jumps of the curve, if any, are not applied to
+                 the shifted copies.
+    */
+    template <class Traits, class Interpolator,
+              template <class> class Bootstrap>
+    std::vector<Real> nodeAnalysis(
+        const boost::shared_ptr<PiecewiseYieldCurve<Traits, Interpolator,
+                                                    Bootstrap> >& curve,
+        RelinkableHandle<YieldTermStructure>& handle,
+        const std::vector<boost::shared_ptr<Instrument> >& instruments,
+        const std::vector<Real>& quantities,
+        Real shift = 0.0001,
+        SensitivityAnalysis type = Centered,
+        Real referenceNpv = Null<Real>());
+
+    //! par-rate sensitivity analysis of a bootstrapped yield curve
+    /*! returns the first derivatives of the aggregated NPV of the
+        instruments with respect to the quotes of the alive helpers
+        of the curve, sorted by maturity. The node sensitivities of
+        the portfolio are obtained by nodeAnalysis() and chained with
+        the node sensitivities of the curve; the helper quotes are
+        not shifted and therefore only one bootstrap is needed
+        instead of one per quote as with bucketAnalysis().
+    */
+    template <class Traits, class Interpolator,
+              template <class> class Bootstrap>
+    std::vector<Real> parAnalysis(
+        const boost::shared_ptr<PiecewiseYieldCurve<Traits, Interpolator,
+                                                    Bootstrap> >& curve,
+        RelinkableHandle<YieldTermStructure>& handle,
+        const std::vector<boost::shared_ptr<Instrument> >& instruments,
+        const std::vector<Real>& quantities,
+        Real shift = 0.0001,
+        SensitivityAnalysis type = Centered,
+        Real referenceNpv = Null<Real>());
+
+
+    // template definitions
+
+    template <class Traits, class Interpolator,
+              template <class> class Bootstrap>
+    std::vector<Real> nodeAnalysis(
+        const boost::shared_ptr<PiecewiseYieldCurve<Traits, Interpolator,
+                                                    Bootstrap> >& curve,
+        RelinkableHandle<YieldTermStructure>& handle,
+        const std::vector<boost::shared_ptr<Instrument> >& instruments,
+        const std::vector<Real>& quantities,
+        Real shift,
+        SensitivityAnalysis type,
+        Real referenceNpv) {
+
+        typedef typename Traits::template curve<Interpolator>::type
+                                                                ShiftedCurve;
+
+        QL_REQUIRE(shift!=0.0, "zero shift not allowed");
+        QL_REQUIRE(type==OneSide || type==Centered,
+                   "unknown SensitivityAnalysis (" << Integer(type) << ")");
+
+        const std::vector<Date>& dates = curve->dates();
+        const std::vector<Real> data = curve->data();
+        const Interpolator& interpolator = curve->interpolator();
+
+        std::vector<Real> result(data.size()-1, 0.0);
+        if (instruments.empty()) return result;
+
+        handle.linkTo(curve);
+        if (referenceNpv==Null<Real>() && type==OneSide)
+            referenceNpv = aggregateNPV(instruments, quantities);
+
+        try {
+            std::vector<Real> shifted(data);
+            for (Size k=1; k<data.size(); ++k) {
+                Traits::updateGuess(shifted, data[k]+shift, k);
+                handle.linkTo(boost::shared_ptr<YieldTermStructure>(
+                    new ShiftedCurve(dates, shifted, curve->dayCounter(),
+                                     curve->calendar(), interpolator)));
+                const Real npv = aggregateNPV(instruments, quantities);
+
+                if (type==OneSide) {
+                    result[k-1] = (npv-referenceNpv)/shift;
+                } else {
+                    Traits::updateGuess(shifted, data[k]-shift, k);
+                    handle.linkTo(boost::shared_ptr<YieldTermStructure>(
+                        new ShiftedCurve(dates, shifted, curve->dayCounter(),
+                                         curve->calendar(), interpolator)));
+                    const Real npv2 = aggregateNPV(instruments, quantities);
+                    result[k-1] = (npv-npv2)/(2.0*shift);
+                }
+                Traits::updateGuess(shifted, data[k], k);
+            }
+        } catch (...) {
+            handle.linkTo(curve);
+            throw;
+        }
+        handle.linkTo(curve);
+
+        return result;
+    }
+
+    template <class Traits, class Interpolator,
+              template <class> class Bootstrap>
+    std::vector<Real> parAnalysis(
+        const boost::shared_ptr<PiecewiseYieldCurve<Traits, Interpolator,
+                                                    Bootstrap> >& curve,
+        RelinkableHandle<YieldTermStructure>& handle,
+        const std::vector<boost::shared_ptr<Instrument> >& instruments,
+        const std::vector<Real>& quantities,
+        Real shift,
+        SensitivityAnalysis type,
+        Real referenceNpv) {
+
+        const std::vector<Real> nodeDeltas =
+            nodeAnalysis(curve, handle, instruments, quantities,
+                         shift, type, referenceNpv);
+        return parAnalysis(curve->nodeSensitivities(), nodeDeltas);
+    }
+
+}
+
+#endif
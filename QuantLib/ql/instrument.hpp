@@ -62,6 +62,9 @@ namespace QuantLib {
 
         //! returns whether the instrument might have value greater than zero.
         virtual bool isExpired() const = 0;
+
+        //! returns the pricing engine currently set, if any.
+        const boost::shared_ptr<PricingEngine>& pricingEngine() const;
         //@}
         //! \name Modifiers
         //@{
@@ -218,6 +221,11 @@ namespace QuantLib {
         return additionalResults_;
     }
 
+    inline const boost::shared_ptr<PricingEngine>&
+    Instrument::pricingEngine() const {
+        return engine_;
+    }
+
 }
 
 #endif
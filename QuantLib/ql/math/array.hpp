@@ -280,9 +280,14 @@ namespace QuantLib {
     }
 
     inline Array& Array::operator=(const Array& from) {
-        // strong guarantee
-        Array temp(from);
-        swap(temp);
+        if (n_ == from.n_) {
+            // reuse the existing storage; copying Reals cannot throw
+            std::copy(from.begin(), from.end(), begin());
+        } else {
+            // strong guarantee
+            Array temp(from);
+            swap(temp);
+        }
         return *this;
     }
 
@@ -25,36 +25,97 @@
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/math/matrixutilities/tqreigendecomposition.hpp>
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
+#include <ql/utilities/cachemutex.hpp>
+#include <map>
+#include <string>
+#include <typeinfo>
 
 namespace QuantLib {
 
+    namespace {
+
+        // rules are identified by the polynomial type and by the
+        // coefficients of its three-term recurrence, which determine
+        // nodes and weights completely
+        typedef std::pair<std::string, std::vector<Real> > RuleKey;
+        typedef std::pair<boost::shared_ptr<const Array>,
+                          boost::shared_ptr<const Array> > Rule;
+
+        const Size maxCachedRules = 1024;
+
+        std::map<RuleKey, Rule>& cachedRules() {
+            static std::map<RuleKey, Rule> rules;
+            return rules;
+        }
+
+        // guards the cache; defined at namespace scope, so that it
+        // is constructed before main() and before any thread can
+        // use it
+        detail::CacheMutex cachedRulesMutex;
+
+        bool findRule(const RuleKey& key, Rule& rule) {
+            detail::CacheMutex::scoped_lock lock(cachedRulesMutex);
+            const std::map<RuleKey, Rule>::const_iterator iter
+                = cachedRules().find(key);
+            if (iter == cachedRules().end())
+                return false;
+            rule = iter->second;
+            return true;
+        }
+
+        void storeRule(const RuleKey& key, const Rule& rule) {
+            detail::CacheMutex::scoped_lock lock(cachedRulesMutex);
+            std::map<RuleKey, Rule>& rules = cachedRules();
+            if (rules.size() >= maxCachedRules)
+                rules.clear();
+            rules[key] = rule;
+        }
+
+    }
+
     GaussianQuadrature::GaussianQuadrature(
                                 Size n,
-                                const GaussianOrthogonalPolynomial& orthPoly)
-    : x_(n), w_(n) {
+                                const GaussianOrthogonalPolynomial& orthPoly) {
 
         // set-up matrix to compute the roots and the weights
-        Array e(n-1);
+        Array d(n), e(n-1);
 
         Size i;
         for (i=1; i < n; ++i) {
-            x_[i] = orthPoly.alpha(i);
+            d[i] = orthPoly.alpha(i);
             e[i-1] = std::sqrt(orthPoly.beta(i));
         }
-        x_[0] = orthPoly.alpha(0);
+        d[0] = orthPoly.alpha(0);
+
+        const Real mu_0 = orthPoly.mu_0();
 
-        TqrEigenDecomposition tqr(
-                               x_, e,
+        RuleKey key(typeid(orthPoly).name(), std::vector<Real>());
+        key.second.reserve(2*n+1);
+        key.second.push_back(mu_0);
+        key.second.insert(key.second.end(), d.begin(), d.end());
+        key.second.insert(key.second.end(), e.begin(), e.end());
+
+        Rule rule;
+        if (!findRule(key, rule)) {
+            TqrEigenDecomposition tqr(
+                               d, e,
                                TqrEigenDecomposition::OnlyFirstRowEigenVector,
                                TqrEigenDecomposition::Overrelaxation);
 
-        x_ = tqr.eigenvalues();
-        const Matrix& ev = tqr.eigenvectors();
+            boost::shared_ptr<Array> x(new Array(tqr.eigenvalues()));
+            boost::shared_ptr<Array> w(new Array(n));
+            const Matrix& ev = tqr.eigenvectors();
+
+            for (i=0; i<n; ++i) {
+                (*w)[i] = mu_0*ev[0][i]*ev[0][i] / orthPoly.w((*x)[i]);
+            }
 
-        Real mu_0 = orthPoly.mu_0();
-        for (i=0; i<n; ++i) {
-            w_[i] = mu_0*ev[0][i]*ev[0][i] / orthPoly.w(x_[i]);
+            rule = Rule(x, w);
+            storeRule(key, rule);
         }
+
+        x_ = rule.first;
+        w_ = rule.second;
     }
 
 
@@ -27,6 +27,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/math/integrals/gaussianorthogonalpolynomial.hpp>
+#include <boost/shared_ptr.hpp>
 
 namespace QuantLib {
     class GaussianOrthogonalPolynomial;
@@ -41,6 +42,11 @@ namespace QuantLib {
         "Numerical Recipes in C", 2nd edition,
         Press, Teukolsky, Vetterling, Flannery,
 
+        Nodes and weights are cached process-wide, keyed on the
+        polynomial type and its recurrence coefficients; instances
+        built for the same rule share their storage, so that
+        constructing it again only costs a lookup.
+
         \test the correctness of the result is tested by checking it
               against known good values.
     */
@@ -52,18 +58,20 @@ namespace QuantLib {
         template <class F>
         Real operator()(const F& f) const {
             Real sum = 0.0;
+            const Array& w = *w_;
+            const Array& x = *x_;
             for (Integer i = order()-1; i >= 0; --i) {
-                sum += w_[i] * f(x_[i]);
+                sum += w[i] * f(x[i]);
             }
             return sum;
         }
 
-        Size order() const { return x_.size(); }
-        const Array& weights() { return w_; }
-        const Array& x()       { return x_; }
+        Size order() const { return x_->size(); }
+        const Array& weights() const { return *w_; }
+        const Array& x()       const { return *x_; }
         
       protected:
-        Array x_, w_;
+        boost::shared_ptr<const Array> x_, w_;
     };
 
 
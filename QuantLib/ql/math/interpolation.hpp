@@ -28,6 +28,7 @@
 
 #include <ql/math/interpolations/extrapolation.hpp>
 #include <ql/math/comparison.hpp>
+#include <ql/math/array.hpp>
 #include <ql/errors.hpp>
 #include <vector>
 
@@ -52,6 +53,11 @@ namespace QuantLib {
             virtual std::vector<Real> yValues() const = 0;
             virtual bool isInRange(Real) const = 0;
             virtual Real value(Real) const = 0;
+            /*! as above; hint is the index of the interval where the
+                previous point was found, and is updated.  The default
+                implementation ignores it.
+            */
+            virtual Real value(Real x, Size&) const { return value(x); }
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
@@ -105,6 +111,23 @@ namespace QuantLib {
                 else
                     return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
             }
+            /*! as above, but the interval given by the hint and the
+                next one are tried before falling back to a binary
+                search; the hint is then set to the interval found.
+                The hint is checked before being used, so that its
+                value never affects the result.
+            */
+            Size locate(Real x, Size& hint) const {
+                const Size n = xEnd_-xBegin_;
+                const Size i = hint;
+                if (i+1 < n && xBegin_[i] <= x) {
+                    if (i+2 == n || x < xBegin_[i+1])
+                        return i;
+                    if (i+3 == n || x < xBegin_[i+2])
+                        return hint = i+1;
+                }
+                return hint = locate(x);
+            }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
         };
@@ -116,6 +139,33 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! returns the interpolated value at x; hint is the index
+            of the interval where the previous point was found and is
+            updated by the call.  It is owned by the caller (start from
+            0) so that points in the same or in adjacent intervals are
+            located in constant time without the interpolation having
+            any mutable state.
+        */
+        Real operator()(Real x, Size& hint,
+                        bool allowExtrapolation = false) const {
+            checkRange(x,allowExtrapolation);
+            return impl_->value(x, hint);
+        }
+        /*! returns the interpolated values at the given points.
+            Consecutive points in the same or in adjacent intervals are
+            located in constant time; thus, evaluation on a sorted grid
+            costs O(1) per point instead of O(log n).
+        */
+        Disposable<Array> operator()(const Array& x,
+                                     bool allowExtrapolation = false) const {
+            Array y(x.size());
+            Size hint = 0;
+            for (Size i=0; i<x.size(); ++i) {
+                checkRange(x[i],allowExtrapolation);
+                y[i] = impl_->value(x[i], hint);
+            }
+            return y;
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
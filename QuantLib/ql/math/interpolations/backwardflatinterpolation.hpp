@@ -89,6 +89,15 @@ namespace QuantLib {
                 else
                     return this->yBegin_[i+1];
             }
+            Real value(Real x, Size& hint) const {
+                if (x <= this->xBegin_[0])
+                    return this->yBegin_[0];
+                Size i = this->locate(x, hint);
+                if (x == this->xBegin_[i])
+                    return this->yBegin_[i];
+                else
+                    return this->yBegin_[i+1];
+            }
             Real primitive(Real x) const {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
@@ -86,6 +86,13 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i];
             }
+            Real value(Real x, Size& hint) const {
+                if (x >= this->xBegin_[n_-1])
+                    return this->yBegin_[n_-1];
+
+                Size i = this->locate(x, hint);
+                return this->yBegin_[i];
+            }
             Real primitive(Real x) const {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
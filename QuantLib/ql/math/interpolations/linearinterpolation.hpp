@@ -86,6 +86,10 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i] + (x-this->xBegin_[i])*s_[i];
             }
+            Real value(Real x, Size& hint) const {
+                Size i = this->locate(x, hint);
+                return this->yBegin_[i] + (x-this->xBegin_[i])*s_[i];
+            }
             Real primitive(Real x) const {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
@@ -227,6 +227,9 @@ namespace QuantLib {
             Real value(Real x) const {
                 return std::exp(interpolation_(x, true));
             }
+            Real value(Real x, Size& hint) const {
+                return std::exp(interpolation_(x, hint, true));
+            }
             Real primitive(Real) const {
                 QL_FAIL("LogInterpolation primitive not implemented");
             }
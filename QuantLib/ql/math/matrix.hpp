@@ -209,9 +209,14 @@ namespace QuantLib {
     }
 
     inline Matrix& Matrix::operator=(const Matrix& from) {
-        // strong guarantee
-        Matrix temp(from);
-        swap(temp);
+        if (rows_ == from.rows_ && columns_ == from.columns_) {
+            // reuse the existing storage; copying Reals cannot throw
+            std::copy(from.begin(), from.end(), begin());
+        } else {
+            // strong guarantee
+            Matrix temp(from);
+            swap(temp);
+        }
         return *this;
     }
 
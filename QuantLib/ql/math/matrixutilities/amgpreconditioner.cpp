@@ -0,0 +1,324 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/amgpreconditioner.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+
+        const Size noAggregate = Size(-1);
+
+        Disposable<std::vector<Size> > diagonalPositions(const CSRMatrix& A) {
+            std::vector<Size> retVal(A.rows());
+            for (Size i=0; i < A.rows(); ++i) {
+                const std::vector<Size>::const_iterator begin
+                    = A.columnIndex().begin() + A.rowStart()[i];
+                const std::vector<Size>::const_iterator end
+                    = A.columnIndex().begin() + A.rowStart()[i+1];
+                const std::vector<Size>::const_iterator iter
+                    = std::lower_bound(begin, end, i);
+                QL_REQUIRE(iter != end && *iter == i
+                           && A.values()[iter-A.columnIndex().begin()] != 0.0,
+                           "zero diagonal element in row " << i);
+                retVal[i] = iter - A.columnIndex().begin();
+            }
+            return retVal;
+        }
+
+        /* the Gauss-Seidel update divides by the diagonal element or
+           by the sum of the off-diagonal elements if the row is not
+           diagonally dominant. This keeps the smoother stable for
+           the boundary rows of e.g. mixed-derivative operators. */
+        Disposable<std::vector<Real> > smootherDivisors(
+                              const CSRMatrix& A, const std::vector<Size>& diag) {
+            std::vector<Real> retVal(A.rows());
+            for (Size i=0; i < A.rows(); ++i) {
+                const Real aii = A.values()[diag[i]];
+                Real offDiagonal = 0.0;
+                for (Size k=A.rowStart()[i]; k < A.rowStart()[i+1]; ++k)
+                    if (k != diag[i])
+                        offDiagonal += std::fabs(A.values()[k]);
+
+                const Real d = std::max(std::fabs(aii), offDiagonal);
+                retVal[i] = (aii > 0.0) ? d : -d;
+            }
+            return retVal;
+        }
+
+        // greedy aggregation of strongly connected unknowns
+        Size aggregate(const CSRMatrix& A, const std::vector<Size>& diag,
+                       Real theta, std::vector<Size>& agg) {
+            const Size n = A.rows();
+            const std::vector<Size>& rowStart = A.rowStart();
+            const std::vector<Size>& column = A.columnIndex();
+            const std::vector<Real>& value = A.values();
+
+            std::vector<bool> strong(A.nonZeros(), false);
+            for (Size i=0; i < n; ++i) {
+                const Real aii = value[diag[i]];
+                for (Size k=rowStart[i]; k < rowStart[i+1]; ++k) {
+                    const Size j = column[k];
+                    strong[k] = j != i && std::fabs(value[k])
+                        >= theta*std::sqrt(std::fabs(aii*value[diag[j]]));
+                }
+            }
+
+            agg.assign(n, noAggregate);
+            Size nAggregates = 0;
+
+            // 1. unknowns whose strong neighbours are all free
+            //    form a new aggregate together with them
+            for (Size i=0; i < n; ++i) {
+                if (agg[i] != noAggregate)
+                    continue;
+                bool free = true, connected = false;
+                for (Size k=rowStart[i]; k < rowStart[i+1] && free; ++k) {
+                    if (strong[k]) {
+                        connected = true;
+                        free = (agg[column[k]] == noAggregate);
+                    }
+                }
+                if (free && connected) {
+                    agg[i] = nAggregates;
+                    for (Size k=rowStart[i]; k < rowStart[i+1]; ++k)
+                        if (strong[k])
+                            agg[column[k]] = nAggregates;
+                    ++nAggregates;
+                }
+            }
+
+            // 2. the remaining unknowns join the aggregate of one of
+            //    their strong neighbours found in the first pass
+            const std::vector<Size> firstPass(agg);
+            for (Size i=0; i < n; ++i) {
+                if (agg[i] != noAggregate)
+                    continue;
+                for (Size k=rowStart[i]; k < rowStart[i+1]; ++k) {
+                    if (strong[k] && firstPass[column[k]] != noAggregate) {
+                        agg[i] = firstPass[column[k]];
+                        break;
+                    }
+                }
+            }
+
+            // 3. isolated unknowns become aggregates of their own
+            for (Size i=0; i < n; ++i) {
+                if (agg[i] == noAggregate)
+                    agg[i] = nAggregates++;
+            }
+
+            return nAggregates;
+        }
+
+        // Galerkin product P^T A P for piecewise-constant prolongation
+        Disposable<CSRMatrix> coarseOperator(const CSRMatrix& A,
+                                             const std::vector<Size>& agg,
+                                             Size nCoarse) {
+            const Size n = A.rows();
+
+            std::vector<std::vector<Size> > members(nCoarse);
+            for (Size i=0; i < n; ++i)
+                members[agg[i]].push_back(i);
+
+            std::vector<Size> rowStart(nCoarse+1, 0), columnIndex;
+            std::vector<Real> values;
+            std::vector<Size> position(nCoarse, noAggregate);
+            std::vector<std::pair<Size, Real> > row;
+
+            for (Size I=0; I < nCoarse; ++I) {
+                row.clear();
+                for (Size m=0; m < members[I].size(); ++m) {
+                    const Size i = members[I][m];
+                    for (Size k=A.rowStart()[i]; k < A.rowStart()[i+1]; ++k) {
+                        const Size J = agg[A.columnIndex()[k]];
+                        if (position[J] == noAggregate) {
+                            position[J] = row.size();
+                            row.push_back(std::make_pair(J, 0.0));
+                        }
+                        row[position[J]].second += A.values()[k];
+                    }
+                }
+                for (Size k=0; k < row.size(); ++k)
+                    position[row[k].first] = noAggregate;
+
+                std::sort(row.begin(), row.end());
+                for (Size k=0; k < row.size(); ++k) {
+                    columnIndex.push_back(row[k].first);
+                    values.push_back(row[k].second);
+                }
+                rowStart[I+1] = values.size();
+            }
+
+            CSRMatrix retVal(nCoarse, nCoarse, rowStart, columnIndex, values);
+            return retVal;
+        }
+    }
+
+    AMGPreconditioner::AMGPreconditioner(const CSRMatrix& A,
+                                         Size maxLevels,
+                                         Size coarsestSize,
+                                         Real strengthThreshold) {
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "AMG preconditioner works only with square matrices");
+        QL_REQUIRE(maxLevels > 0, "at least one level is required");
+
+        CSRMatrix current = A;
+        for (;;) {
+            Level level;
+            level.A.swap(current);
+            level.diagonal = diagonalPositions(level.A);
+            level.divisor = smootherDivisors(level.A, level.diagonal);
+            level.coarseSize = 0;
+
+            const Size n = level.A.rows();
+            if (levels_.size()+1 < maxLevels && n > coarsestSize) {
+                const Size nCoarse = aggregate(level.A, level.diagonal,
+                                               strengthThreshold,
+                                               level.aggregate);
+                // stop if the aggregation does not reduce the size
+                if (nCoarse < n && nCoarse > 0) {
+                    level.coarseSize = nCoarse;
+                    current = coarseOperator(level.A, level.aggregate,
+                                             nCoarse);
+                } else {
+                    level.aggregate.clear();
+                }
+            }
+
+            levels_.push_back(level);
+            if (level.coarseSize == 0)
+                break;
+        }
+
+        // LU decomposition with partial pivoting of the coarsest level
+        const CSRMatrix& coarsest = levels_.back().A;
+        const Size n = coarsest.rows();
+        if (n <= coarsestSize) {
+            lu_ = Matrix(n, n, 0.0);
+            for (Size i=0; i < n; ++i)
+                for (Size k=coarsest.rowStart()[i];
+                     k < coarsest.rowStart()[i+1]; ++k)
+                    lu_[i][coarsest.columnIndex()[k]] = coarsest.values()[k];
+
+            pivots_.resize(n);
+            for (Size j=0; j < n; ++j) {
+                Size p = j;
+                for (Size i=j+1; i < n; ++i)
+                    if (std::fabs(lu_[i][j]) > std::fabs(lu_[p][j]))
+                        p = i;
+                QL_REQUIRE(lu_[p][j] != 0.0,
+                           "singular matrix on the coarsest level");
+                pivots_[j] = p;
+                if (p != j)
+                    std::swap_ranges(lu_.row_begin(j), lu_.row_end(j),
+                                     lu_.row_begin(p));
+
+                for (Size i=j+1; i < n; ++i) {
+                    const Real l = (lu_[i][j] /= lu_[j][j]);
+                    for (Size k=j+1; k < n; ++k)
+                        lu_[i][k] -= l*lu_[j][k];
+                }
+            }
+        }
+    }
+
+    Size AMGPreconditioner::levels() const {
+        return levels_.size();
+    }
+
+    Size AMGPreconditioner::size(Size level) const {
+        QL_REQUIRE(level < levels_.size(), "level " << level
+                   << " out of range [0, " << levels_.size() << ")");
+        return levels_[level].A.rows();
+    }
+
+    Disposable<Array> AMGPreconditioner::apply(const Array& b) const {
+        QL_REQUIRE(b.size() == levels_.front().A.rows(),
+                   "inconsistent size of rhs");
+        Array x(b.size());
+        vCycle(0, b, x);
+
+        return x;
+    }
+
+    void AMGPreconditioner::vCycle(Size l, const Array& b, Array& x) const {
+        std::fill(x.begin(), x.end(), 0.0);
+
+        const Level& level = levels_[l];
+        if (l+1 == levels_.size()) {
+            coarsestSolve(b, x);
+            return;
+        }
+
+        smooth(level, b, x, true);
+
+        Array r;
+        level.A.apply_into(x, r);
+        Array rc(level.coarseSize, 0.0);
+        for (Size i=0; i < r.size(); ++i)
+            rc[level.aggregate[i]] += b[i] - r[i];
+
+        Array ec(level.coarseSize);
+        vCycle(l+1, rc, ec);
+        for (Size i=0; i < x.size(); ++i)
+            x[i] += ec[level.aggregate[i]];
+
+        smooth(level, b, x, false);
+    }
+
+    void AMGPreconditioner::smooth(const Level& level, const Array& b,
+                                   Array& x, bool forward) const {
+        const Size n = level.A.rows();
+        const std::vector<Size>& rowStart = level.A.rowStart();
+        const std::vector<Size>& column = level.A.columnIndex();
+        const std::vector<Real>& value = level.A.values();
+
+        for (Size m=0; m < n; ++m) {
+            const Size i = forward ? m : n-1-m;
+            Real t = b[i];
+            for (Size k=rowStart[i]; k < rowStart[i+1]; ++k)
+                t -= value[k]*x[column[k]];
+            x[i] += t/level.divisor[i];
+        }
+    }
+
+    void AMGPreconditioner::coarsestSolve(const Array& b, Array& x) const {
+        const Size n = x.size();
+        if (pivots_.size() != n) {
+            // too large for a direct solver: symmetric Gauss-Seidel
+            for (Size k=0; k < 4; ++k) {
+                smooth(levels_.back(), b, x, true);
+                smooth(levels_.back(), b, x, false);
+            }
+            return;
+        }
+
+        std::copy(b.begin(), b.end(), x.begin());
+        for (Size j=0; j < n; ++j)
+            std::swap(x[j], x[pivots_[j]]);
+        for (Size i=1; i < n; ++i)
+            for (Size j=0; j < i; ++j)
+                x[i] -= lu_[i][j]*x[j];
+        for (Size i=n; i-- > 0;) {
+            for (Size j=i+1; j < n; ++j)
+                x[i] -= lu_[i][j]*x[j];
+            x[i] /= lu_[i][i];
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file amgpreconditioner.hpp
+    \brief algebraic multigrid preconditioner
+*/
+
+#ifndef quantlib_amg_preconditioner_hpp
+#define quantlib_amg_preconditioner_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! algebraic multigrid preconditioner
+    /*! Each call to apply() performs one V-cycle of an aggregation-based
+        algebraic multigrid method for \f$ A x = b \f$ starting from
+        \f$ x = 0 \f$, i.e. it returns an approximation of
+        \f$ A^{-1} b \f$ suitable as a preconditioner for BiCGstab
+        or GMRES.
+
+        The coarse levels are obtained by greedy aggregation of
+        strongly connected unknowns, where \f$ j \f$ is strongly
+        connected to \f$ i \f$ if
+        \f$ |a_{ij}| \geq \theta \sqrt{|a_{ii} a_{jj}|} \f$, with
+        piecewise-constant prolongation and Galerkin coarse
+        operators. Gauss-Seidel sweeps are used as pre- and
+        post-smoother, where rows which are not diagonally dominant
+        are scaled by the sum of their off-diagonal elements, and the
+        coarsest level is solved by a dense LU decomposition.
+
+        The hierarchy only depends on the matrix given in the
+        constructor, therefore it can be built once and reused as
+        preconditioner for nearby matrices, e.g. for the time steps
+        of a finite-difference scheme.
+
+        The aggregation procedure follows
+        Vanek, P., Mandel, J. and Brezina, M., 1996, Algebraic
+        multigrid by smoothed aggregation for second and fourth
+        order elliptic problems, Computing 56, pp. 179-196
+    */
+    class AMGPreconditioner {
+      public:
+        AMGPreconditioner(const CSRMatrix& A,
+                          Size maxLevels = 10,
+                          Size coarsestSize = 200,
+                          Real strengthThreshold = 0.08);
+
+        Disposable<Array> apply(const Array& b) const;
+
+        //! number of levels including the finest and the coarsest one
+        Size levels() const;
+        //! size of the matrix on the given level
+        Size size(Size level) const;
+
+      private:
+        struct Level {
+            CSRMatrix A;
+            std::vector<Size> diagonal;
+            std::vector<Real> divisor;
+            std::vector<Size> aggregate;
+            Size coarseSize;
+        };
+
+        void vCycle(Size level, const Array& b, Array& x) const;
+        void smooth(const Level& level, const Array& b, Array& x,
+                    bool forward) const;
+        void coarsestSolve(const Array& b, Array& x) const;
+
+        std::vector<Level> levels_;
+        Matrix lu_;
+        std::vector<Size> pivots_;
+    };
+
+}
+
+#endif
@@ -49,7 +49,7 @@ namespace QuantLib {
         Real omega = 1.0;
         Real rho, rhoTld=1.0;
         Real alpha=0.0, beta;
-        Real error=Null<Real>();
+        Real error=norm2(r)/bnorm2;
 
         Size i;
         for (i=0; i < maxIter_ && error >= relTol_; ++i) {
@@ -0,0 +1,260 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    namespace {
+        // rows are processed serially below this size
+        const Size minParallelSize = 4096;
+    }
+
+    CSRMatrix::CSRMatrix()
+    : rows_(0), columns_(0), rowStart_(1, 0) {}
+
+    CSRMatrix::CSRMatrix(Size rows, Size columns)
+    : rows_(rows), columns_(columns), rowStart_(rows+1, 0) {}
+
+    CSRMatrix::CSRMatrix(Size rows, Size columns,
+                         const std::vector<Size>& rowStart,
+                         const std::vector<Size>& columnIndex,
+                         const std::vector<Real>& values)
+    : rows_(rows), columns_(columns), rowStart_(rowStart),
+      columnIndex_(columnIndex), values_(values) {
+        QL_REQUIRE(rowStart_.size() == rows_+1,
+                   "row-start vector has size " << rowStart_.size()
+                   << ", " << rows_+1 << " required");
+        QL_REQUIRE(rowStart_.front() == 0
+                   && rowStart_.back() == values_.size()
+                   && columnIndex_.size() == values_.size(),
+                   "inconsistent CSR vectors");
+        for (Size i=0; i < rows_; ++i) {
+            QL_REQUIRE(rowStart_[i] <= rowStart_[i+1],
+                       "row-start vector is not sorted");
+            for (Size j=rowStart_[i]; j < rowStart_[i+1]; ++j) {
+                QL_REQUIRE(columnIndex_[j] < columns_,
+                           "column index " << columnIndex_[j]
+                           << " out of range in row " << i);
+                QL_REQUIRE(j == rowStart_[i]
+                           || columnIndex_[j-1] < columnIndex_[j],
+                           "column indices of row " << i
+                           << " are not strictly increasing");
+            }
+        }
+    }
+
+    CSRMatrix::CSRMatrix(Size rows, Size columns, Size entriesPerRow,
+                         const std::vector<Size>& columnIndex,
+                         const std::vector<Real>& values)
+    : rows_(rows), columns_(columns), rowStart_(rows+1, 0) {
+        QL_REQUIRE(columnIndex.size() == rows*entriesPerRow
+                   && values.size() == rows*entriesPerRow,
+                   "inconsistent number of entries");
+
+        columnIndex_.reserve(rows*entriesPerRow);
+        values_.reserve(rows*entriesPerRow);
+
+        std::vector<std::pair<Size, Real> > row(entriesPerRow);
+        for (Size i=0; i < rows; ++i) {
+            for (Size k=0; k < entriesPerRow; ++k) {
+                const Size j = columnIndex[i*entriesPerRow+k];
+                QL_REQUIRE(j < columns, "column index " << j
+                           << " out of range in row " << i);
+                row[k] = std::make_pair(j, values[i*entriesPerRow+k]);
+            }
+            std::sort(row.begin(), row.end());
+
+            for (Size k=0; k < entriesPerRow; ++k) {
+                if (k > 0 && row[k].first == row[k-1].first) {
+                    values_.back() += row[k].second;
+                } else {
+                    columnIndex_.push_back(row[k].first);
+                    values_.push_back(row[k].second);
+                }
+            }
+            rowStart_[i+1] = values_.size();
+        }
+    }
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    CSRMatrix::CSRMatrix(const SparseMatrix& m)
+    : rows_(m.size1()), columns_(m.size2()), rowStart_(m.size1()+1, 0) {
+        columnIndex_.reserve(m.nnz());
+        values_.reserve(m.nnz());
+
+        for (SparseMatrix::const_iterator1 i1 = m.begin1();
+             i1 != m.end1(); ++i1) {
+            for (SparseMatrix::const_iterator2 i2 = i1.begin();
+                 i2 != i1.end(); ++i2) {
+                columnIndex_.push_back(i2.index2());
+                values_.push_back(*i2);
+            }
+            rowStart_[i1.index1()+1] = values_.size();
+        }
+        // fill the row starts of rows without stored elements
+        for (Size i=1; i <= rows_; ++i)
+            rowStart_[i] = std::max(rowStart_[i], rowStart_[i-1]);
+    }
+
+    Disposable<SparseMatrix> CSRMatrix::toSparseMatrix() const {
+        SparseMatrix retVal(rows_, columns_, values_.size());
+        for (Size i=0; i < rows_; ++i)
+            for (Size j=rowStart_[i]; j < rowStart_[i+1]; ++j)
+                retVal(i, columnIndex_[j]) = values_[j];
+
+        return retVal;
+    }
+#endif
+
+    CSRMatrix::CSRMatrix(const Disposable<CSRMatrix>& from)
+    : rows_(0), columns_(0) {
+        swap(const_cast<Disposable<CSRMatrix>&>(from));
+    }
+
+    CSRMatrix& CSRMatrix::operator=(const Disposable<CSRMatrix>& from) {
+        swap(const_cast<Disposable<CSRMatrix>&>(from));
+        return *this;
+    }
+
+    void CSRMatrix::swap(CSRMatrix& from) {
+        std::swap(rows_, from.rows_);
+        std::swap(columns_, from.columns_);
+        rowStart_.swap(from.rowStart_);
+        columnIndex_.swap(from.columnIndex_);
+        values_.swap(from.values_);
+    }
+
+    Real CSRMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "element (" << i << ", " << j << ") out of range");
+
+        const std::vector<Size>::const_iterator begin =
+            columnIndex_.begin() + rowStart_[i];
+        const std::vector<Size>::const_iterator end =
+            columnIndex_.begin() + rowStart_[i+1];
+        const std::vector<Size>::const_iterator iter =
+            std::lower_bound(begin, end, j);
+
+        return (iter != end && *iter == j)
+            ? values_[iter - columnIndex_.begin()] : 0.0;
+    }
+
+    Disposable<Array> CSRMatrix::diagonal() const {
+        Array retVal(std::min(rows_, columns_));
+        for (Size i=0; i < retVal.size(); ++i)
+            retVal[i] = (*this)(i, i);
+
+        return retVal;
+    }
+
+    Disposable<Array> CSRMatrix::apply(const Array& x) const {
+        Array retVal(rows_);
+        apply_into(x, retVal);
+
+        return retVal;
+    }
+
+    void CSRMatrix::apply_into(const Array& x, Array& y) const {
+        QL_REQUIRE(x.size() == columns_,
+                   "vector of size " << x.size() << " cannot be "
+                   "multiplied with a " << rows_ << "x" << columns_
+                   << " matrix");
+        QL_REQUIRE(&x != &y, "x and y must not be the same array");
+
+        if (y.size() != rows_)
+            Array(rows_).swap(y);
+
+        const Size* rptr = rowStart_.empty() ? 0 : &rowStart_[0];
+        const Size* cptr = columnIndex_.empty() ? 0 : &columnIndex_[0];
+        const Real* vptr = values_.empty() ? 0 : &values_[0];
+        const Real* xptr = x.begin();
+        Real* yptr = y.begin();
+
+        // static scheduling hands out contiguous blocks of rows
+        const long n = long(rows_);
+        #pragma omp parallel for default(shared) schedule(static) \
+                                 if(rows_ >= minParallelSize)
+        for (long i=0; i < n; ++i) {
+            Real t = 0.0;
+            for (Size j=rptr[i]; j < rptr[i+1]; ++j)
+                t += vptr[j]*xptr[cptr[j]];
+            yptr[i] = t;
+        }
+    }
+
+    void CSRMatrix::scaleAndShift(Real a, Real b) {
+        for (Size i=0; i < rows_; ++i) {
+            bool diagonalFound = false;
+            for (Size j=rowStart_[i]; j < rowStart_[i+1]; ++j) {
+                values_[j] *= a;
+                if (columnIndex_[j] == i) {
+                    values_[j] += b;
+                    diagonalFound = true;
+                }
+            }
+            QL_REQUIRE(diagonalFound || b == 0.0 || i >= columns_,
+                       "diagonal element of row " << i << " is not stored");
+        }
+    }
+
+    Disposable<CSRMatrix> operator+(const CSRMatrix& a, const CSRMatrix& b) {
+        QL_REQUIRE(a.rows() == b.rows() && a.columns() == b.columns(),
+                   "matrices with different sizes ("
+                   << a.rows() << "x" << a.columns() << ", "
+                   << b.rows() << "x" << b.columns() << ") cannot be added");
+
+        const std::vector<Size>& ra = a.rowStart();
+        const std::vector<Size>& rb = b.rowStart();
+        const std::vector<Size>& ca = a.columnIndex();
+        const std::vector<Size>& cb = b.columnIndex();
+        const std::vector<Real>& va = a.values();
+        const std::vector<Real>& vb = b.values();
+
+        std::vector<Size> rowStart(a.rows()+1, 0), columnIndex;
+        std::vector<Real> values;
+        columnIndex.reserve(a.nonZeros() + b.nonZeros());
+        values.reserve(a.nonZeros() + b.nonZeros());
+
+        for (Size i=0; i < a.rows(); ++i) {
+            Size j = ra[i], k = rb[i];
+            while (j < ra[i+1] || k < rb[i+1]) {
+                if (k == rb[i+1] || (j < ra[i+1] && ca[j] < cb[k])) {
+                    columnIndex.push_back(ca[j]);
+                    values.push_back(va[j++]);
+                } else if (j == ra[i+1] || cb[k] < ca[j]) {
+                    columnIndex.push_back(cb[k]);
+                    values.push_back(vb[k++]);
+                } else {
+                    columnIndex.push_back(ca[j]);
+                    values.push_back(va[j++] + vb[k++]);
+                }
+            }
+            rowStart[i+1] = values.size();
+        }
+
+        CSRMatrix retVal(a.rows(), a.columns(),
+                         rowStart, columnIndex, values);
+        return retVal;
+    }
+
+    Disposable<Array> prod(const CSRMatrix& A, const Array& x) {
+        return A.apply(x);
+    }
+
+}
@@ -0,0 +1,118 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief sparse matrix in compressed sparse row format
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! sparse matrix in compressed sparse row (CSR) format
+    /*! The non-zero entries of row \f$ i \f$ are stored in the
+        positions \f$ [r_i, r_{i+1}) \f$ of the column-index and value
+        vectors, where \f$ r \f$ is the row-start vector; within a row
+        the column indices are strictly increasing.
+
+        Unlike the ublas-based SparseMatrix the storage is exposed
+        directly, which allows fast matrix-vector products and a
+        cheap conversion from the finite-difference operators.
+        Structural zeros are kept, so that the sparsity pattern of an
+        operator does not depend on its current coefficients.
+    */
+    class CSRMatrix {
+      public:
+        //! \name Constructors
+        //@{
+        CSRMatrix();
+        //! creates a zero matrix
+        CSRMatrix(Size rows, Size columns);
+        //! takes the three CSR vectors as they are
+        CSRMatrix(Size rows, Size columns,
+                  const std::vector<Size>& rowStart,
+                  const std::vector<Size>& columnIndex,
+                  const std::vector<Real>& values);
+        /*! builds the matrix from a fixed number of entries per row.
+            The entries of row \f$ i \f$ are at positions
+            \f$ [i k, (i+1) k) \f$ of the given vectors, with
+            \f$ k \f$ = \p entriesPerRow; duplicated columns are summed.
+        */
+        CSRMatrix(Size rows, Size columns, Size entriesPerRow,
+                  const std::vector<Size>& columnIndex,
+                  const std::vector<Real>& values);
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        explicit CSRMatrix(const SparseMatrix& m);
+#endif
+        CSRMatrix(const Disposable<CSRMatrix>&);
+        CSRMatrix& operator=(const Disposable<CSRMatrix>&);
+        //@}
+
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rows_; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+
+        const std::vector<Size>& rowStart() const { return rowStart_; }
+        const std::vector<Size>& columnIndex() const { return columnIndex_; }
+        const std::vector<Real>& values() const { return values_; }
+
+        //! element access; zero if the element is not stored
+        Real operator()(Size i, Size j) const;
+        Disposable<Array> diagonal() const;
+        //@}
+
+        //! \name Linear algebra
+        //@{
+        Disposable<Array> apply(const Array& x) const;
+        /*! in-place variant of apply; \p y must not alias \p x.
+            Rows are distributed over the available OpenMP threads.
+        */
+        void apply_into(const Array& x, Array& y) const;
+        /*! replaces the matrix \f$ A \f$ by \f$ a A + b I \f$;
+            the diagonal must be stored if \p b is not zero.
+        */
+        void scaleAndShift(Real a, Real b);
+        //@}
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+        Disposable<SparseMatrix> toSparseMatrix() const;
+#endif
+
+        void swap(CSRMatrix&);
+
+      private:
+        Size rows_, columns_;
+        std::vector<Size> rowStart_, columnIndex_;
+        std::vector<Real> values_;
+    };
+
+    /*! \relates CSRMatrix */
+    Disposable<CSRMatrix> operator+(const CSRMatrix&, const CSRMatrix&);
+
+    /*! \relates CSRMatrix */
+    Disposable<Array> prod(const CSRMatrix& A, const Array& x);
+
+}
+
+#endif
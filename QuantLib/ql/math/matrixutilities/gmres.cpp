@@ -0,0 +1,128 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file gmres.cpp
+    \brief generalized minimal residual method
+*/
+
+#include <ql/math/matrix.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    GMRES::GMRES(const GMRES::MatrixMult& A,
+                 Size maxIter, Real relTol,
+                 const GMRES::MatrixMult& preConditioner)
+    : A_(A), M_(preConditioner),
+      maxIter_(maxIter), relTol_(relTol) {
+        QL_REQUIRE(maxIter_ > 0, "maxIter must be greater than zero");
+    }
+
+    GMRESResult GMRES::solve(const Array& b, const Array& x0) const {
+        return solveWithRestart(maxIter_, b, x0);
+    }
+
+    GMRESResult GMRES::solveWithRestart(
+        Size restart, const Array& b, const Array& x0) const {
+        QL_REQUIRE(restart > 0, "restart must be greater than zero");
+
+        const Real bnorm2 = norm2(b);
+        if (bnorm2 == 0.0) {
+            GMRESResult result = { 0, 0.0, b };
+            return result;
+        }
+
+        Array x = ((!x0.empty()) ? x0 : Array(b.size(), 0.0));
+
+        Size iterations = 0;
+        Real error;
+        for (;;) {
+            const Array r = b - A_(x);
+            const Real beta = norm2(r);
+            error = beta/bnorm2;
+            if (error < relTol_ || iterations >= maxIter_)
+                break;
+
+            const Size m = std::min(restart, maxIter_ - iterations);
+
+            // Arnoldi process with modified Gram-Schmidt; the Hessenberg
+            // matrix is reduced to upper triangular form on the fly by
+            // Givens rotations, which gives the residual norm for free.
+            std::vector<Array> v(1, r/beta), z;
+            Matrix h(m+1, m, 0.0);
+            std::vector<Real> g(m+1, 0.0), c(m), s(m);
+            g[0] = beta;
+
+            Size k;
+            for (k=0; k < m; ++k) {
+                z.push_back((M_) ? M_(v[k]) : v[k]);
+                Array w = A_(z[k]);
+
+                for (Size j=0; j <= k; ++j) {
+                    h[j][k] = DotProduct(w, v[j]);
+                    w -= h[j][k]*v[j];
+                }
+                const Real hk1 = norm2(w);
+                h[k+1][k] = hk1;
+
+                for (Size j=0; j < k; ++j) {
+                    const Real t = c[j]*h[j][k] + s[j]*h[j+1][k];
+                    h[j+1][k] = -s[j]*h[j][k] + c[j]*h[j+1][k];
+                    h[j][k] = t;
+                }
+
+                const Real den = std::sqrt(h[k][k]*h[k][k]+hk1*hk1);
+                QL_REQUIRE(den != 0.0, "GMRES breakdown");
+                c[k] = h[k][k]/den;
+                s[k] = hk1/den;
+                h[k][k] = den;
+                h[k+1][k] = 0.0;
+
+                g[k+1] = -s[k]*g[k];
+                g[k]   =  c[k]*g[k];
+
+                ++iterations;
+                if (std::fabs(g[k+1]) < relTol_*bnorm2 || hk1 == 0.0) {
+                    ++k;
+                    break;
+                }
+                v.push_back(w/hk1);
+            }
+
+            // solve the upper triangular system and update the solution
+            std::vector<Real> y(k);
+            for (Size i=k; i-- > 0;) {
+                Real t = g[i];
+                for (Size j=i+1; j < k; ++j)
+                    t -= h[i][j]*y[j];
+                y[i] = t/h[i][i];
+            }
+            for (Size j=0; j < k; ++j)
+                x += y[j]*z[j];
+        }
+
+        QL_REQUIRE(error < relTol_, "could not converge");
+
+        GMRESResult result = { iterations, error, x };
+        return result;
+    }
+
+    Real GMRES::norm2(const Array& a) const {
+        return std::sqrt(DotProduct(a, a));
+    }
+}
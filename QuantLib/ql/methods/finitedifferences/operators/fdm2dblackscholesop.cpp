@@ -166,4 +166,15 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CSRMatrix> >
+    Fdm2dBlackScholesOp::toCSRMatrixDecomp() const {
+        std::vector<CSRMatrix> retVal(3);
+        retVal[0] = opX_.toCSRMatrix();
+        retVal[1] = opY_.toCSRMatrix();
+        retVal[2] = corrMapT_.toCSRMatrix();
+        retVal[2].scaleAndShift(1.0, currentForwardRate_);
+
+        return retVal;
+    }
 }
@@ -138,4 +138,12 @@ namespace QuantLib {
     }
 #endif
 
+    Disposable<CSRMatrix> FdmBatesOp::preconditionerMatrix() const {
+        // the jump integral couples all nodes along x; only its
+        // diagonal part -lambda is kept next to the diffusion part
+        CSRMatrix retVal = hestonOp_->toCSRMatrix();
+        retVal.scaleAndShift(1.0, -lambda_);
+        return retVal;
+    }
+
 }
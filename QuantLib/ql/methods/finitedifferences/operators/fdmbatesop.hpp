@@ -58,6 +58,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<CSRMatrix> preconditionerMatrix() const;
       private:
         class IntegroIntegrand {
           public:
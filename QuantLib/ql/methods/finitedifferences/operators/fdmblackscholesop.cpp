@@ -25,6 +25,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -34,7 +35,8 @@ namespace QuantLib {
         Real strike,
         bool localVol,
         Real illegalLocalVolOverwrite,
-        Size direction)
+        Size direction,
+        Size strikeDirection)
     : mesher_(mesher),
       rTS_   (bsProcess->riskFreeRate().currentLink()),
       qTS_   (bsProcess->dividendYield().currentLink()),
@@ -47,7 +49,11 @@ namespace QuantLib {
       mapT_  (direction, mesher),
       strike_(strike),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
-      direction_(direction) {
+      direction_(direction),
+      strikeDirection_(strikeDirection) {
+        QL_REQUIRE(strikeDirection_ == Null<Size>()
+                   || strikeDirection_ != direction_,
+                   "strike and spot direction must differ");
     }
 
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
@@ -80,6 +86,27 @@ namespace QuantLib {
             mapT_.axpyb(r - q - 0.5*v, dxMap_,
                         dxxMap_.mult(0.5*v), Array(1, -r));
         }
+        else if (strikeDirection_ != Null<Size>()) {
+            const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
+            const FdmLinearOpIterator endIter = layout->end();
+
+            // one variance per stacked option
+            std::vector<Real> vk(layout->dim()[strikeDirection_],
+                                 Null<Real>());
+            Array v(layout->size());
+            for (FdmLinearOpIterator iter = layout->begin();
+                 iter!=endIter; ++iter) {
+                const Size k = iter.coordinates()[strikeDirection_];
+                if (vk[k] == Null<Real>()) {
+                    vk[k] = volTS_->blackForwardVariance(
+                        t1, t2, mesher_->location(iter, strikeDirection_))
+                        /(t2-t1);
+                }
+                v[iter.index()] = vk[k];
+            }
+            mapT_.axpyb(r - q - 0.5*v, dxMap_,
+                        dxxMap_.mult(0.5*v), Array(1, -r));
+        }
         else {
             const Real v
                 = volTS_->blackForwardVariance(t1, t2, strike_)/(t2-t1);
@@ -127,6 +154,38 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply_into(const Array& r, Array& out) const {
+        mapT_.apply_into(r, out);
+    }
+
+    void FdmBlackScholesOp::apply_mixed_into(const Array& r,
+                                             Array& out) const {
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_direction_into(Size direction,
+                                                 const Array& r,
+                                                 Array& out) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, out);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmBlackScholesOp::solve_splitting_into(Size direction,
+                                                 const Array& r,
+                                                 Array& out, Real dt) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, out, dt, 1.0);
+        else
+            out = r;
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmBlackScholesOp::toMatrixDecomp() const {
@@ -134,4 +193,10 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CSRMatrix> >
+    FdmBlackScholesOp::toCSRMatrixDecomp() const {
+        std::vector<CSRMatrix> retVal(1, mapT_.toCSRMatrix());
+        return retVal;
+    }
 }
@@ -34,6 +34,12 @@
 
 namespace QuantLib {
 
+    //! Black Scholes operator in the log-spot direction
+    /*! If strikeDirection is given, the mesher stacks the grids of
+        several options and the Black variance of each grid point is
+        taken at the strike given by its location in that direction;
+        otherwise the given strike is used everywhere.
+    */
     class FdmBlackScholesOp : public FdmLinearOpComposite {
       public:
         FdmBlackScholesOp(
@@ -42,7 +48,8 @@ namespace QuantLib {
             Real strike,
             bool localVol = false,
             Real illegalLocalVolOverwrite = -Null<Real>(),
-            Size direction = 0);
+            Size direction = 0,
+            Size strikeDirection = Null<Size>());
 
         Size size() const;
         void setTime(Time t1, Time t2);
@@ -55,9 +62,17 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& out) const;
+        void apply_mixed_into(const Array& r, Array& out) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& out) const;
+        void solve_splitting_into(Size direction, const Array& r,
+                                  Array& out, Real s) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<std::vector<CSRMatrix> > toCSRMatrixDecomp() const;
       private:
         const boost::shared_ptr<FdmMesher> mesher_;
         const boost::shared_ptr<YieldTermStructure> rTS_, qTS_;
@@ -69,7 +84,7 @@ namespace QuantLib {
         TripleBandLinearOp mapT_;
         const Real strike_;
         const Real illegalLocalVolOverwrite_;
-        const Size direction_;
+        const Size direction_, strikeDirection_;
     };
 }
 
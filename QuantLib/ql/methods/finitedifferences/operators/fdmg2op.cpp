@@ -27,6 +27,7 @@
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
+#include <algorithm>
 
 
 namespace QuantLib {
@@ -52,7 +53,8 @@ namespace QuantLib {
                           model->rho()*model->sigma()*model->eta()))),
       mapX_(direction1, mesher),
       mapY_(direction2, mesher),
-      model_(model) {
+      model_(model),
+      rateTerm_(mesher->layout()->size()) {
     }
 
     Size FdmG2Op::size() const {
@@ -67,9 +69,10 @@ namespace QuantLib {
         const Real phi = 0.5*(  dynamics->shortRate(t1, 0.0, 0.0)
                               + dynamics->shortRate(t2, 0.0, 0.0));
 
-        const Array hr = -0.5*(x_ + y_ + phi);
-        mapX_.axpyb(Array(), dxMap_, dxMap_, hr);
-        mapY_.axpyb(Array(), dyMap_, dyMap_, hr);
+        for (Size i=0; i < rateTerm_.size(); ++i)
+            rateTerm_[i] = -0.5*(x_[i] + y_[i] + phi);
+        mapX_.axpyb(Array(), dxMap_, dxMap_, rateTerm_);
+        mapY_.axpyb(Array(), dyMap_, dyMap_, rateTerm_);
     }
 
     Disposable<Array> FdmG2Op::apply(const Array& r) const {
@@ -113,6 +116,44 @@ namespace QuantLib {
         return solve_splitting(direction1_, r, dt);
     }
 
+    void FdmG2Op::apply_into(const Array& r, Array& out) const {
+        mapX_.apply_into(r, out);
+        mapY_.apply_into(r, tmp_);
+        out += tmp_;
+        corrMap_.apply_into(r, tmp_);
+        out += tmp_;
+    }
+
+    void FdmG2Op::apply_mixed_into(const Array& r, Array& out) const {
+        corrMap_.apply_into(r, out);
+    }
+
+    void FdmG2Op::apply_direction_into(Size direction,
+                                       const Array& r, Array& out) const {
+        if (direction == direction1_)
+            mapX_.apply_into(r, out);
+        else if (direction == direction2_)
+            mapY_.apply_into(r, out);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmG2Op::solve_splitting_into(Size direction, const Array& r,
+                                       Array& out, Real a) const {
+        if (direction == direction1_)
+            mapX_.solve_splitting_into(r, out, a, 1.0);
+        else if (direction == direction2_)
+            mapY_.solve_splitting_into(r, out, a, 1.0);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> > FdmG2Op::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(3);
@@ -123,5 +164,14 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CSRMatrix> > FdmG2Op::toCSRMatrixDecomp() const {
+        std::vector<CSRMatrix> retVal(3);
+        retVal[0] = mapX_.toCSRMatrix();
+        retVal[1] = mapY_.toCSRMatrix();
+        retVal[2] = corrMap_.toCSRMatrix();
+
+        return retVal;
+    }
 }
 
@@ -51,9 +51,17 @@ namespace QuantLib {
             solve_splitting(Size direction, const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& out) const;
+        void apply_mixed_into(const Array& r, Array& out) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& out) const;
+        void solve_splitting_into(Size direction, const Array& r,
+                                  Array& out, Real s) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<std::vector<CSRMatrix> > toCSRMatrixDecomp() const;
       private:
         const Size direction1_, direction2_;
         const Array x_, y_;
@@ -63,6 +71,9 @@ namespace QuantLib {
         TripleBandLinearOp mapX_, mapY_;
 
         const boost::shared_ptr<G2> model_;
+
+        Array rateTerm_;
+        mutable Array tmp_;
     };
 }
 
@@ -156,6 +156,52 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonHullWhiteOp::apply_into(const Array& r,
+                                          Array& out) const {
+        dyMap_.apply_into(r, out);
+        dxMap_.getMap().apply_into(r, tmp_);
+        out += tmp_;
+        hullWhiteOp_.apply_into(r, tmp_);
+        out += tmp_;
+        hestonCorrMap_.apply_into(r, tmp_);
+        out += tmp_;
+        equityIrCorrMap_.apply_into(r, tmp_);
+        out += tmp_;
+    }
+
+    void FdmHestonHullWhiteOp::apply_mixed_into(const Array& r,
+                                                Array& out) const {
+        hestonCorrMap_.apply_into(r, out);
+        equityIrCorrMap_.apply_into(r, tmp_);
+        out += tmp_;
+    }
+
+    void FdmHestonHullWhiteOp::apply_direction_into(Size direction,
+                                                    const Array& r,
+                                                    Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, out);
+        else if (direction == 1)
+            dyMap_.apply_into(r, out);
+        else if (direction == 2)
+            hullWhiteOp_.apply_direction_into(2, r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonHullWhiteOp::solve_splitting_into(Size direction,
+                                                    const Array& r,
+                                                    Array& out, Real a) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, out, a, 1.0);
+        else if (direction == 1)
+            dyMap_.solve_splitting_into(r, out, a, 1.0);
+        else if (direction == 2)
+            hullWhiteOp_.solve_splitting_into(2, r, out, a);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonHullWhiteOp::toMatrixDecomp() const {
@@ -168,4 +214,16 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CSRMatrix> >
+    FdmHestonHullWhiteOp::toCSRMatrixDecomp() const {
+        std::vector<CSRMatrix> retVal(4);
+        retVal[0] = dxMap_.getMap().toCSRMatrix();
+        retVal[1] = dyMap_.toCSRMatrix();
+        retVal[2] = hullWhiteOp_.toCSRMatrixDecomp().front();
+        retVal[3] = hestonCorrMap_.toCSRMatrix()
+                    + equityIrCorrMap_.toCSRMatrix();
+
+        return retVal;
+    }
 }
@@ -80,9 +80,17 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Disposable<Array> preconditioner(const Array& r, Real s) const;
 
+        void apply_into(const Array& r, Array& out) const;
+        void apply_mixed_into(const Array& r, Array& out) const;
+        void apply_direction_into(Size direction,
+                                  const Array& r, Array& out) const;
+        void solve_splitting_into(Size direction, const Array& r,
+                                  Array& out, Real s) const;
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const;
 #endif
+        Disposable<std::vector<CSRMatrix> > toCSRMatrixDecomp() const;
       private:
         const Real v0_, kappa_, theta_, sigma_, rho_;
         const boost::shared_ptr<HullWhite> hwModel_;
@@ -92,6 +100,7 @@ namespace QuantLib {
         TripleBandLinearOp dyMap_;
         FdmHestonHullWhiteEquityPart dxMap_;
         FdmHullWhiteOp hullWhiteOp_;
+        mutable Array tmp_;
     };
 }
 
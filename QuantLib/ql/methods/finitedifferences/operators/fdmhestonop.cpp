@@ -36,6 +36,8 @@ namespace QuantLib {
       dxMap_ (FirstDerivativeOp(0, mesher)),
       dxxMap_(SecondDerivativeOp(0, mesher).mult(0.5*mesher->locations(1))),
       mapT_  (0, mesher),
+      driftTerm_(mesher->layout()->size()),
+      rateTerm_(1),
       mesher_(mesher),
       rTS_(rTS),
       qTS_(qTS),
@@ -67,7 +69,10 @@ namespace QuantLib {
                 dxMap_, dxxMap_, Array(1, -0.5*r));
         }
         else {
-            mapT_.axpyb(r - q - varianceValues_, dxMap_, dxxMap_, Array(1, -0.5*r));
+            for (Size i=0; i < driftTerm_.size(); ++i)
+                driftTerm_[i] = r - q - varianceValues_[i];
+            rateTerm_[0] = -0.5*r;
+            mapT_.axpyb(driftTerm_, dxMap_, dxxMap_, rateTerm_);
         }
     }
 
@@ -84,12 +89,14 @@ namespace QuantLib {
              .add(FirstDerivativeOp(1, mesher)
                   .mult(kappa*(theta - mesher->locations(1))))),
       mapT_(1, mesher),
+      rateTerm_(1),
       rTS_(rTS) {
     }
 
     void FdmHestonVariancePart::setTime(Time t1, Time t2) {
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
-        mapT_.axpyb(Array(), dyMap_, dyMap_, Array(1,-0.5*r));
+        rateTerm_[0] = -0.5*r;
+        mapT_.axpyb(Array(), dyMap_, dyMap_, rateTerm_);
     }
 
     const TripleBandLinearOp& FdmHestonVariancePart::getMap() const {
@@ -162,6 +169,38 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonOp::apply_into(const Array& r, Array& out) const {
+        dyMap_.getMap().apply_into(r, out);
+        dxMap_.getMap().apply_into(r, tmp_);
+        out += tmp_;
+        correlationMap_.apply_into(r, tmp_);
+        out += tmp_;
+    }
+
+    void FdmHestonOp::apply_mixed_into(const Array& r, Array& out) const {
+        correlationMap_.apply_into(r, out);
+    }
+
+    void FdmHestonOp::apply_direction_into(Size direction,
+                                           const Array& r, Array& out) const {
+        if (direction == 0)
+            dxMap_.getMap().apply_into(r, out);
+        else if (direction == 1)
+            dyMap_.getMap().apply_into(r, out);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::solve_splitting_into(Size direction, const Array& r,
+                                           Array& out, Real a) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting_into(r, out, a, 1.0);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting_into(r, out, a, 1.0);
+        else
+            QL_FAIL("direction too large");
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHestonOp::toMatrixDecomp() const {
@@ -174,4 +213,15 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CSRMatrix> >
+    FdmHestonOp::toCSRMatrixDecomp() const {
+        std::vector<CSRMatrix> retVal(3);
+
+        retVal[0] = dxMap_.getMap().toCSRMatrix();
+        retVal[1] = dyMap_.getMap().toCSRMatrix();
+        retVal[2] = correlationMap_.toCSRMatrix();
+
+        return retVal;
+    }
 }
@@ -26,6 +26,7 @@
 #include <ql/methods/finitedifferences/operators/fdmhullwhiteop.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -40,7 +41,8 @@ namespace QuantLib {
                     .mult(0.5*model->sigma()*model->sigma()
                           *Array(mesher->layout()->size(), 1.0)))),
       mapT_(direction, mesher),
-      model_(model) {
+      model_(model),
+      rateTerm_(mesher->layout()->size()) {
     }
 
     Size FdmHullWhiteOp::size() const {
@@ -55,7 +57,9 @@ namespace QuantLib {
         const Real phi = 0.5*(  dynamics->shortRate(t1, 0.0)
                               + dynamics->shortRate(t2, 0.0));
 
-        mapT_.axpyb(Array(), dzMap_, dzMap_, -(x_+phi));
+        for (Size i=0; i < rateTerm_.size(); ++i)
+            rateTerm_[i] = -(x_[i]+phi);
+        mapT_.axpyb(Array(), dzMap_, dzMap_, rateTerm_);
     }
 
     Disposable<Array> FdmHullWhiteOp::apply(const Array& r) const {
@@ -94,6 +98,39 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmHullWhiteOp::apply_into(const Array& r, Array& out) const {
+        mapT_.apply_into(r, out);
+    }
+
+    void FdmHullWhiteOp::apply_mixed_into(const Array& r, Array& out) const {
+        if (out.size() != r.size())
+            Array(r.size()).swap(out);
+        std::fill(out.begin(), out.end(), 0.0);
+    }
+
+    void FdmHullWhiteOp::apply_direction_into(Size direction,
+                                              const Array& r,
+                                              Array& out) const {
+        if (direction == direction_)
+            mapT_.apply_into(r, out);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
+    void FdmHullWhiteOp::solve_splitting_into(Size direction, const Array& r,
+                                              Array& out, Real a) const {
+        if (direction == direction_)
+            mapT_.solve_splitting_into(r, out, a, 1.0);
+        else {
+            if (out.size() != r.size())
+                Array(r.size()).swap(out);
+            std::fill(out.begin(), out.end(), 0.0);
+        }
+    }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
     Disposable<std::vector<SparseMatrix> >
     FdmHullWhiteOp::toMatrixDecomp() const {
@@ -101,5 +138,11 @@ namespace QuantLib {
         return retVal;
     }
 #endif
+
+    Disposable<std::vector<CSRMatrix> >
+    FdmHullWhiteOp::toCSRMatrixDecomp() const {
+        std::vector<CSRMatrix> retVal(1, mapT_.toCSRMatrix());
+        return retVal;
+    }
 }
 
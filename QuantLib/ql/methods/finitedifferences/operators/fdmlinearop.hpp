@@ -28,6 +28,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 
 namespace QuantLib {
 
@@ -37,9 +38,28 @@ namespace QuantLib {
         virtual ~FdmLinearOp() { }
         virtual Disposable<array_type> apply(const array_type& r) const = 0;
 
+        //! in-place variant of apply, writes the result into \p out
+        /*! Derived classes can override this method to avoid the
+            allocation of a temporary array for each call. The array
+            \p out is resized if needed and must not alias \p r.
+        */
+        virtual void apply_into(const array_type& r, array_type& out) const {
+            out = apply(r);
+        }
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<SparseMatrix> toMatrix() const = 0;
 #endif
+
+        //! matrix representation in compressed sparse row format
+        virtual Disposable<CSRMatrix> toCSRMatrix() const {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+            CSRMatrix retVal(toMatrix());
+            return retVal;
+#else
+            QL_FAIL("CSR representation is not implemented");
+#endif
+        }
     };
 }
 
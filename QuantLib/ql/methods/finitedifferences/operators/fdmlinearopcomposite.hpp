@@ -51,6 +51,31 @@ namespace QuantLib {
         virtual Disposable<Array> 
             preconditioner(const Array& r, Real s) const = 0;
 
+        /*! \name In-place variants
+            The default implementations forward to the methods above;
+            operators used in time-stepping loops should override them
+            in order to avoid temporary arrays. The array \p out is
+            resized if needed and must not alias \p r.
+
+            \warning overrides can accumulate the parts of the operator
+                     in scratch buffers owned by the operator; in
+                     this case the in-place methods must not be
+                     called concurrently on the same instance.
+        */
+        //@{
+        virtual void apply_mixed_into(const Array& r, Array& out) const {
+            out = apply_mixed(r);
+        }
+        virtual void apply_direction_into(Size direction,
+                                          const Array& r, Array& out) const {
+            out = apply_direction(direction, r);
+        }
+        virtual void solve_splitting_into(Size direction, const Array& r,
+                                          Array& out, Real s) const {
+            out = solve_splitting(direction, r, s);
+        }
+        //@}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
         virtual Disposable<std::vector<SparseMatrix> > toMatrixDecomp() const {
             QL_FAIL(" ublas representation is not implemented");
@@ -63,6 +88,42 @@ namespace QuantLib {
             return retVal;
         }
 #endif
+
+        /*! The default implementation converts the ublas decomposition;
+            operators built from triple-band and nine-point maps
+            override it to create the CSR matrices directly.
+        */
+        virtual Disposable<std::vector<CSRMatrix> > toCSRMatrixDecomp() const {
+#if !defined(QL_NO_UBLAS_SUPPORT)
+            const std::vector<SparseMatrix> dcmp = toMatrixDecomp();
+            std::vector<CSRMatrix> retVal;
+            retVal.reserve(dcmp.size());
+            for (Size i=0; i < dcmp.size(); ++i)
+                retVal.push_back(CSRMatrix(dcmp[i]));
+            return retVal;
+#else
+            QL_FAIL("CSR representation is not implemented");
+#endif
+        }
+
+        Disposable<CSRMatrix> toCSRMatrix() const {
+            const std::vector<CSRMatrix> dcmp = toCSRMatrixDecomp();
+            QL_REQUIRE(!dcmp.empty(), "empty operator decomposition");
+            CSRMatrix retVal = dcmp.front();
+            for (Size i=1; i < dcmp.size(); ++i)
+                retVal = retVal + dcmp[i];
+            return retVal;
+        }
+
+        /*! sparse matrix the algebraic multigrid preconditioner is
+            built on. The default is the operator itself; operators
+            with a dense part, e.g., the integral term of a jump
+            process, return a sparse approximation instead, while the
+            Krylov solver still iterates on the full apply().
+        */
+        virtual Disposable<CSRMatrix> preconditionerMatrix() const {
+            return toCSRMatrix();
+        }
     };
 }
 
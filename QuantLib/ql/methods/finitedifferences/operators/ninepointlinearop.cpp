@@ -130,12 +130,22 @@ namespace QuantLib {
 
     Disposable<Array> NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        apply_into(u, retVal);
+
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply_into(const Array& u, Array& out) const {
 
         const boost::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
+        QL_REQUIRE(&u != &out, "r and out must not be the same array");
+
+        if (out.size() != u.size())
+            Array(u.size()).swap(out);
 
-        Array retVal(u.size());
         // direct access to make the following code faster.
         const Real *a00(a00_.get()), *a01(a01_.get()), *a02(a02_.get());
         const Real *a10(a10_.get()), *a11(a11_.get()), *a12(a12_.get());
@@ -144,19 +154,22 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
-            retVal[i] =   a00[i]*u[i00[i]]
-                        + a01[i]*u[i01[i]]
-                        + a02[i]*u[i02[i]]
-                        + a10[i]*u[i10[i]]
-                        + a11[i]*u[i]
-                        + a12[i]*u[i12[i]]
-                        + a20[i]*u[i20[i]]
-                        + a21[i]*u[i21[i]]
-                        + a22[i]*u[i22[i]];
+        const Real* uptr = u.begin();
+        Real* optr = out.begin();
+
+        const long n = long(u.size());
+        #pragma omp parallel for default(shared) if(n >= 4096)
+        for (long i=0; i < n; ++i) {
+            optr[i] =   a00[i]*uptr[i00[i]]
+                      + a01[i]*uptr[i01[i]]
+                      + a02[i]*uptr[i02[i]]
+                      + a10[i]*uptr[i10[i]]
+                      + a11[i]*uptr[i]
+                      + a12[i]*uptr[i12[i]]
+                      + a20[i]*uptr[i20[i]]
+                      + a21[i]*uptr[i21[i]]
+                      + a22[i]*uptr[i22[i]];
         }
-        return retVal;
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -181,6 +194,29 @@ namespace QuantLib {
     }
 #endif
 
+    Disposable<CSRMatrix> NinePointLinearOp::toCSRMatrix() const {
+        const Size n = mesher_->layout()->size();
+
+        const Size* idx[] = { i00_.get(), i01_.get(), i02_.get(),
+                              i10_.get(), 0,          i12_.get(),
+                              i20_.get(), i21_.get(), i22_.get() };
+        const Real* val[] = { a00_.get(), a01_.get(), a02_.get(),
+                              a10_.get(), a11_.get(), a12_.get(),
+                              a20_.get(), a21_.get(), a22_.get() };
+
+        std::vector<Size> columns(9*n);
+        std::vector<Real> values(9*n);
+        for (Size i=0; i < n; ++i) {
+            for (Size k=0; k < 9; ++k) {
+                columns[9*i+k] = (idx[k] != 0) ? idx[k][i] : i;
+                values[9*i+k]  = val[k][i];
+            }
+        }
+
+        CSRMatrix retVal(n, n, 9, columns, values);
+        return retVal;
+    }
+
 
     Disposable<NinePointLinearOp>
         NinePointLinearOp::mult(const Array & u) const {
@@ -26,6 +26,14 @@
 
 namespace QuantLib {
 
+    namespace {
+        // Grid lines are processed in tasks of at most chunkSize
+        // neighbouring lines; smaller operators are processed serially
+        // as the thread start-up would outweigh the gain.
+        const Size chunkSize = 128;
+        const Size minParallelSize = 4096;
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
         Size direction,
         const boost::shared_ptr<FdmMesher>& mesher)
@@ -36,6 +44,7 @@ namespace QuantLib {
       lower_    (new Real[mesher->layout()->size()]),
       diag_     (new Real[mesher->layout()->size()]),
       upper_    (new Real[mesher->layout()->size()]),
+      tmp_      (new Real[mesher->layout()->size()]),
       mesher_(mesher) {
 
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
@@ -68,6 +77,7 @@ namespace QuantLib {
       lower_(new Real[m.mesher_->layout()->size()]),
       diag_ (new Real[m.mesher_->layout()->size()]),
       upper_(new Real[m.mesher_->layout()->size()]),
+      tmp_  (new Real[m.mesher_->layout()->size()]),
       mesher_(m.mesher_) {
         const Size len = m.mesher_->layout()->size();
         std::copy(m.i0_.get(), m.i0_.get() + len, i0_.get());
@@ -105,6 +115,7 @@ namespace QuantLib {
         i0_.swap(m.i0_); i2_.swap(m.i2_);
         reverseIndex_.swap(m.reverseIndex_);
         lower_.swap(m.lower_); diag_.swap(m.diag_); upper_.swap(m.upper_);
+        tmp_.swap(m.tmp_);
     }
 
     void TripleBandLinearOp::axpyb(const Array& a,
@@ -226,9 +237,21 @@ namespace QuantLib {
     }
 
     Disposable<Array> TripleBandLinearOp::apply(const Array& r) const {
-        const boost::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
+        array_type retVal(r.size());
+        apply_into(r, retVal);
 
-        QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply_into(const Array& r, Array& out) const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size n = layout->size();
+
+        QL_REQUIRE(r.size() == n, "inconsistent length of r");
+        QL_REQUIRE(&r != &out, "r and out must not be the same array");
+
+        if (out.size() != n)
+            Array(n).swap(out);
 
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
@@ -236,13 +259,59 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
-        array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
-            retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
+        const Real* rptr = r.begin();
+        Real* optr = out.begin();
+
+        const Size m = layout->dim()[direction_];
+        if (m < 3) {
+            //#pragma omp parallel for
+            for (Size i=0; i < n; ++i) {
+                optr[i] = rptr[i0ptr[i]]*lptr[i] + rptr[i]*dptr[i]
+                        + rptr[i2ptr[i]]*uptr[i];
+            }
+            return;
         }
 
-        return retVal;
+        // The points along a grid line in the given direction are
+        // s = spacing[direction] apart, hence all points off the
+        // boundaries of the line have their neighbours at i-s and i+s.
+        // Away from the first and the last row the operator is
+        // therefore applied by contiguous loops without index lookups,
+        // which can be vectorized by the compiler.
+        const Size s = layout->spacing()[direction_];
+        const Size lineLength = s*m;
+        const Size chunk = std::min(s, chunkSize);
+        const Size nChunks = (s + chunk - 1)/chunk;
+        const long nTasks = long((n/lineLength)*nChunks);
+
+        // the tasks write to disjoint parts of out
+        #pragma omp parallel for default(shared) if(n >= minParallelSize)
+        for (long k=0; k < nTasks; ++k) {
+            const Size base = Size(k/nChunks)*lineLength;
+            const Size first = Size(k%nChunks)*chunk;
+            const Size end = std::min(first + chunk, s);
+            const Size last = base + (m-1)*s;
+
+            for (Size i=base+first; i < base+end; ++i)
+                optr[i] = rptr[i0ptr[i]]*lptr[i] + rptr[i]*dptr[i]
+                        + rptr[i2ptr[i]]*uptr[i];
+
+            if (nChunks == 1) {
+                for (Size i=base+s; i < last; ++i)
+                    optr[i] = rptr[i-s]*lptr[i] + rptr[i]*dptr[i]
+                            + rptr[i+s]*uptr[i];
+            }
+            else {
+                for (Size row=base+s; row < last; row+=s)
+                    for (Size i=row+first; i < row+end; ++i)
+                        optr[i] = rptr[i-s]*lptr[i] + rptr[i]*dptr[i]
+                                + rptr[i+s]*uptr[i];
+            }
+
+            for (Size i=last+first; i < last+end; ++i)
+                optr[i] = rptr[i0ptr[i]]*lptr[i] + rptr[i]*dptr[i]
+                        + rptr[i2ptr[i]]*uptr[i];
+        }
     }
 
 #if !defined(QL_NO_UBLAS_SUPPORT)
@@ -262,11 +331,42 @@ namespace QuantLib {
 #endif
 
 
+    Disposable<CSRMatrix> TripleBandLinearOp::toCSRMatrix() const {
+        const Size n = mesher_->layout()->size();
+
+        std::vector<Size> columns(3*n);
+        std::vector<Real> values(3*n);
+        for (Size i=0; i < n; ++i) {
+            columns[3*i  ] = i0_[i]; values[3*i  ] = lower_[i];
+            columns[3*i+1] = i;      values[3*i+1] = diag_[i];
+            columns[3*i+2] = i2_[i]; values[3*i+2] = upper_[i];
+        }
+
+        CSRMatrix retVal(n, n, 3, columns, values);
+        return retVal;
+    }
+
     Disposable<Array>
     TripleBandLinearOp::solve_splitting(const Array& r, Real a, Real b) const {
+        Array retVal(r.size()), tmp(r.size());
+        solve_splitting(r, retVal, a, b, tmp.begin());
+
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting_into(const Array& r, Array& out,
+                                                  Real a, Real b) const {
+        solve_splitting(r, out, a, b, tmp_.get());
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array& r, Array& retVal,
+                                             Real a, Real b, Real* tmp) const {
         const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
 
+        if (retVal.size() != r.size())
+            Array(r.size()).swap(retVal);
+
 #ifdef QL_EXTRA_SAFETY_CHECKS
         for (FdmLinearOpIterator iter = layout->begin();
              iter!=layout->end(); ++iter) {
@@ -278,36 +378,98 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
-
         const Real* lptr = lower_.get();
         const Real* dptr = diag_.get();
         const Real* uptr = upper_.get();
 
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet=1.0/(a*dptr[rim1]+b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1]*bet;
+        const Size n = layout->size();
+        const Size m = layout->dim()[direction_];
+
+        if (m < 3) {
+            // Thomson algorithm to solve a tridiagonal system.
+            // Example code taken from Tridiagonalopertor and
+            // changed to fit for the triple band operator.
+            Size rim1 = reverseIndex_[0];
+            Real bet=1.0/(a*dptr[rim1]+b);
+            QL_REQUIRE(bet != 0.0, "division by zero");
+            retVal[reverseIndex_[0]] = r[rim1]*bet;
 
-        for (Size j=1; j<=layout->size()-1; j++){
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a*uptr[rim1]*bet;
+            for (Size j=1; j<=n-1; j++){
+                const Size ri = reverseIndex_[j];
+                tmp[j] = a*uptr[rim1]*bet;
 
-            bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet=1.0/bet;
+                bet=b+a*(dptr[ri]-tmp[j]*lptr[ri]);
+                QL_ENSURE(bet != 0.0, "division by zero");
+                bet=1.0/bet;
 
-            retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
-            rim1 = ri;
+                retVal[ri] = (r[ri]-a*lptr[ri]*retVal[rim1])*bet;
+                rim1 = ri;
+            }
+            // cannot be j>=0 with Size j
+            for (Size j=n-2; j>0; --j)
+                retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
+            retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
+
+            return;
         }
-        // cannot be j>=0 with Size j
-        for (Size j=layout->size()-2; j>0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j+1]*retVal[reverseIndex_[j+1]];
-        retVal[reverseIndex_[0]] -= tmp[1]*retVal[reverseIndex_[1]];
 
-        return retVal;
+        // Thomson algorithm applied to all grid lines of a block at
+        // once: the lines are s = spacing[direction] points apart, hence
+        // each row of the block is contiguous in memory and the inner
+        // loops run over independent systems. As the boundary entries of
+        // the operator vanish this gives the same result as a single
+        // sweep over the reverse index. tmp holds the modified upper
+        // diagonal using the natural index.
+        const Size s = layout->spacing()[direction_];
+        const Size lineLength = s*m;
+        const Size chunk = std::min(s, chunkSize);
+        const Size nChunks = (s + chunk - 1)/chunk;
+        const long nTasks = long((n/lineLength)*nChunks);
+
+        const Real* rptr = r.begin();
+        Real* x = retVal.begin();
+
+        // each task solves the systems of up to chunkSize neighbouring
+        // grid lines; the tasks touch disjoint parts of x and tmp
+        long zeroPivots = 0;
+        #pragma omp parallel for default(shared) reduction(+:zeroPivots) \
+                                 if(n >= minParallelSize)
+        for (long k=0; k < nTasks; ++k) {
+            const Size base = Size(k/nChunks)*lineLength;
+            const Size first = Size(k%nChunks)*chunk;
+            const Size end = std::min(first + chunk, s);
+            const Size last = base + (m-1)*s;
+
+            for (Size i=base+first; i < base+end; ++i) {
+                const Real d = a*dptr[i]+b;
+                zeroPivots += (d == 0.0);
+                const Real bet = 1.0/d;
+                x[i] = rptr[i]*bet;
+                tmp[i+s] = a*uptr[i]*bet;
+            }
+
+            for (Size row=base+s; row < last; row+=s) {
+                for (Size i=row+first; i < row+end; ++i) {
+                    const Real d = b+a*(dptr[i]-tmp[i]*lptr[i]);
+                    zeroPivots += (d == 0.0);
+                    const Real bet = 1.0/d;
+                    x[i] = (rptr[i]-a*lptr[i]*x[i-s])*bet;
+                    tmp[i+s] = a*uptr[i]*bet;
+                }
+            }
+
+            for (Size i=last+first; i < last+end; ++i) {
+                const Real d = b+a*(dptr[i]-tmp[i]*lptr[i]);
+                zeroPivots += (d == 0.0);
+                const Real bet = 1.0/d;
+                x[i] = (rptr[i]-a*lptr[i]*x[i-s])*bet;
+            }
+
+            for (Size row=last; row > base; row-=s) {
+                for (Size i=row-s+first; i < row-s+end; ++i)
+                    x[i] -= tmp[i+s]*x[i+s];
+            }
+        }
+        QL_ENSURE(zeroPivots == 0, "division by zero");
     }
 }
@@ -47,6 +47,16 @@ namespace QuantLib {
         Disposable<Array> solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
 
+        //! in-place variant of apply; \p out must not alias \p r
+        void apply_into(const Array& r, Array& out) const;
+        //! in-place variant of solve_splitting; \p out may alias \p r
+        /*! \warning this method uses a scratch buffer owned by the
+                     operator, therefore it must not be called
+                     concurrently on the same instance.
+        */
+        void solve_splitting_into(const Array& r, Array& out,
+                                  Real a, Real b = 1.0) const;
+
         Disposable<TripleBandLinearOp> mult(const Array& u) const;
         Disposable<TripleBandLinearOp> add(const TripleBandLinearOp& m) const;
         Disposable<TripleBandLinearOp> add(const Array& u) const;
@@ -60,6 +70,7 @@ namespace QuantLib {
 #if !defined(QL_NO_UBLAS_SUPPORT)
         Disposable<SparseMatrix> toMatrix() const;
 #endif
+        Disposable<CSRMatrix> toCSRMatrix() const;
 
       protected:
         TripleBandLinearOp() {}
@@ -68,8 +79,13 @@ namespace QuantLib {
         boost::shared_array<Size> i0_, i2_;
         boost::shared_array<Size> reverseIndex_;
         boost::shared_array<Real> lower_, diag_, upper_;
+        boost::shared_array<Real> tmp_;
 
         boost::shared_ptr<FdmMesher> mesher_;
+
+      private:
+        void solve_splitting(const Array& r, Array& out,
+                             Real a, Real b, Real* tmp) const;
     };
 }
 
@@ -54,6 +54,9 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // scratch buffers re-used across time steps
+        array_type y_, rhs_;
     };
 }
 
@@ -20,6 +20,8 @@
 */
 
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/amgpreconditioner.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -36,11 +38,17 @@ namespace QuantLib {
     ImplicitEulerScheme::ImplicitEulerScheme(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const bc_set& bcSet,
-        Real relTol)
+        Real relTol,
+        SolverType solverType,
+        PreconditionerType preconditionerType)
     : dt_    (Null<Real>()),
       relTol_(relTol),
       map_   (map),
-      bcSet_ (bcSet) {
+      bcSet_ (bcSet),
+      solverType_(solverType),
+      preconditionerType_(preconditionerType),
+      amgDt_(Null<Real>()),
+      iterations_(0) {
     }
 
     Disposable<Array> ImplicitEulerScheme::apply(const Array& r) const {
@@ -54,19 +62,49 @@ namespace QuantLib {
 
         bcSet_.applyBeforeSolving(*map_, a);
 
-        a = BiCGstab(
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&ImplicitEulerScheme::apply, this, _1)), 
-                10*a.size(), relTol_,
-                boost::function<Disposable<Array>(const Array&)>(
-                    boost::bind(&FdmLinearOpComposite::preconditioner, 
-                                map_, _1, -dt_))
-            ).solve(a).x;
-        
+        typedef boost::function<Disposable<Array>(const Array&)> MatrixMult;
+
+        MatrixMult preconditioner;
+        if (preconditionerType_ == AlgebraicMultigrid) {
+            if (!amg_ || amgDt_ != dt_) {
+                CSRMatrix m = map_->preconditionerMatrix();
+                m.scaleAndShift(-dt_, 1.0);
+                amg_ = boost::shared_ptr<AMGPreconditioner>(
+                                                new AMGPreconditioner(m));
+                amgDt_ = dt_;
+            }
+            preconditioner = boost::bind(&AMGPreconditioner::apply, amg_, _1);
+        }
+        else {
+            preconditioner = boost::bind(&FdmLinearOpComposite::preconditioner,
+                                         map_, _1, -dt_);
+        }
+        const MatrixMult A(boost::bind(&ImplicitEulerScheme::apply, this, _1));
+
+        // the solution of the previous step is a good initial guess
+        if (solverType_ == GMRES) {
+            const GMRESResult result =
+                QuantLib::GMRES(A, 10*a.size(), relTol_, preconditioner)
+                    .solveWithRestart(50, a, a);
+            iterations_ += result.iterations;
+            a = result.x;
+        }
+        else {
+            const BiCGStabResult result =
+                QuantLib::BiCGstab(A, 10*a.size(), relTol_, preconditioner)
+                    .solve(a, a);
+            iterations_ += result.iterations;
+            a = result.x;
+        }
+
         bcSet_.applyAfterSolving(a);
     }
 
     void ImplicitEulerScheme::setStep(Time dt) {
         dt_=dt;
     }
+
+    Size ImplicitEulerScheme::numberOfIterations() const {
+        return iterations_;
+    }
 }
@@ -32,8 +32,22 @@
 
 namespace QuantLib {
 
+    class AMGPreconditioner;
+
+    //! implicit Euler scheme
+    /*! The linear system of each time step is solved iteratively
+        starting from the solution of the previous step. The solver
+        is either BiCGstab or restarted GMRES; the preconditioner is
+        either the operator's own preconditioner() or an algebraic
+        multigrid preconditioner. The latter is built on the operator's
+        preconditionerMatrix(); its hierarchy is built at the first
+        step and reused for all further steps of the same size.
+    */
     class ImplicitEulerScheme {
       public:
+        enum SolverType { BiCGstab, GMRES };
+        enum PreconditionerType { OperatorSplitting, AlgebraicMultigrid };
+
         // typedefs
         typedef OperatorTraits<FdmLinearOp> traits;
         typedef traits::operator_type operator_type;
@@ -45,11 +59,16 @@ namespace QuantLib {
         ImplicitEulerScheme(
             const boost::shared_ptr<FdmLinearOpComposite>& map,
             const bc_set& bcSet = bc_set(),
-            Real relTol = 1e-8);
+            Real relTol = 1e-8,
+            SolverType solverType = BiCGstab,
+            PreconditionerType preconditionerType = OperatorSplitting);
 
         void step(array_type& a, Time t);
         void setStep(Time dt);
 
+        //! total number of solver iterations of all steps so far
+        Size numberOfIterations() const;
+
       protected:
         Disposable<Array> apply(const Array& r) const;   
           
@@ -57,6 +76,12 @@ namespace QuantLib {
         const Real relTol_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        const SolverType solverType_;
+        const PreconditionerType preconditionerType_;
+
+        boost::shared_ptr<AMGPreconditioner> amg_;
+        Time amgDt_;
+        Size iterations_;
     };
 }
 
@@ -60,6 +60,9 @@ namespace QuantLib {
         const Real mu_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // scratch buffers re-used across time steps
+        array_type y_, y0_, yt_, rhs_;
     };
 }
 
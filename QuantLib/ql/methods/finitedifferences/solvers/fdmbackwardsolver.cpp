@@ -34,8 +34,14 @@
 
 namespace QuantLib {
     
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+    FdmSchemeDesc::FdmSchemeDesc(
+                  FdmSchemeType aType, Real aTheta, Real aMu,
+                  ImplicitEulerScheme::SolverType aSolverType,
+                  ImplicitEulerScheme::PreconditionerType aPreconditionerType,
+                  Real aRelTol)
+    : type(aType), theta(aTheta), mu(aMu),
+      solverType(aSolverType), relTol(aRelTol),
+      preconditionerType(aPreconditionerType) { }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { 
         return FdmSchemeDesc(FdmSchemeDesc::DouglasType, 0.5, 0.0);
@@ -68,6 +74,14 @@ namespace QuantLib {
         return FdmSchemeDesc(FdmSchemeDesc::ImplicitEulerType, 0.0, 0.0);
     }
 
+    FdmSchemeDesc FdmSchemeDesc::ImplicitEuler(
+                  ImplicitEulerScheme::SolverType solverType,
+                  ImplicitEulerScheme::PreconditionerType preconditionerType,
+                  Real relTol) {
+        return FdmSchemeDesc(FdmSchemeDesc::ImplicitEulerType, 0.0, 0.0,
+                             solverType, preconditionerType, relTol);
+    }
+
     FdmBackwardSolver::FdmBackwardSolver(
         const boost::shared_ptr<FdmLinearOpComposite>& map,
         const FdmBoundaryConditionSet& bcSet,
@@ -92,7 +106,10 @@ namespace QuantLib {
                     
         if (   dampingSteps 
             && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
-            ImplicitEulerScheme implicitEvolver(map_, bcSet_);    
+            ImplicitEulerScheme implicitEvolver(
+                               map_, bcSet_, schemeDesc_.relTol,
+                               schemeDesc_.solverType,
+                               schemeDesc_.preconditionerType);
             FiniteDifferenceModel<ImplicitEulerScheme> 
                     dampingModel(implicitEvolver, condition_->stoppingTimes());
             dampingModel.rollback(rhs, from, dampingTo, 
@@ -138,7 +155,10 @@ namespace QuantLib {
             break;
           case FdmSchemeDesc::ImplicitEulerType:
             {
-                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                ImplicitEulerScheme implicitEvolver(
+                               map_, bcSet_, schemeDesc_.relTol,
+                               schemeDesc_.solverType,
+                               schemeDesc_.preconditionerType);
                 FiniteDifferenceModel<ImplicitEulerScheme> 
                    implicitModel(implicitEvolver, condition_->stoppingTimes());
                 implicitModel.rollback(rhs, from, to, allSteps, *condition_);
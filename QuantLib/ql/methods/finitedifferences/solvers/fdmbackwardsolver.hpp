@@ -26,6 +26,7 @@
 #define quantlib_fdm_backward_solver_hpp
 
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 
 namespace QuantLib {
 
@@ -37,14 +38,32 @@ namespace QuantLib {
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        /*! The solver, its relative tolerance and the preconditioner
+            are used for the implicit Euler steps, i.e., for the
+            ImplicitEulerType scheme and for the damping steps of the
+            other schemes.
+        */
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      ImplicitEulerScheme::SolverType solverType
+                          = ImplicitEulerScheme::BiCGstab,
+                      ImplicitEulerScheme::PreconditionerType
+                          preconditionerType
+                              = ImplicitEulerScheme::OperatorSplitting,
+                      Real relTol = 1e-8);
 
         const FdmSchemeType type;
         const Real theta, mu;
+        const ImplicitEulerScheme::SolverType solverType;
+        const Real relTol;
+        const ImplicitEulerScheme::PreconditionerType preconditionerType;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas();
         static FdmSchemeDesc ImplicitEuler();
+        static FdmSchemeDesc ImplicitEuler(
+                  ImplicitEulerScheme::SolverType solverType,
+                  ImplicitEulerScheme::PreconditionerType preconditionerType,
+                  Real relTol = 1e-8);
         static FdmSchemeDesc ExplicitEuler();
         static FdmSchemeDesc CraigSneyd();
         static FdmSchemeDesc ModifiedCraigSneyd(); 
@@ -102,6 +102,34 @@ namespace QuantLib {
         return retVal;
     }
     
+    FdmLogMultiPayoffInnerValue::FdmLogMultiPayoffInnerValue(
+                const std::vector<boost::shared_ptr<Payoff> >& payoffs,
+                const boost::shared_ptr<FdmMesher>& mesher,
+                Size direction, Size payoffDirection)
+    : payoffDirection_(payoffDirection),
+      calculators_(payoffs.size()) {
+        QL_REQUIRE(payoffs.size() == mesher->layout()->dim()[payoffDirection],
+                   "number of payoffs (" << payoffs.size() << ") does not "
+                   "match the number of grid lines ("
+                   << mesher->layout()->dim()[payoffDirection] << ")");
+
+        for (Size i=0; i < payoffs.size(); ++i)
+            calculators_[i] = boost::shared_ptr<FdmLogInnerValue>(
+                new FdmLogInnerValue(payoffs[i], mesher, direction));
+    }
+
+    Real FdmLogMultiPayoffInnerValue::innerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[payoffDirection_]]
+            ->innerValue(iter, t);
+    }
+
+    Real FdmLogMultiPayoffInnerValue::avgInnerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[payoffDirection_]]
+            ->avgInnerValue(iter, t);
+    }
+
     FdmLogBasketInnerValue::FdmLogBasketInnerValue(
                                 const boost::shared_ptr<BasketPayoff>& payoff,
                                 const boost::shared_ptr<FdmMesher>& mesher)
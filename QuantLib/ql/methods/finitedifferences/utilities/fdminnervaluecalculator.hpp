@@ -78,6 +78,25 @@ namespace QuantLib {
         const boost::shared_ptr<FdmMesher> mesher_;
     };
 
+    //! log inner values of several payoffs stacked along one direction
+    /*! The k-th grid line in payoffDirection carries the k-th payoff,
+        e.g. to roll back the options of a whole strike chain at once.
+    */
+    class FdmLogMultiPayoffInnerValue : public FdmInnerValueCalculator {
+      public:
+        FdmLogMultiPayoffInnerValue(
+                const std::vector<boost::shared_ptr<Payoff> >& payoffs,
+                const boost::shared_ptr<FdmMesher>& mesher,
+                Size direction, Size payoffDirection);
+
+        Real innerValue(const FdmLinearOpIterator& iter, Time);
+        Real avgInnerValue(const FdmLinearOpIterator& iter, Time);
+
+      private:
+        const Size payoffDirection_;
+        std::vector<boost::shared_ptr<FdmLogInnerValue> > calculators_;
+    };
+
     class FdmZeroInnerValue : public FdmInnerValueCalculator {
       public:
         Real innerValue(const FdmLinearOpIterator&, Time)    { return 0.0; }
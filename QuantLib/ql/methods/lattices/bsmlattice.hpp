@@ -47,6 +47,9 @@ namespace QuantLib {
                                 Size) const { return discount_; }
 
         void stepback(Size i, const Array& values, Array& newValues) const;
+        void stepback(Size i,
+                      const std::vector<const Array*>& values,
+                      const std::vector<Array*>& newValues) const;
 
         Real underlying(Size i, Size index) const {
             return tree_->underlying(i, index);
@@ -88,6 +91,15 @@ namespace QuantLib {
             newValues[j] = (pd_*values[j] + pu_*values[j+1])*discount_;
     }
 
+    template <class T>
+    void BlackScholesLattice<T>::stepback(
+                               Size i,
+                               const std::vector<const Array*>& values,
+                               const std::vector<Array*>& newValues) const {
+        for (Size k=0; k<values.size(); k++)
+            stepback(i, *values[k], *newValues[k]);
+    }
+
 }
 
 
@@ -28,6 +28,8 @@
 #include <ql/numericalmethod.hpp>
 #include <ql/discretizedasset.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <boost/shared_ptr.hpp>
+#include <ql/utilities/cachemutex.hpp>
 
 namespace QuantLib {
 
@@ -43,14 +45,25 @@ namespace QuantLib {
           Size descendant(Size i, Size index, Size branch) const;
           Real probability(Size i, Size index, Size branch) const;
         \endcode
-        and may implement the following:
+        and may implement the following (both or none):
         \code
         public:
           void stepback(Size i,
                         const Array& values,
                         Array& newValues) const;
+          void stepback(Size i,
+                        const std::vector<const Array*>& values,
+                        const std::vector<Array*>& newValues) const;
         \endcode
 
+        The default stepback implementation copies the descendants,
+        probabilities and discount factors of each time step in
+        contiguous tables the first time the step is rolled back
+        over, and uses them afterwards; therefore, they must not
+        change after the first rollback.  Several assets can be
+        rolled back together, in which case each node is visited
+        once for all of them.
+
         \ingroup lattices
     */
     template <class Impl>
@@ -59,9 +72,13 @@ namespace QuantLib {
       public:
         TreeLattice(const TimeGrid& timeGrid,
                     Size n)
-        : Lattice(timeGrid), n_(n) {
+        : Lattice(timeGrid), n_(n),
+          stepTables_(timeGrid.size() > 0 ? timeGrid.size()-1 : 0) {
             QL_REQUIRE(n>0, "there is no zeronomial lattice!");
             statePrices_ = std::vector<Array>(1, Array(1, 1.0));
+            // references to the state prices are returned; make sure
+            // that adding new ones doesn't invalidate them
+            statePrices_.reserve(timeGrid.size());
             statePricesLimit_ = 0;
         }
 
@@ -70,6 +87,9 @@ namespace QuantLib {
         void initialize(DiscretizedAsset&, Time t) const;
         void rollback(DiscretizedAsset&, Time to) const;
         void partialRollback(DiscretizedAsset&, Time to) const;
+        void rollback(const std::vector<DiscretizedAsset*>&, Time to) const;
+        void partialRollback(const std::vector<DiscretizedAsset*>&,
+                             Time to) const;
         //! Computes the present value of an asset using Arrow-Debrew prices
         Real presentValue(DiscretizedAsset&) const;
         //@}
@@ -79,6 +99,9 @@ namespace QuantLib {
         void stepback(Size i,
                       const Array& values,
                       Array& newValues) const;
+        void stepback(Size i,
+                      const std::vector<const Array*>& values,
+                      const std::vector<Array*>& newValues) const;
 
       protected:
         void computeStatePrices(Size until) const;
@@ -87,8 +110,21 @@ namespace QuantLib {
         mutable std::vector<Array> statePrices_;
 
       private:
+        // branch-major tables for a single time step
+        struct StepTable {
+            std::vector<Size> descendants;
+            std::vector<Real> probabilities;
+            std::vector<DiscountFactor> discounts;
+        };
+        boost::shared_ptr<StepTable> stepTable(Size i) const;
+
         Size n_;
         mutable Size statePricesLimit_;
+        mutable std::vector<boost::shared_ptr<StepTable> > stepTables_;
+        // the state prices and step tables are filled lazily by any
+        // thread using the lattice
+        mutable detail::CacheMutex statePricesMutex_;
+        mutable detail::CacheMutex stepTablesMutex_;
     };
 
 
@@ -112,6 +148,7 @@ namespace QuantLib {
 
     template <class Impl>
     const Array& TreeLattice<Impl>::statePrices(Size i) const {
+        detail::CacheMutex::scoped_lock lock(statePricesMutex_);
         if (i>statePricesLimit_)
             computeStatePrices(i);
         return statePrices_[i];
@@ -163,18 +200,120 @@ namespace QuantLib {
         }
     }
 
+    template <class Impl>
+    inline void TreeLattice<Impl>::rollback(
+                               const std::vector<DiscretizedAsset*>& assets,
+                               Time to) const {
+        partialRollback(assets,to);
+        for (Size k=0; k<assets.size(); ++k)
+            assets[k]->adjustValues();
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::partialRollback(
+                               const std::vector<DiscretizedAsset*>& assets,
+                               Time to) const {
+
+        if (assets.empty())
+            return;
+
+        Time from = assets[0]->time();
+        for (Size k=1; k<assets.size(); ++k)
+            QL_REQUIRE(close(assets[k]->time(),from),
+                       "assets to be rolled back together must be "
+                       "at the same time (" << assets[k]->time()
+                       << " != " << from << ")");
+
+        if (close(from,to))
+            return;
+
+        QL_REQUIRE(from > to,
+                   "cannot roll the assets back to" << to
+                   << " (they are already at t = " << from << ")");
+
+        Integer iFrom = Integer(t_.index(from));
+        Integer iTo = Integer(t_.index(to));
+
+        const Size n = assets.size();
+        std::vector<const Array*> values(n);
+        std::vector<Array*> newValues(n);
+        std::vector<Array> buffers(n);
+        for (Integer i=iFrom-1; i>=iTo; --i) {
+            for (Size k=0; k<n; ++k) {
+                buffers[k] = Array(this->impl().size(i));
+                values[k] = &assets[k]->values();
+                newValues[k] = &buffers[k];
+            }
+            this->impl().stepback(i, values, newValues);
+            for (Size k=0; k<n; ++k) {
+                assets[k]->time() = t_[i];
+                assets[k]->values().swap(buffers[k]);
+            }
+            // skip the very last adjustment
+            if (i != iTo) {
+                for (Size k=0; k<n; ++k)
+                    assets[k]->adjustValues();
+            }
+        }
+    }
+
+    template <class Impl>
+    boost::shared_ptr<typename TreeLattice<Impl>::StepTable>
+    TreeLattice<Impl>::stepTable(Size i) const {
+        detail::CacheMutex::scoped_lock lock(stepTablesMutex_);
+        boost::shared_ptr<StepTable> table = stepTables_[i];
+        if (!table) {
+            table = boost::shared_ptr<StepTable>(new StepTable);
+            const Size size = this->impl().size(i);
+            table->descendants.resize(n_*size);
+            table->probabilities.resize(n_*size);
+            table->discounts.resize(size);
+            for (Size j=0; j<size; j++) {
+                for (Size l=0; l<n_; l++) {
+                    table->descendants[l*size+j] =
+                        this->impl().descendant(i,j,l);
+                    table->probabilities[l*size+j] =
+                        this->impl().probability(i,j,l);
+                }
+                table->discounts[j] = this->impl().discount(i,j);
+            }
+            stepTables_[i] = table;
+        }
+        return table;
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
+        std::vector<const Array*> v(1, &values);
+        std::vector<Array*> newV(1, &newValues);
+        stepback(i, v, newV);
+    }
+
+    template <class Impl>
+    void TreeLattice<Impl>::stepback(
+                               Size i,
+                               const std::vector<const Array*>& values,
+                               const std::vector<Array*>& newValues) const {
+        const boost::shared_ptr<StepTable> table = stepTable(i);
+        const Size size = table->discounts.size();
+        const Size nAssets = values.size();
+        const Size* descendants = &table->descendants[0];
+        const Real* probabilities = &table->probabilities[0];
+        const DiscountFactor* discounts = &table->discounts[0];
+
         #pragma omp parallel for
-        for (Size j=0; j<this->impl().size(i); j++) {
-            Real value = 0.0;
-            for (Size l=0; l<n_; l++) {
-                value += this->impl().probability(i,j,l) *
-                         values[this->impl().descendant(i,j,l)];
+        for (Size j=0; j<size; j++) {
+            for (Size k=0; k<nAssets; k++) {
+                const Array& v = *values[k];
+                Real value = 0.0;
+                for (Size l=0; l<n_; l++) {
+                    value += probabilities[l*size+j] *
+                             v[descendants[l*size+j]];
+                }
+                value *= discounts[j];
+                (*newValues[k])[j] = value;
             }
-            value *= this->impl().discount(i,j);
-            newValues[j] = value;
         }
     }
 
@@ -47,6 +47,13 @@ namespace QuantLib {
         Size size(Size i) const;
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
+
+        void stepback(Size i,
+                      const Array& values,
+                      Array& newValues) const;
+        void stepback(Size i,
+                      const std::vector<const Array*>& values,
+                      const std::vector<Array*>& newValues) const;
       protected:
         boost::shared_ptr<T> tree1_, tree2_;
         // smelly
@@ -131,6 +138,67 @@ namespace QuantLib {
         return prob1*prob2 + rho_*(m_[branch1][branch2])/36.0;
     }
 
+    /* The branching of the two trees is combined on the fly, so that
+       no table proportional to the number of nodes is needed. */
+    template <class Impl, class T>
+    void TreeLattice2D<Impl,T>::stepback(Size i, const Array& values,
+                                         Array& newValues) const {
+        std::vector<const Array*> v(1, &values);
+        std::vector<Array*> newV(1, &newValues);
+        stepback(i, v, newV);
+    }
+
+    template <class Impl, class T>
+    void TreeLattice2D<Impl,T>::stepback(
+                               Size i,
+                               const std::vector<const Array*>& values,
+                               const std::vector<Array*>& newValues) const {
+        const Size n = T::branches;
+        const Size size1 = tree1_->size(i), size2 = tree2_->size(i);
+        const Size modulo = tree1_->size(i+1);
+        const Size nAssets = values.size();
+
+        std::vector<Size> d1(size1*n), d2(size2*n);
+        std::vector<Real> p1(size1*n), p2(size2*n);
+        for (Size j=0; j<size1; ++j) {
+            for (Size b=0; b<n; ++b) {
+                d1[j*n+b] = tree1_->descendant(i, j, b);
+                p1[j*n+b] = tree1_->probability(i, j, b);
+            }
+        }
+        for (Size j=0; j<size2; ++j) {
+            for (Size b=0; b<n; ++b) {
+                d2[j*n+b] = tree2_->descendant(i, j, b)*modulo;
+                p2[j*n+b] = tree2_->probability(i, j, b);
+            }
+        }
+        std::vector<Real> correction(n*n);
+        for (Size b2=0; b2<n; ++b2)
+            for (Size b1=0; b1<n; ++b1)
+                correction[b2*n+b1] = rho_*(m_[b1][b2])/36.0;
+
+        #pragma omp parallel for
+        for (Size j=0; j<size1*size2; j++) {
+            const Size* dd1 = &d1[(j % size1)*n];
+            const Size* dd2 = &d2[(j / size1)*n];
+            const Real* pp1 = &p1[(j % size1)*n];
+            const Real* pp2 = &p2[(j / size1)*n];
+            const DiscountFactor discount = this->impl().discount(i,j);
+            for (Size k=0; k<nAssets; k++) {
+                const Array& v = *values[k];
+                Real value = 0.0;
+                for (Size b2=0; b2<n; b2++) {
+                    for (Size b1=0; b1<n; b1++) {
+                        value += (pp1[b1]*pp2[b2] + correction[b2*n+b1]) *
+                                 v[dd1[b1] + dd2[b2]];
+                    }
+                }
+                value *= discount;
+                (*newValues[k])[j] = value;
+            }
+        }
+    }
+
 }
 
 
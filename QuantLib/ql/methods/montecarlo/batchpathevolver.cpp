@@ -0,0 +1,330 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/montecarlo/batchpathevolver.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/processes/hullwhiteprocess.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    BatchPathEvolver::BatchPathEvolver(
+                        const boost::shared_ptr<StochasticProcess>& process)
+    : process_(process),
+      process1D_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)) {
+        QL_REQUIRE(process_, "null process");
+
+        // specialized kernels are only used for the classes whose
+        // evolve() method they reproduce
+        const std::type_info& type = typeid(*process_);
+        if (type == typeid(GeneralizedBlackScholesProcess)
+            || type == typeid(BlackScholesProcess)
+            || type == typeid(BlackScholesMertonProcess)
+            || type == typeid(BlackProcess)
+            || type == typeid(GarmanKohlagenProcess))
+            bsProcess_ =
+                boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                                    process);
+        else if (type == typeid(HestonProcess))
+            hestonProcess_ =
+                boost::dynamic_pointer_cast<HestonProcess>(process);
+        else if (type == typeid(HullWhiteProcess))
+            hwProcess_ = boost::dynamic_pointer_cast<HullWhiteProcess>(process);
+    }
+
+    void BatchPathEvolver::evolve(const std::vector<Real>& dw,
+                                  PathBatch& batch) const {
+        QL_REQUIRE(batch.assetNumber() == process_->size(),
+                   "batch size (" << batch.assetNumber()
+                   << ") != process size (" << process_->size() << ")");
+        QL_REQUIRE(dw.size() == (batch.pathSize()-1)*process_->factors()
+                                *batch.size(),
+                   "wrong number of random variates");
+
+        if (bsProcess_)
+            evolveBlackScholes(dw, batch);
+        else if (hestonProcess_)
+            evolveHeston(dw, batch);
+        else if (hwProcess_)
+            evolveHullWhite(dw, batch);
+        else if (process1D_)
+            evolveGeneric1D(dw, batch);
+        else
+            evolveGeneric(dw, batch);
+    }
+
+    void BatchPathEvolver::evolveGeneric(const std::vector<Real>& dw,
+                                         PathBatch& batch) const {
+        const Size m = process_->size();
+        const Size n = process_->factors();
+        const Size nPaths = batch.size();
+        const TimeGrid& grid = batch.timeGrid();
+
+        const Array x0 = process_->initialValues();
+        for (Size j=0; j<m; ++j)
+            std::fill(batch.values(j,0), batch.values(j,0)+nPaths, x0[j]);
+
+        Array x(m), w(n);
+        for (Size i=1; i<grid.size(); ++i) {
+            const Time t = grid[i-1], dt = grid.dt(i-1);
+            const Real* dwi = &dw[(i-1)*n*nPaths];
+            for (Size p=0; p<nPaths; ++p) {
+                for (Size j=0; j<m; ++j)
+                    x[j] = batch(j, i-1, p);
+                for (Size k=0; k<n; ++k)
+                    w[k] = dwi[k*nPaths + p];
+                x = process_->evolve(t, x, dt, w);
+                for (Size j=0; j<m; ++j)
+                    batch(j, i, p) = x[j];
+            }
+        }
+    }
+
+    void BatchPathEvolver::evolveGeneric1D(const std::vector<Real>& dw,
+                                           PathBatch& batch) const {
+        const Size nPaths = batch.size();
+        const TimeGrid& grid = batch.timeGrid();
+
+        std::fill(batch.values(0,0), batch.values(0,0)+nPaths,
+                  process1D_->x0());
+
+        for (Size i=1; i<grid.size(); ++i) {
+            const Time t = grid[i-1], dt = grid.dt(i-1);
+            const Real* dwi = &dw[(i-1)*nPaths];
+            const Real* x0 = batch.values(0, i-1);
+            Real* x1 = batch.values(0, i);
+            for (Size p=0; p<nPaths; ++p)
+                x1[p] = process1D_->evolve(t, x0[p], dt, dwi[p]);
+        }
+    }
+
+    void BatchPathEvolver::evolveBlackScholes(const std::vector<Real>& dw,
+                                              PathBatch& batch) const {
+        const boost::shared_ptr<BlackVolTermStructure> vol =
+            bsProcess_->blackVolatility().currentLink();
+
+        // same test as in GeneralizedBlackScholesProcess::localVolatility
+        if (!boost::dynamic_pointer_cast<BlackConstantVol>(vol)
+            && !boost::dynamic_pointer_cast<BlackVarianceCurve>(vol)) {
+            evolveGeneric1D(dw, batch);
+            return;
+        }
+
+        const Handle<YieldTermStructure>& r = bsProcess_->riskFreeRate();
+        const Handle<YieldTermStructure>& q = bsProcess_->dividendYield();
+
+        const Size nPaths = batch.size();
+        const TimeGrid& grid = batch.timeGrid();
+
+        std::fill(batch.values(0,0), batch.values(0,0)+nPaths,
+                  bsProcess_->x0());
+
+        for (Size i=1; i<grid.size(); ++i) {
+            const Time t0 = grid[i-1], dt = grid.dt(i-1);
+            const Real variance = vol->blackVariance(t0 + dt, 0.01)
+                                - vol->blackVariance(t0, 0.01);
+            const Real drift =
+                (r->forwardRate(t0, t0+dt, Continuous, NoFrequency, true)
+                 - q->forwardRate(t0, t0+dt, Continuous, NoFrequency, true))
+                * dt - 0.5 * variance;
+            const Real stdDev = std::sqrt(variance);
+
+            const Real* dwi = &dw[(i-1)*nPaths];
+            const Real* x0 = batch.values(0, i-1);
+            Real* x1 = batch.values(0, i);
+            for (Size p=0; p<nPaths; ++p)
+                x1[p] = x0[p] * std::exp(stdDev * dwi[p] + drift);
+        }
+    }
+
+    void BatchPathEvolver::evolveHeston(const std::vector<Real>& dw,
+                                        PathBatch& batch) const {
+        const HestonProcess::Discretization discretization =
+            hestonProcess_->discretizationScheme();
+
+        switch (discretization) {
+          case HestonProcess::PartialTruncation:
+          case HestonProcess::FullTruncation:
+          case HestonProcess::Reflection:
+          case HestonProcess::QuadraticExponential:
+          case HestonProcess::QuadraticExponentialMartingale:
+            break;
+          default:
+            // the remaining schemes are dominated by the sampling
+            // of the variance and gain nothing from the batch kernel
+            evolveGeneric(dw, batch);
+            return;
+        }
+
+        const Real kappa = hestonProcess_->kappa();
+        const Real theta = hestonProcess_->theta();
+        const Real sigma = hestonProcess_->sigma();
+        const Real rho   = hestonProcess_->rho();
+        const Handle<YieldTermStructure>& r = hestonProcess_->riskFreeRate();
+        const Handle<YieldTermStructure>& q = hestonProcess_->dividendYield();
+
+        const Size nPaths = batch.size();
+        const TimeGrid& grid = batch.timeGrid();
+
+        std::fill(batch.values(0,0), batch.values(0,0)+nPaths,
+                  hestonProcess_->s0()->value());
+        std::fill(batch.values(1,0), batch.values(1,0)+nPaths,
+                  hestonProcess_->v0());
+
+        const Real sqrhov = std::sqrt(1.0 - rho*rho);
+        const CumulativeNormalDistribution N;
+
+        for (Size i=1; i<grid.size(); ++i) {
+            const Time t0 = grid[i-1], dt = grid.dt(i-1);
+            const Real sdt = std::sqrt(dt);
+            const Real rq = r->forwardRate(t0, t0+dt, Continuous)
+                          - q->forwardRate(t0, t0+dt, Continuous);
+
+            const Real* dw0 = &dw[2*(i-1)*nPaths];
+            const Real* dw1 = dw0 + nPaths;
+            const Real* s0 = batch.values(0, i-1);
+            const Real* v0 = batch.values(1, i-1);
+            Real* s1 = batch.values(0, i);
+            Real* v1 = batch.values(1, i);
+
+            switch (discretization) {
+              case HestonProcess::PartialTruncation:
+                for (Size p=0; p<nPaths; ++p) {
+                    const Real vol = (v0[p] > 0.0) ? std::sqrt(v0[p]) : 0.0;
+                    const Real vol2 = sigma * vol;
+                    const Real mu = rq - 0.5 * vol * vol;
+                    const Real nu = kappa*(theta - v0[p]);
+
+                    s1[p] = s0[p] * std::exp(mu*dt+vol*dw0[p]*sdt);
+                    v1[p] = v0[p] + nu*dt
+                          + vol2*sdt*(rho*dw0[p] + sqrhov*dw1[p]);
+                }
+                break;
+              case HestonProcess::FullTruncation:
+                for (Size p=0; p<nPaths; ++p) {
+                    const Real vol = (v0[p] > 0.0) ? std::sqrt(v0[p]) : 0.0;
+                    const Real vol2 = sigma * vol;
+                    const Real mu = rq - 0.5 * vol * vol;
+                    const Real nu = kappa*(theta - vol*vol);
+
+                    s1[p] = s0[p] * std::exp(mu*dt+vol*dw0[p]*sdt);
+                    v1[p] = v0[p] + nu*dt
+                          + vol2*sdt*(rho*dw0[p] + sqrhov*dw1[p]);
+                }
+                break;
+              case HestonProcess::Reflection:
+                for (Size p=0; p<nPaths; ++p) {
+                    const Real vol = std::sqrt(std::fabs(v0[p]));
+                    const Real vol2 = sigma * vol;
+                    const Real mu = rq - 0.5 * vol*vol;
+                    const Real nu = kappa*(theta - vol*vol);
+
+                    s1[p] = s0[p]*std::exp(mu*dt+vol*dw0[p]*sdt);
+                    v1[p] = vol*vol
+                          + nu*dt + vol2*sdt*(rho*dw0[p] + sqrhov*dw1[p]);
+                }
+                break;
+              default:
+              {
+                // quadratic exponential scheme, see HestonProcess::evolve
+                const Real ex = std::exp(-kappa*dt);
+
+                const Real g1 =  0.5;
+                const Real g2 =  0.5;
+                const Real k0 = -rho*kappa*theta*dt/sigma;
+                const Real k1 =  g1*dt*(kappa*rho/sigma-0.5)-rho/sigma;
+                const Real k2 =  g2*dt*(kappa*rho/sigma-0.5)+rho/sigma;
+                const Real k3 =  g1*dt*(1-rho*rho);
+                const Real k4 =  g2*dt*(1-rho*rho);
+                const Real A  =  k2+0.5*k4;
+                const bool martingale = (discretization
+                    == HestonProcess::QuadraticExponentialMartingale);
+
+                for (Size p=0; p<nPaths; ++p) {
+                    const Real m  =  theta+(v0[p]-theta)*ex;
+                    const Real s2 =  v0[p]*sigma*sigma*ex/kappa*(1-ex)
+                                   + theta*sigma*sigma/(2*kappa)*(1-ex)*(1-ex);
+                    const Real psi = s2/(m*m);
+
+                    Real k = k0;
+                    if (psi < 1.5) {
+                        const Real b2 = 2/psi-1+std::sqrt(2/psi*(2/psi-1));
+                        const Real b  = std::sqrt(b2);
+                        const Real a  = m/(1+b2);
+
+                        if (martingale) {
+                            QL_REQUIRE(A < 1/(2*a), "illegal value");
+                            k = -A*b2*a/(1-2*A*a)+0.5*std::log(1-2*A*a)
+                                -(k1+0.5*k3)*v0[p];
+                        }
+                        v1[p] = a*(b+dw1[p])*(b+dw1[p]);
+                    }
+                    else {
+                        const Real pr = (psi-1)/(psi+1);
+                        const Real beta = (1-pr)/m;
+
+                        const Real u = N(dw1[p]);
+
+                        if (martingale) {
+                            QL_REQUIRE(A < beta, "illegal value");
+                            k = -std::log(pr+beta*(1-pr)/(beta-A))
+                                -(k1+0.5*k3)*v0[p];
+                        }
+                        v1[p] = ((u <= pr) ? 0.0
+                                           : std::log((1-pr)/(1-u))/beta);
+                    }
+
+                    s1[p] = s0[p]*std::exp(rq*dt + k + k1*v0[p] + k2*v1[p]
+                                           +std::sqrt(k3*v0[p]+k4*v1[p])
+                                           *dw0[p]);
+                }
+              }
+            }
+        }
+    }
+
+    void BatchPathEvolver::evolveHullWhite(const std::vector<Real>& dw,
+                                           PathBatch& batch) const {
+        const Size nPaths = batch.size();
+        const TimeGrid& grid = batch.timeGrid();
+        const Real a = hwProcess_->a();
+
+        std::fill(batch.values(0,0), batch.values(0,0)+nPaths,
+                  hwProcess_->x0());
+
+        for (Size i=1; i<grid.size(); ++i) {
+            const Time t0 = grid[i-1], dt = grid.dt(i-1);
+            // the conditional expectation is affine in the short rate
+            // and the standard deviation does not depend on it
+            const Real decay = std::exp(-a*dt);
+            const Real shift = hwProcess_->expectation(t0, 0.0, dt);
+            const Real stdDev = hwProcess_->stdDeviation(t0, 0.0, dt);
+
+            const Real* dwi = &dw[(i-1)*nPaths];
+            const Real* x0 = batch.values(0, i-1);
+            Real* x1 = batch.values(0, i);
+            for (Size p=0; p<nPaths; ++p)
+                x1[p] = x0[p]*decay + shift + stdDev*dwi[p];
+        }
+    }
+
+}
+
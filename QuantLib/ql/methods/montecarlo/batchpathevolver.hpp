@@ -0,0 +1,87 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchpathevolver.hpp
+    \brief Evolves a batch of paths of a stochastic process
+*/
+
+#ifndef quantlib_montecarlo_batch_path_evolver_hpp
+#define quantlib_montecarlo_batch_path_evolver_hpp
+
+#include <ql/methods/montecarlo/pathbatch.hpp>
+#include <ql/stochasticprocess.hpp>
+
+namespace QuantLib {
+
+    class GeneralizedBlackScholesProcess;
+    class HestonProcess;
+    class HullWhiteProcess;
+
+    //! Evolves a batch of paths of a stochastic process
+    /*! The paths are evolved one time step at a time over all the
+        paths of the batch.  Quantities depending only on the time
+        step (forward rates, variances, discretization constants) are
+        calculated once per step and the per-path work is done in a
+        tight loop over contiguous memory.
+
+        Specialized kernels are provided for the
+        GeneralizedBlackScholesProcess family (when the volatility is
+        strike-independent), for the HestonProcess (Euler and
+        quadratic-exponential discretizations) and for the
+        HullWhiteProcess.  They reproduce the results of the
+        corresponding evolve() methods; any other process, including
+        classes derived from the above, is evolved by calling its
+        evolve() method on each path.
+
+        \ingroup mcarlo
+    */
+    class BatchPathEvolver {
+      public:
+        explicit BatchPathEvolver(
+                        const boost::shared_ptr<StochasticProcess>& process);
+        /*! \param dw     normal variates laid out as
+                          [time steps x factors x paths]
+            \param batch  the batch to be evolved; its initial values
+                          are set to those of the process.
+        */
+        void evolve(const std::vector<Real>& dw, PathBatch& batch) const;
+        const boost::shared_ptr<StochasticProcess>& process() const {
+            return process_;
+        }
+      private:
+        void evolveGeneric(const std::vector<Real>& dw,
+                           PathBatch& batch) const;
+        void evolveGeneric1D(const std::vector<Real>& dw,
+                             PathBatch& batch) const;
+        void evolveBlackScholes(const std::vector<Real>& dw,
+                                PathBatch& batch) const;
+        void evolveHeston(const std::vector<Real>& dw,
+                          PathBatch& batch) const;
+        void evolveHullWhite(const std::vector<Real>& dw,
+                             PathBatch& batch) const;
+
+        boost::shared_ptr<StochasticProcess> process_;
+        boost::shared_ptr<StochasticProcess1D> process1D_;
+        boost::shared_ptr<GeneralizedBlackScholesProcess> bsProcess_;
+        boost::shared_ptr<HestonProcess> hestonProcess_;
+        boost::shared_ptr<HullWhiteProcess> hwProcess_;
+    };
+
+}
+
+
+#endif
@@ -0,0 +1,149 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchpathgenerator.hpp
+    \brief Generates batches of random paths using a sequence generator
+*/
+
+#ifndef quantlib_montecarlo_batch_path_generator_hpp
+#define quantlib_montecarlo_batch_path_generator_hpp
+
+#include <ql/methods/montecarlo/batchpathevolver.hpp>
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace QuantLib {
+
+    //! Generates batches of random paths using a sequence generator
+    /*! Each path of the batch uses a draw of the sequence generator
+        with the same layout as in PathGenerator (for one-dimensional
+        processes) or MultiPathGenerator (for multi-dimensional ones);
+        therefore, given the same generator, the batch contains the
+        same paths that the single-path generators would return in
+        sequence.  The paths are then evolved by a BatchPathEvolver.
+
+        \ingroup mcarlo
+
+        \test the generated paths are checked against the ones
+              returned by the single-path generators.
+    */
+    template <class GSG>
+    class BatchPathGenerator {
+      public:
+        typedef PathBatch sample_type;
+        BatchPathGenerator(const boost::shared_ptr<StochasticProcess>&,
+                           const TimeGrid& timeGrid,
+                           Size batchSize,
+                           const GSG& generator,
+                           bool brownianBridge = false);
+        //! \name inspectors
+        //@{
+        const PathBatch& next() const;
+        //! antithetic paths of the last batch returned by next()
+        const PathBatch& antithetic() const;
+        Size size() const { return dimension_; }
+        Size batchSize() const { return batchSize_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+      private:
+        const PathBatch& next(bool antithetic) const;
+        bool brownianBridge_;
+        GSG generator_;
+        Size dimension_, batchSize_;
+        TimeGrid timeGrid_;
+        BatchPathEvolver evolver_;
+        mutable PathBatch next_;
+        mutable std::vector<Real> dw_, antitheticDw_, temp_;
+        BrownianBridge bb_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    BatchPathGenerator<GSG>::BatchPathGenerator(
+                          const boost::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& timeGrid,
+                          Size batchSize,
+                          const GSG& generator,
+                          bool brownianBridge)
+    : brownianBridge_(brownianBridge), generator_(generator),
+      dimension_(generator_.dimension()), batchSize_(batchSize),
+      timeGrid_(timeGrid), evolver_(process),
+      next_(process->size(), timeGrid_, batchSize),
+      dw_(dimension_*batchSize), temp_(dimension_), bb_(timeGrid_) {
+        QL_REQUIRE(dimension_ == process->factors()*(timeGrid_.size()-1),
+                   "dimension (" << dimension_
+                   << ") is not equal to ("
+                   << process->factors() << " * " << timeGrid_.size()-1
+                   << ") the number of factors "
+                   << "times the number of time steps");
+        QL_REQUIRE(!brownianBridge_ || process->factors() == 1,
+                   "Brownian bridge not supported "
+                   "for multi-factor processes");
+    }
+
+    template <class GSG>
+    inline const PathBatch& BatchPathGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const PathBatch& BatchPathGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const PathBatch& BatchPathGenerator<GSG>::next(bool antithetic) const {
+
+        if (antithetic) {
+            antitheticDw_.resize(dw_.size());
+            std::transform(dw_.begin(), dw_.end(),
+                           antitheticDw_.begin(), std::negate<Real>());
+            evolver_.evolve(antitheticDw_, next_);
+            return next_;
+        }
+
+        typedef typename GSG::sample_type sequence_type;
+        std::vector<Real>& weights = next_.weights();
+        for (Size p=0; p<batchSize_; ++p) {
+            const sequence_type& sequence = generator_.nextSequence();
+            weights[p] = sequence.weight;
+
+            if (brownianBridge_) {
+                bb_.transform(sequence.value.begin(),
+                              sequence.value.end(),
+                              temp_.begin());
+            } else {
+                std::copy(sequence.value.begin(),
+                          sequence.value.end(),
+                          temp_.begin());
+            }
+            // the k-th variate of a path goes into the k-th row
+            for (Size k=0; k<dimension_; ++k)
+                dw_[k*batchSize_ + p] = temp_[k];
+        }
+
+        evolver_.evolve(dw_, next_);
+        return next_;
+    }
+
+}
+
+
+#endif
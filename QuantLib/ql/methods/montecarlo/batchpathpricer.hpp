@@ -0,0 +1,81 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchpathpricer.hpp
+    \brief base class for pricers of batches of paths
+*/
+
+#ifndef quantlib_montecarlo_batch_path_pricer_hpp
+#define quantlib_montecarlo_batch_path_pricer_hpp
+
+#include <ql/methods/montecarlo/pathbatch.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    //! base class for batch path pricers
+    /*! Returns the values of an option on all the paths of a batch.
+        Implementations are expected to loop over the paths in the
+        innermost loop so as to take advantage of the layout of
+        PathBatch.
+
+        \ingroup mcarlo
+    */
+    template<class ValueType=Real>
+    class BatchPathPricer {
+      public:
+        virtual ~BatchPathPricer() {}
+        /*! \param values  on return, contains the value of the option
+                           on each path of the batch.
+        */
+        virtual void operator()(const PathBatch& batch,
+                                std::vector<ValueType>& values) const = 0;
+    };
+
+
+    //! adapter pricing each path of a batch with a single-path pricer
+    /*! \ingroup mcarlo */
+    template<class PathType, class ValueType=Real>
+    class PathPricerBatchAdapter : public BatchPathPricer<ValueType> {
+      public:
+        explicit PathPricerBatchAdapter(
+            const boost::shared_ptr<PathPricer<PathType,ValueType> >& pricer)
+        : pricer_(pricer) {}
+        void operator()(const PathBatch& batch,
+                        std::vector<ValueType>& values) const {
+            values.resize(batch.size());
+            PathType path = newPath(batch, (PathType*)(0));
+            for (Size i=0; i<batch.size(); ++i) {
+                batch.path(i, path);
+                values[i] = (*pricer_)(path);
+            }
+        }
+      private:
+        static Path newPath(const PathBatch& batch, Path*) {
+            return Path(batch.timeGrid());
+        }
+        static MultiPath newPath(const PathBatch& batch, MultiPath*) {
+            return MultiPath(batch.assetNumber(), batch.timeGrid());
+        }
+        boost::shared_ptr<PathPricer<PathType,ValueType> > pricer_;
+    };
+
+}
+
+
+#endif
@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/statistics/generalstatistics.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
@@ -55,6 +56,14 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        The default calibrate() method regresses on calibration
+        paths stored by operator() during the calibration phase; its
+        memory footprint is proportional to the number of paths times
+        the number of time steps.  Alternatively, calibrateByReplay()
+        regenerates the paths once per exercise time and only keeps
+        the triangular factor of the current regression, so that the
+        required memory does not depend on the number of paths.
+
         \ingroup mcarlo
 
         \test the correctness of the returned value is tested by
@@ -73,9 +82,36 @@ namespace QuantLib {
         Real operator()(const PathType& path) const;
         virtual void calibrate();
 
+        //! calibration without storing the calibration paths
+        /*! For each exercise time, going backwards, the calibration
+            paths are regenerated by a copy of the given generator and
+            valued with the exercise strategy calibrated so far; the
+            QR decomposition of the regression is updated path by
+            path by means of Givens rotations.  Paths are generated
+            in chunks which are valued in parallel when OpenMP is
+            enabled.  On return, the
+            generator is positioned after the calibration paths, as it
+            would be after drawing them for calibrate().
+
+            The price is that the paths are regenerated once per
+            exercise time.
+
+            \warning post_processing() is not called in this mode.
+        */
+        template <class PathGeneratorType>
+        void calibrateByReplay(PathGeneratorType& generator,
+                               Size samples,
+                               bool antitheticVariate = false);
+
         Real exerciseProbability() const;
 
       protected:
+        //! value at the i-th time of the cash flows after it
+        Real continuationPrice(const PathType& path, Size i) const;
+        Disposable<Array> regressionCoefficients(const Matrix& r,
+                                                 const Array& qty,
+                                                 Size n) const;
+
         virtual void post_processing(const Size i,
                                      const std::vector<StateType> &state,
                                      const std::vector<Real> &price,
@@ -221,6 +257,166 @@ namespace QuantLib {
         calibrationPhase_ = false;
     }
 
+    template <class PathType> inline
+    Real LongstaffSchwartzPathPricer<PathType>::continuationPrice(
+                                        const PathType& path, Size i) const {
+        Real price = (*pathPricer_)(path, len_-1);
+
+        for (Size k=len_-2; k>i; --k) {
+            price*=dF_[k];
+
+            const Real exercise = (*pathPricer_)(path, k);
+            if (exercise > 0.0) {
+                const StateType regValue = pathPricer_->state(path, k);
+
+                Real continuationValue = 0.0;
+                for (Size l=0; l<v_.size(); ++l) {
+                    continuationValue += coeff_[k-1][l] * v_[l](regValue);
+                }
+
+                if (continuationValue < exercise) {
+                    price = exercise;
+                }
+            }
+        }
+
+        return price*dF_[i];
+    }
+
+    template <class PathType> inline
+    Disposable<Array>
+    LongstaffSchwartzPathPricer<PathType>::regressionCoefficients(
+                                const Matrix& r, const Array& qty,
+                                Size n) const {
+        // r has the same singular values as the full design matrix;
+        // the threshold is the one used by GeneralLinearLeastSquares
+        const SVD svd(r);
+        const Matrix& V = svd.V();
+        const Matrix& U = svd.U();
+        const Array& w = svd.singularValues();
+        const Real threshold = n*QL_EPSILON;
+
+        Array coeff(qty.size(), 0.0);
+        for (Size i=0; i<w.size(); ++i) {
+            if (w[i] > threshold) {
+                const Real u = std::inner_product(U.column_begin(i),
+                                                  U.column_end(i),
+                                                  qty.begin(), 0.0)/w[i];
+                for (Size j=0; j<coeff.size(); ++j)
+                    coeff[j] += u*V[j][i];
+            }
+        }
+        return coeff;
+    }
+
+    template <class PathType>
+    template <class PathGeneratorType>
+    inline void LongstaffSchwartzPathPricer<PathType>::calibrateByReplay(
+                                                PathGeneratorType& generator,
+                                                Size samples,
+                                                bool antitheticVariate) {
+        const Size n = antitheticVariate ? 2*samples : samples;
+        const Size m = v_.size();
+        const Size chunkSize = std::min<Size>(n, 1024);
+
+        std::vector<PathType> paths;
+        paths.reserve(chunkSize);
+        std::vector<Real> y(chunkSize), basis(chunkSize*m);
+        // not std::vector<bool>, which is written to in parallel
+        std::vector<char> inTheMoney(chunkSize);
+        std::vector<std::string> errors(chunkSize);
+
+        if (len_ <= 2) {
+            // no early exercise; only skip the calibration paths
+            for (Size j=0; j<n; ++j) {
+                if (antitheticVariate && j%2 == 1)
+                    generator.antithetic();
+                else
+                    generator.next();
+            }
+        }
+
+        for (Size i=len_-2; i>0; --i) {
+            // the last pass draws the paths from the generator itself
+            PathGeneratorType replay(generator);
+            PathGeneratorType& g = (i == 1) ? generator : replay;
+
+            // triangular factor and rotated right-hand side
+            Matrix r(m, m, 0.0);
+            Array qty(m, 0.0);
+            Size nInTheMoney = 0;
+
+            for (Size j=0; j<n; j+=chunkSize) {
+                const Size size = std::min(chunkSize, n-j);
+                for (Size k=0; k<size; ++k) {
+                    const PathType& path =
+                        (antitheticVariate && (j+k)%2 == 1) ?
+                        g.antithetic().value : g.next().value;
+                    if (k < paths.size())
+                        paths[k] = path;
+                    else
+                        paths.push_back(path);
+                }
+
+                #pragma omp parallel for default(shared) schedule(dynamic)
+                for (long k=0; k<long(size); ++k) {
+                    try {
+                        const PathType& path = paths[k];
+                        inTheMoney[k] = ((*pathPricer_)(path, i) > 0.0);
+                        if (inTheMoney[k]) {
+                            y[k] = continuationPrice(path, i);
+                            const StateType x = pathPricer_->state(path, i);
+                            for (Size l=0; l<m; ++l)
+                                basis[k*m+l] = v_[l](x);
+                        }
+                    } catch (std::exception& e) {
+                        errors[k] = e.what();
+                    } catch (...) {
+                        errors[k] = "unknown error";
+                    }
+                }
+
+                // accumulate in path order to keep results independent
+                // of the number of threads
+                for (Size k=0; k<size; ++k) {
+                    QL_REQUIRE(errors[k].empty(), errors[k]);
+                    if (inTheMoney[k]) {
+                        Real* f = &basis[k*m];
+                        Real yk = y[k];
+                        for (Size l=0; l<m; ++l) {
+                            if (f[l] == 0.0)
+                                continue;
+                            const Real h = std::sqrt(r[l][l]*r[l][l]
+                                                     + f[l]*f[l]);
+                            const Real c = r[l][l]/h, s = f[l]/h;
+                            r[l][l] = h;
+                            for (Size q=l+1; q<m; ++q) {
+                                const Real t = r[l][q];
+                                r[l][q] = c*t + s*f[q];
+                                f[q] = c*f[q] - s*t;
+                            }
+                            const Real t = qty[l];
+                            qty[l] = c*t + s*yk;
+                            yk = c*yk - s*t;
+                        }
+                        ++nInTheMoney;
+                    }
+                }
+            }
+
+            if (m <= nInTheMoney) {
+                coeff_[i-1] = regressionCoefficients(r, qty, nInTheMoney);
+            }
+            else {
+                // see calibrate()
+                coeff_[i-1] = Array(m, 0.0);
+            }
+        }
+
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::exerciseProbability() const {
         return exerciseProbability_.mean();
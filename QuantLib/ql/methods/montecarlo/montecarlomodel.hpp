@@ -28,6 +28,7 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -45,6 +46,20 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        Further independent streams, i.e., path generators seeded
+        differently together with their own path pricers, can be
+        added by means of the addStream() method.  In this case, the
+        requested samples are split among the streams and (when
+        OpenMP is enabled) simulated in parallel; the results are
+        then collected in the sample accumulator in a fixed order, so
+        that they are reproducible for a given number of streams.
+
+        \warning when using several streams, the path generators
+                 and path pricers must not share any mutable state.
+                 The first sample of the first stream is drawn
+                 serially so that lazy calculations in the underlying
+                 processes are triggered before running in parallel.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -68,64 +83,142 @@ namespace QuantLib {
                   result_type cvOptionValue = result_type(),
                   const boost::shared_ptr<path_generator_type>& cvPathGenerator
                         = boost::shared_ptr<path_generator_type>())
-        : pathGenerator_(pathGenerator), pathPricer_(pathPricer),
-          sampleAccumulator_(sampleAccumulator),
+        : sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
-          cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
-            if (!cvPathPricer_)
+          cvOptionValue_(cvOptionValue) {
+            if (!cvPathPricer)
                 isControlVariate_ = false;
             else
                 isControlVariate_ = true;
+            addStream(pathGenerator, pathPricer,
+                      cvPathPricer, cvPathGenerator);
         }
+        //! adds a further independent stream of samples
+        void addStream(
+                  const boost::shared_ptr<path_generator_type>& pathGenerator,
+                  const boost::shared_ptr<path_pricer_type>& pathPricer,
+                  const boost::shared_ptr<path_pricer_type>& cvPathPricer
+                        = boost::shared_ptr<path_pricer_type>(),
+                  const boost::shared_ptr<path_generator_type>& cvPathGenerator
+                        = boost::shared_ptr<path_generator_type>());
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        Size streams() const { return streams_.size(); }
       private:
-        boost::shared_ptr<path_generator_type> pathGenerator_;
-        boost::shared_ptr<path_pricer_type> pathPricer_;
+        struct Stream {
+            boost::shared_ptr<path_generator_type> pathGenerator;
+            boost::shared_ptr<path_pricer_type> pathPricer;
+            boost::shared_ptr<path_pricer_type> cvPathPricer;
+            boost::shared_ptr<path_generator_type> cvPathGenerator;
+        };
+        std::pair<result_type,Real> nextSample(const Stream& stream) const;
+        std::vector<Stream> streams_;
         stats_type sampleAccumulator_;
         bool isAntitheticVariate_;
-        boost::shared_ptr<path_pricer_type> cvPathPricer_;
         result_type cvOptionValue_;
         bool isControlVariate_;
-        boost::shared_ptr<path_generator_type> cvPathGenerator_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
-    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
-        for(Size j = 1; j <= samples; j++) {
+    inline void MonteCarloModel<MC,RNG,S>::addStream(
+                  const boost::shared_ptr<path_generator_type>& pathGenerator,
+                  const boost::shared_ptr<path_pricer_type>& pathPricer,
+                  const boost::shared_ptr<path_pricer_type>& cvPathPricer,
+                  const boost::shared_ptr<path_generator_type>&
+                                                            cvPathGenerator) {
+        QL_REQUIRE(bool(cvPathPricer) == isControlVariate_,
+                   "control-variate path pricer "
+                   << (isControlVariate_ ? "required" : "not expected")
+                   << " for additional stream");
+        Stream stream;
+        stream.pathGenerator = pathGenerator;
+        stream.pathPricer = pathPricer;
+        stream.cvPathPricer = cvPathPricer;
+        stream.cvPathGenerator = cvPathGenerator;
+        streams_.push_back(stream);
+    }
 
-            sample_type path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+    template <template <class> class MC, class RNG, class S>
+    inline std::pair<typename MonteCarloModel<MC,RNG,S>::result_type, Real>
+    MonteCarloModel<MC,RNG,S>::nextSample(const Stream& stream) const {
+
+        sample_type path = stream.pathGenerator->next();
+        result_type price = (*stream.pathPricer)(path.value);
+
+        if (isControlVariate_) {
+            if (!stream.cvPathGenerator) {
+                price += cvOptionValue_-(*stream.cvPathPricer)(path.value);
+            }
+            else {
+                sample_type cvPath = stream.cvPathGenerator->next();
+                price += cvOptionValue_-(*stream.cvPathPricer)(cvPath.value);
+            }
+        }
 
+        if (isAntitheticVariate_) {
+            path = stream.pathGenerator->antithetic();
+            result_type price2 = (*stream.pathPricer)(path.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (!stream.cvPathGenerator)
+                    price2 += cvOptionValue_-(*stream.cvPathPricer)(path.value);
                 else {
-                    sample_type cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    sample_type cvPath = stream.cvPathGenerator->antithetic();
+                    price2 +=
+                        cvOptionValue_-(*stream.cvPathPricer)(cvPath.value);
                 }
             }
 
-            if (isAntitheticVariate_) {
-                path = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(path.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
-                    else {
-                        sample_type cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
-                }
+            return std::make_pair(result_type((price+price2)/2.0),
+                                  path.weight);
+        } else {
+            return std::make_pair(price, path.weight);
+        }
+    }
 
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
-                sampleAccumulator_.add(price, path.weight);
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        const Size n = streams_.size();
+        if (n == 1 || samples == 0) {
+            for(Size j = 1; j <= samples; j++) {
+                std::pair<result_type,Real> sample = nextSample(streams_[0]);
+                sampleAccumulator_.add(sample.first, sample.second);
             }
+            return;
         }
+
+        // split the samples among the streams in a deterministic way
+        std::vector<Size> required(n);
+        std::vector<std::vector<std::pair<result_type,Real> > > buffers(n);
+        for (Size i=0; i<n; ++i) {
+            required[i] = samples/n + (i < samples%n ? 1 : 0);
+            buffers[i].reserve(required[i]);
+        }
+
+        // see the warning in the class documentation
+        buffers[0].push_back(nextSample(streams_[0]));
+
+        std::vector<std::string> errors(n);
+        #pragma omp parallel for default(shared) schedule(static,1)
+        for (long i=0; i<long(n); ++i) {
+            try {
+                while (buffers[i].size() < required[i])
+                    buffers[i].push_back(nextSample(streams_[i]));
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "error in stream #" << i << ": " << errors[i]);
+
+        for (Size i=0; i<n; ++i)
+            for (Size j=0; j<buffers[i].size(); ++j)
+                sampleAccumulator_.add(buffers[i][j].first,
+                                       buffers[i][j].second);
     }
 
     template <template <class> class MC, class RNG, class S>
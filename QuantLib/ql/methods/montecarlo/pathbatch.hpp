@@ -0,0 +1,126 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathbatch.hpp
+    \brief Batch of paths stored in a contiguous buffer
+*/
+
+#ifndef quantlib_montecarlo_path_batch_hpp
+#define quantlib_montecarlo_path_batch_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+
+namespace QuantLib {
+
+    //! Batch of paths stored in a contiguous buffer
+    /*! The values of all paths are stored in a single buffer laid out
+        as [assets x time points x paths], i.e., the values taken by a
+        given asset at a given time on all the paths of the batch are
+        contiguous in memory.  This allows per-time-step kernels to
+        run over the paths with unit stride.
+
+        \ingroup mcarlo
+    */
+    class PathBatch {
+      public:
+        PathBatch() : assets_(0), paths_(0) {}
+        PathBatch(Size assets,
+                  const TimeGrid& timeGrid,
+                  Size paths);
+        //! \name inspectors
+        //@{
+        Size assetNumber() const { return assets_; }
+        Size pathSize() const { return timeGrid_.size(); }
+        //! number of paths in the batch
+        Size size() const { return paths_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+        //! \name read/write access to components
+        //@{
+        //! values of the given asset at the i-th time on all paths
+        const Real* values(Size asset, Size i) const;
+        Real* values(Size asset, Size i);
+        Real operator()(Size asset, Size i, Size path) const;
+        Real& operator()(Size asset, Size i, Size path);
+        //! weights of the paths
+        const std::vector<Real>& weights() const { return weights_; }
+        std::vector<Real>& weights() { return weights_; }
+        //@}
+        //! \name path extraction
+        /*! copies a single path of the batch, e.g., in order to price
+            it with a path pricer working on a single path.
+        */
+        //@{
+        void path(Size path, Path& result, Size asset = 0) const;
+        void path(Size path, MultiPath& result) const;
+        //@}
+      private:
+        Size assets_, paths_;
+        TimeGrid timeGrid_;
+        std::vector<Real> values_;
+        std::vector<Real> weights_;
+    };
+
+
+    // inline definitions
+
+    inline PathBatch::PathBatch(Size assets,
+                                const TimeGrid& timeGrid,
+                                Size paths)
+    : assets_(assets), paths_(paths), timeGrid_(timeGrid),
+      values_(assets*timeGrid.size()*paths, 0.0), weights_(paths, 1.0) {
+        QL_REQUIRE(assets > 0, "number of assets must be positive");
+        QL_REQUIRE(paths > 0, "number of paths must be positive");
+    }
+
+    inline const Real* PathBatch::values(Size asset, Size i) const {
+        return &values_[(asset*timeGrid_.size() + i)*paths_];
+    }
+
+    inline Real* PathBatch::values(Size asset, Size i) {
+        return &values_[(asset*timeGrid_.size() + i)*paths_];
+    }
+
+    inline Real PathBatch::operator()(Size asset, Size i, Size path) const {
+        return values_[(asset*timeGrid_.size() + i)*paths_ + path];
+    }
+
+    inline Real& PathBatch::operator()(Size asset, Size i, Size path) {
+        return values_[(asset*timeGrid_.size() + i)*paths_ + path];
+    }
+
+    inline void PathBatch::path(Size path, Path& result, Size asset) const {
+        QL_REQUIRE(path < paths_, "path index out of range");
+        QL_REQUIRE(asset < assets_, "asset index out of range");
+        QL_REQUIRE(result.length() == timeGrid_.size(),
+                   "wrong path length");
+        const Real* v = &values_[asset*timeGrid_.size()*paths_ + path];
+        for (Size i=0; i<result.length(); ++i, v+=paths_)
+            result[i] = *v;
+    }
+
+    inline void PathBatch::path(Size path, MultiPath& result) const {
+        QL_REQUIRE(result.assetNumber() == assets_,
+                   "wrong number of assets");
+        for (Size j=0; j<assets_; ++j)
+            this->path(path, result[j], j);
+    }
+
+}
+
+
+#endif
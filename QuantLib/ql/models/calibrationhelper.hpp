@@ -82,6 +82,14 @@ namespace QuantLib {
             engine_ = engine;
         }
 
+        const boost::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
+
+        CalibrationErrorType calibrationErrorType() const {
+            return calibrationErrorType_;
+        }
+
       protected:
         mutable Real marketValue_;
         Handle<Quote> volatility_;
@@ -30,7 +30,7 @@ namespace QuantLib {
                          const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
                          Real initialNumeraireValue)
-    : evolver_(evolver), product_(product),
+    : evolver_(evolver), simulatedPaths_(0), product_(product),
       initialNumeraireValue_(initialNumeraireValue),
       numberProducts_(product->numberOfProducts()),
       numerairesHeld_(product->numberOfProducts()),
@@ -50,6 +50,18 @@ namespace QuantLib {
 
     }
 
+    void AccountingEngine::addStream(
+                      const boost::shared_ptr<MarketModelEvolver>& evolver) {
+        QL_REQUIRE(simulatedPaths_ == 0,
+                   "cannot add streams after paths were simulated");
+        // the copy clones the product and the workspace
+        boost::shared_ptr<AccountingEngine> stream(
+                                                new AccountingEngine(*this));
+        stream->evolver_ = evolver;
+        stream->streams_.clear();
+        streams_.push_back(stream);
+    }
+
     Real AccountingEngine::singlePathValues(std::vector<Real>& values) {
         std::fill(numerairesHeld_.begin(), numerairesHeld_.end(), 0.0);
         Real weight = evolver_->startNewPath();
@@ -116,9 +128,57 @@ namespace QuantLib {
                                               Size numberOfPaths)
     {
         std::vector<Real> values(product_->numberOfProducts());
-        for (Size i=0; i<numberOfPaths; ++i) {
+        const Size n = streams_.size()+1;
+        Size i = 0;
+        // with several streams, the first path is drawn serially so
+        // that any lazy calculation is triggered before going parallel
+        for (; i<numberOfPaths && (n == 1 || simulatedPaths_ == 0); ++i) {
             Real weight = singlePathValues(values);
             stats.add(values,weight);
+            ++simulatedPaths_;
+        }
+
+        // the paths are simulated in rounds to bound memory usage
+        const Size pathsPerRound = 1024*n;
+        std::vector<std::vector<Real> > results(n), weights(n);
+        std::vector<std::string> errors(n);
+        while (i < numberOfPaths) {
+            const Size paths = std::min(numberOfPaths-i, pathsPerRound);
+            #pragma omp parallel for default(shared) schedule(static,1)
+            for (long k=0; k<long(n); ++k) {
+                AccountingEngine& engine = k == 0 ? *this : *streams_[k-1];
+                // first path of this round drawn by the k-th stream
+                const Size offset = (k+n-simulatedPaths_%n)%n;
+                results[k].clear();
+                weights[k].clear();
+                try {
+                    std::vector<Real> v(values.size());
+                    for (Size j=offset; j<paths; j+=n) {
+                        weights[k].push_back(engine.singlePathValues(v));
+                        results[k].insert(results[k].end(),
+                                          v.begin(), v.end());
+                    }
+                } catch (std::exception& e) {
+                    errors[k] = e.what();
+                } catch (...) {
+                    errors[k] = "unknown error";
+                }
+            }
+            for (Size k=0; k<n; ++k)
+                QL_REQUIRE(errors[k].empty(),
+                           "error in stream #" << k << ": " << errors[k]);
+
+            std::vector<Size> next(n, 0);
+            for (Size j=0; j<paths; ++j) {
+                const Size k = (simulatedPaths_+j)%n;
+                std::copy(results[k].begin() + next[k]*values.size(),
+                          results[k].begin() + (next[k]+1)*values.size(),
+                          values.begin());
+                stats.add(values, weights[k][next[k]]);
+                ++next[k];
+            }
+            simulatedPaths_ += paths;
+            i += paths;
         }
     }
 
@@ -41,17 +41,35 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! Further evolvers can be added by means of the addStream()
+        method, in which case each of them is given its own copy of
+        the product and the paths are simulated (when OpenMP is
+        enabled) in parallel.  The n-th path of the simulation is
+        drawn by the evolver with index n modulo the number of
+        evolvers, the one passed to the constructor having index 0;
+        the results are collected in path order.  Thus, if the
+        evolvers are built with PartitionedBrownianGeneratorFactory
+        instances dividing the same sequence (with unit block size)
+        the results are the same as those of a single evolver using
+        the whole sequence.
+
+        \warning the evolvers must not share any mutable state.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
                          Real initialNumeraireValue);
+        //! adds an evolver simulating a further stream of paths
+        void addStream(const boost::shared_ptr<MarketModelEvolver>& evolver);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
         Real singlePathValues(std::vector<Real>& values);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
+        std::vector<boost::shared_ptr<AccountingEngine> > streams_;
+        Size simulatedPaths_;
         Clone<MarketModelMultiProduct> product_;
 
         Real initialNumeraireValue_;
@@ -34,6 +34,11 @@ namespace QuantLib {
 
         virtual Real nextStep(std::vector<Real>&) = 0;
         virtual Real nextPath() = 0;
+        //! skips the given number of paths
+        /*! The default implementation draws and discards them;
+            derived classes can override it with a cheaper method.
+        */
+        virtual void skipPaths(Size n);
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
@@ -47,6 +52,14 @@ namespace QuantLib {
                                                             Size steps) const = 0;
     };
 
+
+    // inline definitions
+
+    inline void BrownianGenerator::skipPaths(Size n) {
+        for (Size i=0; i<n; ++i)
+            nextPath();
+    }
+
 }
 
 #endif
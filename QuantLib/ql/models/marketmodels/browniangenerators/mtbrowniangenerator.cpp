@@ -25,18 +25,16 @@ namespace QuantLib {
                                              Size steps,
                                              unsigned long seed)
     : factors_(factors), steps_(steps), lastStep_(0),
-      generator_(factors*steps, MersenneTwisterUniformRng(seed)) {}
+      generator_(seed), uniforms_(factors*steps) {}
 
     Real MTBrownianGenerator::nextStep(std::vector<Real>& output) {
         #if defined(QL_EXTRA_SAFETY_CHECKS)
         QL_REQUIRE(output.size() == factors_, "size mismatch");
         QL_REQUIRE(lastStep_<steps_, "uniform sequence exhausted");
         #endif
-        // no copying, just fetching a reference
-        const std::vector<Real>& currentSequence = generator_.lastSequence().value;
         Size start = lastStep_*factors_, end = (lastStep_+1)*factors_;
-        std::transform(currentSequence.begin()+start,
-                       currentSequence.begin()+end,
+        std::transform(uniforms_.begin()+start,
+                       uniforms_.begin()+end,
                        output.begin(),
                        inverseCumulative_);
         ++lastStep_;
@@ -44,12 +42,17 @@ namespace QuantLib {
     }
 
     Real MTBrownianGenerator::nextPath() {
-        typedef RandomSequenceGenerator<MersenneTwisterUniformRng>::sample_type
-            sample_type;
-
-        const sample_type& sample = generator_.nextSequence();
+        for (Size i=0; i<uniforms_.size(); ++i)
+            uniforms_[i] = generator_.nextReal();
         lastStep_ = 0;
-        return sample.weight;
+        return 1.0;
+    }
+
+    void MTBrownianGenerator::skipPaths(Size n) {
+        // the same number of draws as nextPath(), without conversion
+        const Size draws = n*uniforms_.size();
+        for (Size i=0; i<draws; ++i)
+            generator_.nextInt32();
     }
 
     Size MTBrownianGenerator::numberOfFactors() const { return factors_; }
@@ -22,7 +22,6 @@
 #define quantlib_mt_brownian_generator_hpp
 
 #include <ql/models/marketmodels/browniangenerator.hpp>
-#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 
@@ -34,11 +33,8 @@ namespace QuantLib {
 
         \note At this time, generation of the underlying uniform
               sequence is eager, while its transformation into
-              Gaussian variates is lazy.  Further optimization might
-              be possible by using the Mersenne twister directly
-              instead of a RandomSequenceGenerator; however, it is not
-              clear how much of a difference this would make when
-              compared to the inverse-cumulative Gaussian calculation.
+              Gaussian variates is lazy.  Skipped paths only advance
+              the Mersenne twister, without converting its output.
     */
     class MTBrownianGenerator : public BrownianGenerator {
       public:
@@ -48,13 +44,16 @@ namespace QuantLib {
 
         Real nextStep(std::vector<Real>&);
         Real nextPath();
+        //! skips the given number of paths without transforming them
+        void skipPaths(Size n);
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
       private:
         Size factors_, steps_;
         Size lastStep_;
-        RandomSequenceGenerator<MersenneTwisterUniformRng> generator_;
+        MersenneTwisterUniformRng generator_;
+        std::vector<Real> uniforms_;
         InverseCumulativeNormal inverseCumulative_;
     };
 
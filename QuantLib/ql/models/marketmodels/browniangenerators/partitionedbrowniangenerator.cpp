@@ -0,0 +1,90 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/browniangenerators/partitionedbrowniangenerator.hpp>
+#include <ql/errors.hpp>
+
+namespace QuantLib {
+
+    PartitionedBrownianGenerator::PartitionedBrownianGenerator(
+                        const boost::shared_ptr<BrownianGenerator>& generator,
+                        Size stream,
+                        Size numberOfStreams,
+                        Size blockSize)
+    : generator_(generator), stream_(stream),
+      numberOfStreams_(numberOfStreams), blockSize_(blockSize),
+      drawnPaths_(0), underlyingPaths_(0) {
+        QL_REQUIRE(generator_, "null Brownian generator");
+        QL_REQUIRE(numberOfStreams_ > 0, "at least one stream required");
+        QL_REQUIRE(stream_ < numberOfStreams_,
+                   "stream #" << stream_ << " not available "
+                   "(" << numberOfStreams_ << " streams)");
+        QL_REQUIRE(blockSize_ > 0, "null block size");
+    }
+
+    Real PartitionedBrownianGenerator::nextStep(std::vector<Real>& output) {
+        return generator_->nextStep(output);
+    }
+
+    Real PartitionedBrownianGenerator::nextPath() {
+        // index of the next path of this stream among those of
+        // the underlying generator
+        Size block = drawnPaths_ / blockSize_;
+        Size next = (block*numberOfStreams_ + stream_)*blockSize_
+                  + drawnPaths_ % blockSize_;
+        generator_->skipPaths(next - underlyingPaths_);
+        underlyingPaths_ = next+1;
+        ++drawnPaths_;
+        return generator_->nextPath();
+    }
+
+    void PartitionedBrownianGenerator::skipPaths(Size n) {
+        // the underlying generator catches up at the next path
+        drawnPaths_ += n;
+    }
+
+    Size PartitionedBrownianGenerator::numberOfFactors() const {
+        return generator_->numberOfFactors();
+    }
+
+    Size PartitionedBrownianGenerator::numberOfSteps() const {
+        return generator_->numberOfSteps();
+    }
+
+
+    PartitionedBrownianGeneratorFactory::PartitionedBrownianGeneratorFactory(
+                  const boost::shared_ptr<BrownianGeneratorFactory>& factory,
+                  Size stream,
+                  Size numberOfStreams,
+                  Size blockSize)
+    : factory_(factory), stream_(stream),
+      numberOfStreams_(numberOfStreams), blockSize_(blockSize) {
+        QL_REQUIRE(factory_, "null Brownian-generator factory");
+    }
+
+    boost::shared_ptr<BrownianGenerator>
+    PartitionedBrownianGeneratorFactory::create(Size factors,
+                                                Size steps) const {
+        return boost::shared_ptr<BrownianGenerator>(
+                    new PartitionedBrownianGenerator(
+                                          factory_->create(factors, steps),
+                                          stream_, numberOfStreams_,
+                                          blockSize_));
+    }
+
+}
+
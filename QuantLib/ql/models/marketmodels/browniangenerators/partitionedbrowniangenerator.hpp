@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file partitionedbrowniangenerator.hpp
+    \brief Brownian generator drawing a subset of another's paths
+*/
+
+#ifndef quantlib_partitioned_brownian_generator_hpp
+#define quantlib_partitioned_brownian_generator_hpp
+
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    //! Brownian generator drawing one of several disjoint path streams
+    /*! The paths of the underlying generator are divided into blocks
+        of the given size, which are dealt out in turn to the streams;
+        this generator returns the paths in the blocks assigned to the
+        given stream and skips the others.  Together, the streams
+        draw exactly the paths of the underlying generator, so that
+        simulations divided among them (e.g., among threads) can
+        reproduce the results of a single one.
+    */
+    class PartitionedBrownianGenerator : public BrownianGenerator {
+      public:
+        PartitionedBrownianGenerator(
+                        const boost::shared_ptr<BrownianGenerator>& generator,
+                        Size stream,
+                        Size numberOfStreams,
+                        Size blockSize = 1);
+
+        Real nextStep(std::vector<Real>&);
+        Real nextPath();
+        void skipPaths(Size n);
+
+        Size numberOfFactors() const;
+        Size numberOfSteps() const;
+      private:
+        boost::shared_ptr<BrownianGenerator> generator_;
+        Size stream_, numberOfStreams_, blockSize_;
+        // paths drawn by this stream and by the underlying generator
+        Size drawnPaths_, underlyingPaths_;
+    };
+
+    class PartitionedBrownianGeneratorFactory
+        : public BrownianGeneratorFactory {
+      public:
+        PartitionedBrownianGeneratorFactory(
+                  const boost::shared_ptr<BrownianGeneratorFactory>& factory,
+                  Size stream,
+                  Size numberOfStreams,
+                  Size blockSize = 1);
+        boost::shared_ptr<BrownianGenerator> create(Size factors,
+                                                    Size steps) const;
+      private:
+        boost::shared_ptr<BrownianGeneratorFactory> factory_;
+        Size stream_, numberOfStreams_, blockSize_;
+    };
+
+}
+
+
+#endif
@@ -19,6 +19,7 @@
 
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <boost/iterator/permutation_iterator.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -114,10 +115,10 @@ namespace QuantLib {
                                         unsigned long seed,
                                         SobolRsg::DirectionIntegers integers)
     : factors_(factors), steps_(steps), ordering_(ordering),
-      generator_(SobolRsg(factors*steps, seed, integers),
-                 InverseCumulativeNormal()),
-      bridge_(steps), lastStep_(0),
+      generator_(factors*steps, seed, integers),
+      bridge_(steps), lastStep_(0), pathsDrawn_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
+      variates_(factors*steps),
       bridgedVariates_(factors, std::vector<Real>(steps)) {
 
         switch (ordering_) {
@@ -137,24 +138,35 @@ namespace QuantLib {
 
 
     Real SobolBrownianGenerator::nextPath() {
-        typedef InverseCumulativeRsg<SobolRsg,
-                                     InverseCumulativeNormal>::sample_type
-            sample_type;
-
-        const sample_type& sample = generator_.nextSequence();
+        const SobolRsg::sample_type& sample = generator_.nextSequence();
+        std::transform(sample.value.begin(), sample.value.end(),
+                       variates_.begin(), inverseCumulative_);
         // Brownian-bridge the variates according to the ordered indices
         for (Size i=0; i<factors_; ++i) {
             bridge_.transform(boost::make_permutation_iterator(
-                                                  sample.value.begin(),
+                                                  variates_.begin(),
                                                   orderedIndices_[i].begin()),
                               boost::make_permutation_iterator(
-                                                  sample.value.begin(),
+                                                  variates_.begin(),
                                                   orderedIndices_[i].end()),
                               bridgedVariates_[i].begin());
         }
         lastStep_ = 0;
+        ++pathsDrawn_;
         return sample.weight;
     }
+
+    void SobolBrownianGenerator::skipPaths(Size n) {
+        if (n == 0)
+            return;
+        // skipTo(m) sets the generator as if m+1 samples had been
+        // drawn, unless the precomputed first sample is still to be
+        // returned; in that case, the latter is consumed first
+        if (pathsDrawn_ == 0)
+            generator_.nextInt32Sequence();
+        pathsDrawn_ += n;
+        generator_.skipTo(pathsDrawn_-1);
+    }
     
     
     const std::vector<std::vector<Size> >& 
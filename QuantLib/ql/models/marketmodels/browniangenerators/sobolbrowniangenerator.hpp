@@ -22,7 +22,6 @@
 #define quantlib_sobol_brownian_generator_hpp
 
 #include <ql/models/marketmodels/browniangenerator.hpp>
-#include <ql/math/randomnumbers/inversecumulativersg.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/methods/montecarlo/brownianbridge.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
@@ -56,6 +55,8 @@ namespace QuantLib {
 
         Real nextPath();
         Real nextStep(std::vector<Real>&);
+        //! skips the given number of paths without transforming them
+        void skipPaths(Size n);
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
@@ -68,11 +69,14 @@ namespace QuantLib {
       private:
         Size factors_, steps_;
         Ordering ordering_;
-        InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator_;
+        SobolRsg generator_;
+        InverseCumulativeNormal inverseCumulative_;
         BrownianBridge bridge_;
         // work variables
         Size lastStep_;
+        unsigned long pathsDrawn_;
         std::vector<std::vector<Size> > orderedIndices_;
+        std::vector<Real> variates_;
         std::vector<std::vector<Real> > bridgedVariates_;
     };
 
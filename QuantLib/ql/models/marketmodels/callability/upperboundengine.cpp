@@ -117,7 +117,7 @@ namespace QuantLib {
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
                    Real initialNumeraireValue)
-    : evolver_(evolver), innerEvolvers_(innerEvolvers),
+    : evolver_(evolver), innerEvolvers_(innerEvolvers), simulatedPaths_(0),
       composite_(MultiProductComposite()),
       initialNumeraireValue_(initialNumeraireValue) {
 
@@ -167,12 +167,70 @@ namespace QuantLib {
     }
 
 
+    void UpperBoundEngine::addStream(
+                   const boost::shared_ptr<MarketModelEvolver>& evolver,
+                   const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                               innerEvolvers) {
+        QL_REQUIRE(simulatedPaths_ == 0,
+                   "cannot add streams after paths were simulated");
+        QL_REQUIRE(innerEvolvers.size() == innerEvolvers_.size(),
+                   innerEvolvers.size() << " inner evolvers given, "
+                   << innerEvolvers_.size() << " required");
+        // the copy clones the products and the workspace
+        boost::shared_ptr<UpperBoundEngine> stream(
+                                                new UpperBoundEngine(*this));
+        stream->evolver_ = evolver;
+        stream->innerEvolvers_ = innerEvolvers;
+        stream->streams_.clear();
+        streams_.push_back(stream);
+    }
+
+
     void UpperBoundEngine::multiplePathValues(Statistics& stats,
                                               Size outerPaths,
                                               Size innerPaths) {
-        for (Size i=0; i<outerPaths; ++i) {
+        const Size n = streams_.size()+1;
+        Size i = 0;
+        // see AccountingEngine::multiplePathValues
+        for (; i<outerPaths && (n == 1 || simulatedPaths_ == 0); ++i) {
             std::pair<Real,Real> result = singlePathValue(innerPaths);
             stats.add(result.first, result.second);
+            ++simulatedPaths_;
+        }
+
+        // outer paths are expensive; smaller rounds balance the load
+        const Size pathsPerRound = 16*n;
+        std::vector<std::vector<std::pair<Real,Real> > > results(n);
+        std::vector<std::string> errors(n);
+        while (i < outerPaths) {
+            const Size paths = std::min(outerPaths-i, pathsPerRound);
+            #pragma omp parallel for default(shared) schedule(static,1)
+            for (long k=0; k<long(n); ++k) {
+                UpperBoundEngine& engine = k == 0 ? *this : *streams_[k-1];
+                const Size offset = (k+n-simulatedPaths_%n)%n;
+                results[k].clear();
+                try {
+                    for (Size j=offset; j<paths; j+=n)
+                        results[k].push_back(
+                                          engine.singlePathValue(innerPaths));
+                } catch (std::exception& e) {
+                    errors[k] = e.what();
+                } catch (...) {
+                    errors[k] = "unknown error";
+                }
+            }
+            for (Size k=0; k<n; ++k)
+                QL_REQUIRE(errors[k].empty(),
+                           "error in stream #" << k << ": " << errors[k]);
+
+            std::vector<Size> next(n, 0);
+            for (Size j=0; j<paths; ++j) {
+                const Size k = (simulatedPaths_+j)%n;
+                const std::pair<Real,Real>& result = results[k][next[k]++];
+                stats.add(result.first, result.second);
+            }
+            simulatedPaths_ += paths;
+            i += paths;
         }
     }
 
@@ -37,7 +37,15 @@ namespace QuantLib {
     class MarketModelExerciseValue;
 
     //! Market-model %engine for upper-bound estimation
-    /*! \pre product and hedge must have the same rate times
+    /*! Further outer and inner evolvers can be added by means of
+        the addStream() method; the outer paths are then divided
+        among the streams and simulated in parallel as described
+        for AccountingEngine.  To reproduce the results of a single
+        stream, the inner evolvers of the streams should divide the
+        inner sequence in blocks of as many paths as the inner paths
+        per outer path.
+
+        \pre product and hedge must have the same rate times
              and exercise times
     */
     class UpperBoundEngine {
@@ -52,6 +60,11 @@ namespace QuantLib {
                    const MarketModelExerciseValue& hedgeRebate,
                    const ExerciseStrategy<CurveState>& hedgeStrategy,
                    Real initialNumeraireValue);
+        //! adds evolvers simulating a further stream of paths
+        void addStream(
+                   const boost::shared_ptr<MarketModelEvolver>& evolver,
+                   const std::vector<boost::shared_ptr<MarketModelEvolver> >&
+                                                                innerEvolvers);
         void multiplePathValues(Statistics& stats,
                                 Size outerPaths,
                                 Size innerPaths);
@@ -64,6 +77,8 @@ namespace QuantLib {
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
         std::vector<boost::shared_ptr<MarketModelEvolver> > innerEvolvers_;
+        std::vector<boost::shared_ptr<UpperBoundEngine> > streams_;
+        Size simulatedPaths_;
         MultiProductComposite composite_;
 
         Real initialNumeraireValue_;
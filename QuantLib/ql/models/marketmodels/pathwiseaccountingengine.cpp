@@ -31,7 +31,7 @@ namespace QuantLib {
         const Clone<MarketModelPathwiseMultiProduct>& product,
         const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
         Real initialNumeraireValue)
-        : evolver_(evolver), product_(product),pseudoRootStructure_(pseudoRootStructure),
+        : evolver_(evolver), simulatedPaths_(0), product_(product),pseudoRootStructure_(pseudoRootStructure),
         initialNumeraireValue_(initialNumeraireValue),
         numberProducts_(product->numberOfProducts()),
         doDeflation_(!product->alreadyDeflated()),
@@ -117,6 +117,18 @@ namespace QuantLib {
         partials_ = Matrix(pseudoRootStructure_->numberOfFactors(),numberRates_);
     }
 
+    void PathwiseAccountingEngine::addStream(const boost::shared_ptr<LogNormalFwdRateEuler>& evolver)
+    {
+        QL_REQUIRE(simulatedPaths_ == 0,
+                   "cannot add streams after paths were simulated");
+        // the copy clones the product and the workspace
+        boost::shared_ptr<PathwiseAccountingEngine> stream(
+                                        new PathwiseAccountingEngine(*this));
+        stream->evolver_ = evolver;
+        stream->streams_.clear();
+        streams_.push_back(stream);
+    }
+
     Real PathwiseAccountingEngine::singlePathValues(std::vector<Real>& values)
     {
 
@@ -313,10 +325,63 @@ namespace QuantLib {
         Size numberOfPaths)
     {
         std::vector<Real> values(product_->numberOfProducts()*(numberRates_+1));
-        for (Size i=0; i<numberOfPaths; ++i)
+        const Size n = streams_.size()+1;
+        Size i = 0;
+        // see AccountingEngine::multiplePathValues
+        for (; i<numberOfPaths && (n == 1 || simulatedPaths_ == 0); ++i)
         {
             Real weight = singlePathValues(values);
             stats.add(values,weight);
+            ++simulatedPaths_;
+        }
+
+        const Size pathsPerRound = 1024*n;
+        std::vector<std::vector<Real> > results(n), weights(n);
+        std::vector<std::string> errors(n);
+        while (i < numberOfPaths)
+        {
+            const Size paths = std::min(numberOfPaths-i, pathsPerRound);
+            #pragma omp parallel for default(shared) schedule(static,1)
+            for (long k=0; k<long(n); ++k)
+            {
+                PathwiseAccountingEngine& engine = k == 0 ? *this : *streams_[k-1];
+                const Size offset = (k+n-simulatedPaths_%n)%n;
+                results[k].clear();
+                weights[k].clear();
+                try
+                {
+                    std::vector<Real> v(values.size());
+                    for (Size j=offset; j<paths; j+=n)
+                    {
+                        weights[k].push_back(engine.singlePathValues(v));
+                        results[k].insert(results[k].end(), v.begin(), v.end());
+                    }
+                }
+                catch (std::exception& e)
+                {
+                    errors[k] = e.what();
+                }
+                catch (...)
+                {
+                    errors[k] = "unknown error";
+                }
+            }
+            for (Size k=0; k<n; ++k)
+                QL_REQUIRE(errors[k].empty(),
+                           "error in stream #" << k << ": " << errors[k]);
+
+            std::vector<Size> next(n, 0);
+            for (Size j=0; j<paths; ++j)
+            {
+                const Size k = (simulatedPaths_+j)%n;
+                std::copy(results[k].begin() + next[k]*values.size(),
+                          results[k].begin() + (next[k]+1)*values.size(),
+                          values.begin());
+                stats.add(values, weights[k][next[k]]);
+                ++next[k];
+            }
+            simulatedPaths_ += paths;
+            i += paths;
         }
     }
 
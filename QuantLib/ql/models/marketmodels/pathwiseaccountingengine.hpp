@@ -41,6 +41,8 @@ namespace QuantLib {
     // using Giles--Glasserman smoking adjoints method
     // note only works with displaced LMM, and requires knowledge of pseudo-roots and displacements 
     // This is tested in MarketModelTest::testPathwiseGreeks
+    // Further evolvers can be added with addStream(), in which case paths are
+    // simulated in parallel as in AccountingEngine
     class PathwiseAccountingEngine 
     {
       public:
@@ -49,12 +51,16 @@ namespace QuantLib {
                          const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
                          Real initialNumeraireValue);
 
+        void addStream(const boost::shared_ptr<LogNormalFwdRateEuler>& evolver);
+
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
           Real singlePathValues(std::vector<Real>& values);
 
         boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
+        std::vector<boost::shared_ptr<PathwiseAccountingEngine> > streams_;
+        Size simulatedPaths_;
         Clone<MarketModelPathwiseMultiProduct> product_;
         boost::shared_ptr<MarketModel> pseudoRootStructure_;
 
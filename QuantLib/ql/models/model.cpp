@@ -22,6 +22,7 @@
 #include <ql/math/optimization/problem.hpp>
 #include <ql/math/optimization/projection.hpp>
 #include <ql/math/optimization/projectedconstraint.hpp>
+#include <map>
 
 using std::vector;
 using boost::shared_ptr;
@@ -44,26 +45,50 @@ namespace QuantLib {
                             const vector<Real>& weights,
                             const Projection& projection)
         : model_(model, no_deletion), instruments_(h),
-          weights_(weights), projection_(projection) { }
+          weights_(weights), projection_(projection), parallel_(true) {
+            // helpers sharing an engine must be repriced by one thread
+            std::map<PricingEngine*, Size> groupOfEngine;
+            for (Size i=0; i<instruments_.size(); ++i) {
+                // implied-volatility errors call blackPrice(), which
+                // sets Black engines on the helper and registers them
+                // with the shared term structure; not thread-safe
+                if (instruments_[i]->calibrationErrorType() ==
+                    CalibrationHelper::ImpliedVolError)
+                    parallel_ = false;
+                PricingEngine* engine =
+                    instruments_[i]->pricingEngine().get();
+                if (engine == 0) {
+                    groups_.push_back(vector<Size>(1, i));
+                    continue;
+                }
+                std::map<PricingEngine*, Size>::const_iterator g =
+                    groupOfEngine.find(engine);
+                if (g == groupOfEngine.end()) {
+                    groupOfEngine[engine] = groups_.size();
+                    groups_.push_back(vector<Size>(1, i));
+                } else {
+                    groups_[g->second].push_back(i);
+                }
+            }
+        }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
-            model_->setParams(projection_.include(params));
+            const Array& errors = calibrationErrors(params);
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
             return std::sqrt(value);
         }
 
         virtual Disposable<Array> values(const Array& params) const {
-            model_->setParams(projection_.include(params));
+            const Array& errors = calibrationErrors(params);
             Array values(instruments_.size());
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] = errors[i]*std::sqrt(weights_[i]);
             }
             return values;
         }
@@ -71,10 +96,51 @@ namespace QuantLib {
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        /* The errors of the last evaluation are kept, since the
+           optimizers often ask for value() and values() at the same
+           point; the model parameters are set in any case. */
+        const Array& calibrationErrors(const Array& params) const {
+            Array x = projection_.include(params);
+            model_->setParams(x);
+            if (!lastErrors_.empty() && x == lastParams_)
+                return lastErrors_;
+
+            // market values are calculated lazily; make sure this
+            // doesn't happen concurrently
+            for (Size i=0; i<instruments_.size(); ++i)
+                instruments_[i]->marketValue();
+
+            Array errors(instruments_.size());
+            std::vector<std::string> failures(instruments_.size());
+            #pragma omp parallel for default(shared) schedule(dynamic) \
+                                     if(parallel_ && groups_.size() > 1)
+            for (long k=0; k<long(groups_.size()); ++k) {
+                for (Size j=0; j<groups_[k].size(); ++j) {
+                    const Size i = groups_[k][j];
+                    try {
+                        errors[i] = instruments_[i]->calibrationError();
+                    } catch (std::exception& e) {
+                        failures[i] = e.what();
+                    } catch (...) {
+                        failures[i] = "unknown error";
+                    }
+                }
+            }
+            for (Size i=0; i<failures.size(); ++i)
+                QL_REQUIRE(failures[i].empty(), failures[i]);
+
+            lastParams_ = x;
+            lastErrors_ = errors;
+            return lastErrors_;
+        }
+
         shared_ptr<CalibratedModel> model_;
         const vector<shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        vector<vector<Size> > groups_;
+        bool parallel_;
+        mutable Array lastParams_, lastErrors_;
     };
 
     void CalibratedModel::calibrate(
@@ -149,6 +215,51 @@ namespace QuantLib {
     }
 
     ShortRateModel::ShortRateModel(Size nArguments)
-    : CalibratedModel(nArguments) {}
+    : CalibratedModel(nArguments), treesGeneration_(0) {}
+
+    void ShortRateModel::update() {
+        clearTreeCache();
+        CalibratedModel::update();
+    }
+
+    void ShortRateModel::setParams(const Array& params) {
+        clearTreeCache();
+        CalibratedModel::setParams(params);
+    }
+
+    shared_ptr<Lattice>
+    ShortRateModel::cachedTree(const TimeGrid& grid) const {
+        const vector<Time> key(grid.begin(), grid.end());
+        Size generation;
+        {
+            detail::CacheMutex::scoped_lock lock(treesMutex_);
+            std::map<vector<Time>, shared_ptr<Lattice> >::const_iterator i =
+                trees_.find(key);
+            if (i != trees_.end())
+                return i->second;
+            generation = treesGeneration_;
+        }
+
+        // the tree is built outside the lock, since building it might
+        // notify the model and clear the cache
+        shared_ptr<Lattice> tree = this->tree(grid);
+
+        detail::CacheMutex::scoped_lock lock(treesMutex_);
+        // don't store trees built before the cache was cleared; if
+        // another thread stored a tree in the meantime, share it
+        if (generation == treesGeneration_) {
+            std::pair<std::map<vector<Time>, shared_ptr<Lattice> >::iterator,
+                      bool> inserted =
+                trees_.insert(std::make_pair(key, tree));
+            tree = inserted.first->second;
+        }
+        return tree;
+    }
+
+    void ShortRateModel::clearTreeCache() const {
+        detail::CacheMutex::scoped_lock lock(treesMutex_);
+        trees_.clear();
+        ++treesGeneration_;
+    }
 
 }
@@ -31,6 +31,8 @@
 #include <ql/models/parameter.hpp>
 #include <ql/models/calibrationhelper.hpp>
 #include <ql/math/optimization/endcriteria.hpp>
+#include <ql/utilities/cachemutex.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -95,6 +97,28 @@ namespace QuantLib {
         //! Calibrate to a set of market instruments (usually caps/swaptions)
         /*! An additional constraint can be passed which must be
             satisfied in addition to the constraints of the model.
+
+            If OpenMP is enabled, helpers with different pricing
+            engines are repriced in parallel at each evaluation of
+            the cost function, while helpers sharing an engine are
+            repriced sequentially by the same thread; to calibrate
+            in parallel, give each helper (or group of helpers) its
+            own engine instance.  The engines are kept across
+            iterations, so that any state they cache is reused.
+            Helpers are always repriced sequentially if any of them
+            uses CalibrationHelper::ImpliedVolError, since the Black
+            prices needed to imply the volatility are obtained by
+            setting new engines on the helper and registering them
+            with the shared term structure.
+
+            \warning the helpers are repriced concurrently, so nothing
+                     they use while pricing (engines, term structures,
+                     quotes or any other Observable) may be modified
+                     or registered with from more than one thread.
+                     Unless QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN is
+                     defined, this excludes engines that register
+                     observers with shared objects while pricing;
+                     such engines must be shared by all helpers.
         */
         virtual void calibrate(
                 const std::vector<boost::shared_ptr<CalibrationHelper> >&,
@@ -136,7 +160,32 @@ namespace QuantLib {
     class ShortRateModel : public CalibratedModel {
       public:
         ShortRateModel(Size nArguments);
+        void update();
+        void setParams(const Array& params);
         virtual boost::shared_ptr<Lattice> tree(const TimeGrid&) const = 0;
+        //! returns a tree for the given grid, building it only once
+        /*! The trees built by this method are kept by the model
+            and returned again when a grid with the same points is
+            passed; engines constructed with a common time grid will
+            thus share the same tree.  Engines constructed with a
+            number of time steps build their grid from the mandatory
+            times of each instrument and call tree() instead, so
+            that the cache doesn't grow with the number of priced
+            instruments.  The cached trees are discarded when the
+            model parameters are set or the model is notified of a
+            change.
+
+            \warning the returned tree is shared; it must not be
+                     modified.
+        */
+        boost::shared_ptr<Lattice> cachedTree(const TimeGrid&) const;
+        //! discards the trees returned by cachedTree()
+        void clearTreeCache() const;
+      private:
+        mutable std::map<std::vector<Time>,
+                         boost::shared_ptr<Lattice> > trees_;
+        mutable Size treesGeneration_;
+        mutable detail::CacheMutex treesMutex_;
     };
 
 
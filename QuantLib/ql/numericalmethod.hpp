@@ -27,6 +27,7 @@
 
 #include <ql/timegrid.hpp>
 #include <ql/math/array.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -83,6 +84,21 @@ namespace QuantLib {
         virtual void partialRollback(DiscretizedAsset&,
                                      Time to) const = 0;
 
+        /*! Roll back several assets, all set at the same time, until
+            the given time, performing any needed adjustment.  The
+            default implementation rolls them back one at a time;
+            numerical methods can override it so as to process all
+            of them in a single pass.
+        */
+        virtual void rollback(const std::vector<DiscretizedAsset*>&,
+                              Time to) const;
+
+        /*! Roll back several assets, all set at the same time, until
+            the given time, but do not perform the final adjustment.
+        */
+        virtual void partialRollback(const std::vector<DiscretizedAsset*>&,
+                                     Time to) const;
+
         //! computes the present value of an asset.
         virtual Real presentValue(DiscretizedAsset&) const = 0;
 
@@ -94,6 +110,23 @@ namespace QuantLib {
         TimeGrid t_;
     };
 
+
+    // inline definitions
+
+    inline void Lattice::rollback(
+                               const std::vector<DiscretizedAsset*>& assets,
+                               Time to) const {
+        for (Size i=0; i<assets.size(); ++i)
+            rollback(*assets[i], to);
+    }
+
+    inline void Lattice::partialRollback(
+                               const std::vector<DiscretizedAsset*>& assets,
+                               Time to) const {
+        for (Size i=0; i<assets.size(); ++i)
+            partialRollback(*assets[i], to);
+    }
+
 }
 
 
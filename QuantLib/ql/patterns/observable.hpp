@@ -28,17 +28,62 @@
 
 #include <ql/errors.hpp>
 #include <ql/types.hpp>
+#include <ql/patterns/singleton.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/locks.hpp>
+#endif
 
+#include <algorithm>
 #include <set>
+#include <vector>
 
 namespace QuantLib {
 
     class Observer;
 
+    namespace detail {
+
+        /* Locks the whole observer graph for the duration of its
+           scope when the thread-safe observer pattern is enabled;
+           it does nothing otherwise.  A single recursive mutex is
+           used, so that notifications cascading through observers
+           cannot deadlock. */
+        class ObserverLock : private boost::noncopyable {
+          public:
+            #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+            ObserverLock() : lock_(mutex()) {}
+          private:
+            static boost::recursive_mutex& mutex() {
+                static boost::recursive_mutex m;
+                return m;
+            }
+            boost::lock_guard<boost::recursive_mutex> lock_;
+            #else
+            ObserverLock() {}
+            #endif
+        };
+
+    }
+
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! When QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN is defined,
+        registration, unregistration and notification can be
+        performed concurrently from different threads; this allows,
+        e.g., to create and destroy instruments on several pricing
+        threads while they observe the same market objects.
+
+        \warning even in this case, lazy objects are not thread-safe;
+                 shared market objects should be calculated before
+                 being used concurrently, and should not be modified
+                 while observers registered with them are being
+                 destroyed on other threads.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
       public:
@@ -52,18 +97,76 @@ namespace QuantLib {
         */
         void notifyObservers();
       private:
-        typedef std::set<Observer*>::iterator iterator;
-        std::pair<iterator, bool> registerObserver(Observer*);
+        // observers are kept in a sorted vector; registration is
+        // rarer than notification, which can then walk contiguous
+        // memory.
+        typedef std::vector<Observer*> observer_list;
+        typedef observer_list::iterator iterator;
+        bool registerObserver(Observer*);
         Size unregisterObserver(Observer*);
-        std::set<Observer*> observers_;
+        observer_list observers_;
+    };
+
+    //! global settings for the observer/observable mechanism
+    /*! Notifications can be temporarily disabled, e.g., while a
+        number of market quotes are being set as part of the same
+        market update.  If they are disabled with the \c deferred
+        flag set, observers notified in the meantime are collected
+        (each one only once) and they receive a single update() call
+        when notifications are enabled again.  Notifications sent
+        while the collected observers are being updated are
+        collected in the same way, so that each observer in the
+        dependency graph is updated at most once for the whole
+        transaction; therefore, update() methods should only flag
+        their observers as outdated, as suggested in the Observable
+        documentation.
+
+        When sessions are enabled, each session has its own settings;
+        a transaction should be committed by the same session (e.g.,
+        thread) that started it.
+
+        \code
+        ObservableSettings::instance().disableUpdates(true);
+        for (Size i=0; i<quotes.size(); ++i)
+            quotes[i]->setValue(values[i]);
+        ObservableSettings::instance().enableUpdates();
+        \endcode
+
+        \ingroup patterns
+    */
+    class ObservableSettings : public Singleton<ObservableSettings> {
+        friend class Singleton<ObservableSettings>;
+        friend class Observable;
+        friend class Observer;
+      public:
+        //! disable notifications, optionally collecting them for later
+        void disableUpdates(bool deferred = false);
+        /*! enable notifications and send the collected ones, if
+            any, to their observers.
+        */
+        void enableUpdates();
+        bool updatesEnabled() const { return updatesEnabled_; }
+        bool updatesDeferred() const { return updatesDeferred_; }
+      private:
+        ObservableSettings()
+        : updatesEnabled_(true), updatesDeferred_(false),
+          flushing_(false) {}
+        bool collecting() const {
+            return (!updatesEnabled_ && updatesDeferred_) || flushing_;
+        }
+        void registerDeferredObservers(const std::vector<Observer*>&);
+        void unregisterDeferredObserver(Observer*);
+        std::set<Observer*> deferredObservers_, updatedObservers_;
+        bool updatesEnabled_, updatesDeferred_, flushing_;
     };
 
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
     class Observer {
+        friend class ObservableSettings;
       public:
         // constructors, assignment, destructor
-        Observer() {}
+        Observer() : deferred_(false) {}
         Observer(const Observer&);
         Observer& operator=(const Observer&);
         virtual ~Observer();
@@ -85,6 +188,8 @@ namespace QuantLib {
       private:
         std::set<boost::shared_ptr<Observable> > observables_;
         typedef std::set<boost::shared_ptr<Observable> >::iterator iterator;
+        // whether ObservableSettings is holding a pointer to this
+        bool deferred_;
     };
 
 
@@ -111,21 +216,42 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<std::set<Observer*>::iterator, bool>
-    Observable::registerObserver(Observer* o) {
-        return observers_.insert(o);
+    inline bool Observable::registerObserver(Observer* o) {
+        detail::ObserverLock lock;
+        iterator i = std::lower_bound(observers_.begin(), observers_.end(), o);
+        if (i != observers_.end() && *i == o)
+            return false;
+        observers_.insert(i, o);
+        return true;
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
-        return observers_.erase(o);
+        detail::ObserverLock lock;
+        iterator i = std::lower_bound(observers_.begin(), observers_.end(), o);
+        if (i == observers_.end() || *i != o)
+            return 0;
+        observers_.erase(i);
+        return 1;
     }
 
     inline void Observable::notifyObservers() {
+        detail::ObserverLock lock;
+        if (observers_.empty())
+            return;
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (!settings.updatesEnabled() || settings.flushing_) {
+            if (settings.collecting())
+                settings.registerDeferredObservers(observers_);
+            return;
+        }
+
         bool successful = true;
         std::string errMsg;
-        for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+        Size i = 0;
+        while (i < observers_.size()) {
+            Observer* o = observers_[i];
             try {
-                (*i)->update();
+                o->update();
             } catch (std::exception& e) {
                 // quite a dilemma. If we don't catch the exception,
                 // other observers will not receive the notification
@@ -139,6 +265,14 @@ namespace QuantLib {
             } catch (...) {
                 successful = false;
             }
+            if (i < observers_.size() && observers_[i] == o) {
+                ++i;
+            } else {
+                // the update modified the list of observers;
+                // resume from the first one after o
+                i = std::upper_bound(observers_.begin(), observers_.end(),
+                                     o) - observers_.begin();
+            }
         }
         QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
@@ -146,12 +280,15 @@ namespace QuantLib {
 
 
     inline Observer::Observer(const Observer& o)
-    : observables_(o.observables_) {
+    : deferred_(false) {
+        detail::ObserverLock lock;
+        observables_ = o.observables_;
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->registerObserver(this);
     }
 
     inline Observer& Observer::operator=(const Observer& o) {
+        detail::ObserverLock lock;
         iterator i;
         for (i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->unregisterObserver(this);
@@ -162,12 +299,16 @@ namespace QuantLib {
     }
 
     inline Observer::~Observer() {
+        detail::ObserverLock lock;
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->unregisterObserver(this);
+        if (deferred_)
+            ObservableSettings::instance().unregisterDeferredObserver(this);
     }
 
     inline std::pair<std::set<boost::shared_ptr<Observable> >::iterator, bool>
     Observer::registerWith(const boost::shared_ptr<Observable>& h) {
+        detail::ObserverLock lock;
         if (h) {
             h->registerObserver(this);
             return observables_.insert(h);
@@ -177,6 +318,7 @@ namespace QuantLib {
 
     inline void
     Observer::registerWithObservables(const boost::shared_ptr<Observer> &o) {
+        detail::ObserverLock lock;
         if (o) {
             iterator i;
             for (i = o->observables_.begin(); i != o->observables_.end(); ++i)
@@ -186,17 +328,80 @@ namespace QuantLib {
 
     inline
     Size Observer::unregisterWith(const boost::shared_ptr<Observable>& h) {
+        detail::ObserverLock lock;
         if (h)
             h->unregisterObserver(this);
         return observables_.erase(h);
     }
 
     inline void Observer::unregisterWithAll() {
+        detail::ObserverLock lock;
         for (iterator i=observables_.begin(); i!=observables_.end(); ++i)
             (*i)->unregisterObserver(this);
         observables_.clear();
     }
 
+
+    inline void ObservableSettings::disableUpdates(bool deferred) {
+        detail::ObserverLock lock;
+        updatesEnabled_ = false;
+        updatesDeferred_ = deferred;
+    }
+
+    inline void ObservableSettings::registerDeferredObservers(
+                                    const std::vector<Observer*>& observers) {
+        for (Size i=0; i<observers.size(); ++i) {
+            // during a flush, observers already updated are skipped
+            if (!flushing_ || updatedObservers_.count(observers[i]) == 0) {
+                deferredObservers_.insert(observers[i]);
+                observers[i]->deferred_ = true;
+            }
+        }
+    }
+
+    inline void ObservableSettings::unregisterDeferredObserver(Observer* o) {
+        detail::ObserverLock lock;
+        deferredObservers_.erase(o);
+        updatedObservers_.erase(o);
+        o->deferred_ = false;
+    }
+
+    inline void ObservableSettings::enableUpdates() {
+        detail::ObserverLock lock;
+        updatesEnabled_ = true;
+        updatesDeferred_ = false;
+
+        // a flush in progress will also take care of further
+        // notifications collected in the meantime
+        if (flushing_ || deferredObservers_.empty())
+            return;
+
+        flushing_ = true;
+        bool successful = true;
+        std::string errMsg;
+        while (!deferredObservers_.empty()) {
+            Observer* o = *deferredObservers_.begin();
+            deferredObservers_.erase(deferredObservers_.begin());
+            updatedObservers_.insert(o);
+            try {
+                o->update();
+            } catch (std::exception& e) {
+                // see Observable::notifyObservers
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        for (std::set<Observer*>::iterator i=updatedObservers_.begin();
+             i!=updatedObservers_.end(); ++i)
+            (*i)->deferred_ = false;
+        updatedObservers_.clear();
+        flushing_ = false;
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
 }
 
 #endif
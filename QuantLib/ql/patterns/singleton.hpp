@@ -30,6 +30,10 @@
     #pragma managed(push, off)
 #endif
 #include <boost/noncopyable.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/locks.hpp>
+#endif
 #if defined(QL_PATCH_MSVC)
     #pragma managed(pop)
 #endif
@@ -73,6 +77,25 @@ namespace QuantLib {
         as a single implemementation point should synchronization
         features be added.
 
+        When QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN is defined, the
+        creation of instances is synchronized.  Together with
+        QL_ENABLE_SESSIONS, this allows to have an instance per
+        thread, e.g., by means of a sessionId() function such as
+        \code
+        Integer sessionId() {
+            static boost::thread_specific_ptr<Integer> id;
+            static Integer next = 0;
+            if (!id.get()) {
+                static boost::mutex m;
+                boost::lock_guard<boost::mutex> lock(m);
+                id.reset(new Integer(next++));
+            }
+            return *id;
+        }
+        \endcode
+        (the function-scope statics should be initialized, by calling
+        it, before any other thread is started.)
+
         \ingroup patterns
     */
     template <class T>
@@ -80,6 +103,9 @@ namespace QuantLib {
     #if (QL_MANAGED == 1)
       private:
         static std::map<Integer, boost::shared_ptr<T> > instances_;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        static boost::recursive_mutex mutex_;
+        #endif
     #endif
       public:
         //! access to the unique instance
@@ -92,6 +118,10 @@ namespace QuantLib {
     // static member definition
     template <class T>
     std::map<Integer, boost::shared_ptr<T> > Singleton<T>::instances_;
+    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    template <class T>
+    boost::recursive_mutex Singleton<T>::mutex_;
+    #endif
     #endif
 
     // template definitions
@@ -100,12 +130,20 @@ namespace QuantLib {
     T& Singleton<T>::instance() {
         #if (QL_MANAGED == 0)
         static std::map<Integer, boost::shared_ptr<T> > instances_;
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        static boost::recursive_mutex mutex_;
+        #endif
         #endif
         #if defined(QL_ENABLE_SESSIONS)
         Integer id = sessionId();
         #else
         Integer id = 0;
         #endif
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+        // recursive, since the constructor of T might access
+        // other singletons
+        boost::lock_guard<boost::recursive_mutex> lock(mutex_);
+        #endif
         boost::shared_ptr<T>& instance = instances_[id];
         if (!instance)
             instance = boost::shared_ptr<T>(new T);
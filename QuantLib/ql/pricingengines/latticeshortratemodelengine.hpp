@@ -33,6 +33,15 @@ namespace QuantLib {
     //! Engine for a short-rate model specialized on a lattice
     /*! Derived engines only need to implement the <tt>calculate()</tt>
         method
+
+        Engines constructed with a time grid obtain their tree from
+        the model cache, so that engines on the same model and grid
+        share it.  When many instruments are priced on the same
+        model, the engines can be given a common time grid,
+        containing the mandatory times of all the instruments, so
+        that a single tree is built for all of them.  Engines
+        constructed with a number of time steps build a tree for
+        each instrument and don't cache it.
     */
     template <class Arguments, class Results>
     class LatticeShortRateModelEngine
@@ -82,14 +91,14 @@ namespace QuantLib {
             const TimeGrid& timeGrid)
     : GenericModelEngine<ShortRateModel, Arguments, Results>(model),
       timeGrid_(timeGrid), timeSteps_(0) {
-        lattice_ = this->model_->tree(timeGrid);
+        lattice_ = this->model_->cachedTree(timeGrid);
     }
 
     template <class Arguments, class Results>
     void LatticeShortRateModelEngine<Arguments, Results>::update()
     {
         if (!timeGrid_.empty())
-            lattice_ = this->model_->tree(timeGrid_);
+            lattice_ = this->model_->cachedTree(timeGrid_);
         GenericModelEngine<ShortRateModel, Arguments, Results>::update();
     }
 
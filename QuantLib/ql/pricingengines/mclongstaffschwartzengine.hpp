@@ -40,6 +40,12 @@ namespace QuantLib {
         by Simulation: A Simple Least-Squares Approach, The Review of
         Financial Studies, Volume 14, No. 1, 113-147
 
+        If replayCalibrationPaths is set, the calibration paths are
+        not stored but regenerated for each exercise time (see
+        LongstaffSchwartzPathPricer::calibrateByReplay); this bounds
+        the memory used by the calibration at the cost of additional
+        path generation.
+
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
     */
@@ -67,7 +73,8 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples = Null<Size>());
+            Size nCalibrationSamples = Null<Size>(),
+            bool replayCalibrationPaths = false);
 
         void calculate() const;
 
@@ -88,6 +95,7 @@ namespace QuantLib {
         const Size maxSamples_;
         const Size seed_;
         const Size nCalibrationSamples_;
+        const bool replayCalibrationPaths_;
 
         mutable boost::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
             pathPricer_;
@@ -107,7 +115,8 @@ namespace QuantLib {
             Real requiredTolerance,
             Size maxSamples,
             BigNatural seed,
-            Size nCalibrationSamples)
+            Size nCalibrationSamples,
+            bool replayCalibrationPaths)
     : McSimulation<MC,RNG,S> (antitheticVariate, controlVariate),
       process_            (process),
       timeSteps_          (timeSteps),
@@ -118,7 +127,8 @@ namespace QuantLib {
       maxSamples_         (maxSamples),
       seed_               (seed),
       nCalibrationSamples_( (nCalibrationSamples == Null<Size>())
-                            ? 2048 : nCalibrationSamples) {
+                            ? 2048 : nCalibrationSamples),
+      replayCalibrationPaths_(replayCalibrationPaths) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -150,13 +160,21 @@ namespace QuantLib {
     inline
     void MCLongstaffSchwartzEngine<GenericEngine,MC,RNG,S>::calculate() const {
         pathPricer_ = this->lsmPathPricer();
-        this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
-                          new MonteCarloModel<MC,RNG,S>
-                              (pathGenerator(), pathPricer_,
-                               stats_type(), this->antitheticVariate_));
+        if (replayCalibrationPaths_) {
+            boost::shared_ptr<path_generator_type> generator =
+                pathGenerator();
+            this->pathPricer_->calibrateByReplay(*generator,
+                                                 nCalibrationSamples_,
+                                                 this->antitheticVariate_);
+        } else {
+            this->mcModel_ = boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
+                              new MonteCarloModel<MC,RNG,S>
+                                  (pathGenerator(), pathPricer_,
+                                   stats_type(), this->antitheticVariate_));
 
-        this->mcModel_->addSamples(nCalibrationSamples_);
-        this->pathPricer_->calibrate();
+            this->mcModel_->addSamples(nCalibrationSamples_);
+            this->pathPricer_->calibrate();
+        }
 
         McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
                                           requiredSamples_,
@@ -37,6 +37,20 @@ namespace QuantLib {
         Carlo engine.
 
         See McVanillaEngine as an example.
+
+        If more than one thread is requested, the samples are drawn
+        from as many independent streams (see MonteCarloModel) whose
+        path generators are provided by the streamPathGenerator()
+        method.  Results are reproducible for a fixed number of
+        threads, but in general they will differ from those obtained
+        with a different number of threads.
+
+        \warning only engines overriding streamPathGenerator() (at
+                 this time, MCVanillaEngine and the engines derived
+                 from it, such as MCEuropeanEngine) support more than
+                 one thread; the others raise an exception.  See the
+                 warning in streamSeed() about the independence of
+                 the streams.
     */
 
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -67,12 +81,26 @@ namespace QuantLib {
                        Size maxSamples) const;
       protected:
         McSimulation(bool antitheticVariate,
-                     bool controlVariate)
+                     bool controlVariate,
+                     Size threads = 1)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), threads_(threads) {
+            QL_REQUIRE(threads_ > 0, "at least one thread required");
+        }
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
+        /*! returns the path generator for the i-th independent
+            stream; the 0-th stream must be the one returned by
+            pathGenerator().  Engines supporting multi-threaded
+            simulation must override this method.
+        */
+        virtual boost::shared_ptr<path_generator_type>
+        streamPathGenerator(Size stream) const {
+            QL_REQUIRE(stream == 0,
+                       "engine does not support multi-threaded simulation");
+            return pathGenerator();
+        }
         virtual TimeGrid timeGrid() const = 0;
         virtual boost::shared_ptr<path_pricer_type> controlPathPricer() const {
             return boost::shared_ptr<path_pricer_type>();
@@ -94,9 +122,23 @@ namespace QuantLib {
         static Real maxError(Real error) {
             return error;
         }
-        
+        /*! returns a seed for the i-th stream which is reproducible
+            given the seed of the 0-th stream (a null seed is passed
+            through, i.e., the stream is seeded from the clock.)
+
+            \warning the seed is the i-th output of a Mersenne twister
+                     seeded with the given seed; this is not a
+                     jump-ahead, and the sequences generated from
+                     different stream seeds are not guaranteed not to
+                     overlap.  For the sample sizes used in practice
+                     the overlap is extremely unlikely given the period
+                     of the generator, but it is not ruled out.
+        */
+        static BigNatural streamSeed(BigNatural seed, Size stream);
+
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size threads_;
     };
 
 
@@ -180,6 +222,9 @@ namespace QuantLib {
 
             boost::shared_ptr<path_generator_type> controlPG = 
                 this->controlPathGenerator();
+            QL_REQUIRE(!controlPG || threads_ == 1,
+                       "multi-threaded simulation not available with "
+                       "a separate control-variate path generator");
 
             this->mcModel_ =
                 boost::shared_ptr<MonteCarloModel<MC,RNG,S> >(
@@ -195,6 +240,19 @@ namespace QuantLib {
                            this->antitheticVariate_));
         }
 
+        if (threads_ > 1) {
+            QL_REQUIRE(RNG::allowsErrorEstimate,
+                       "multi-threaded simulation requires "
+                       "a pseudo-random number generator");
+            for (Size i=1; i<threads_; ++i) {
+                this->mcModel_->addStream(
+                    this->streamPathGenerator(i), this->pathPricer(),
+                    this->controlVariate_ ?
+                        this->controlPathPricer() :
+                        boost::shared_ptr<path_pricer_type>());
+            }
+        }
+
         if (requiredTolerance != Null<Real>()) {
             if (maxSamples != Null<Size>())
                 this->value(requiredTolerance, maxSamples);
@@ -206,6 +264,19 @@ namespace QuantLib {
 
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline BigNatural McSimulation<MC,RNG,S>::streamSeed(BigNatural seed,
+                                                         Size stream) {
+        if (seed == 0 || stream == 0)
+            return seed;
+        MersenneTwisterUniformRng rng(seed);
+        BigNatural s = 0;
+        for (Size i=0; i<stream; ++i)
+            s = rng.nextInt32();
+        // zero would mean a clock-based seed
+        return s == 0 ? seed : s;
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::errorEstimate() const {
@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/portfoliopricer.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    namespace {
+
+        // restores the market objects even if pricing throws
+        class FrozenMarket {
+          public:
+            explicit FrozenMarket(
+                const std::vector<boost::shared_ptr<LazyObject> >& objects)
+            : objects_(objects) {
+                for (Size i=0; i<objects_.size(); ++i) {
+                    objects_[i]->recalculate();
+                    objects_[i]->freeze();
+                }
+            }
+            ~FrozenMarket() {
+                for (Size i=0; i<objects_.size(); ++i) {
+                    try {
+                        objects_[i]->unfreeze();
+                    } catch (...) {}
+                }
+            }
+          private:
+            const std::vector<boost::shared_ptr<LazyObject> >& objects_;
+        };
+
+    }
+
+    PortfolioPricer::PortfolioPricer(
+            const std::vector<boost::shared_ptr<Instrument> >& instruments,
+            const std::vector<boost::shared_ptr<LazyObject> >& marketObjects)
+    : instruments_(instruments), marketObjects_(marketObjects) {
+        for (Size i=0; i<instruments_.size(); ++i)
+            QL_REQUIRE(instruments_[i], "null instrument #" << i);
+        for (Size i=0; i<marketObjects_.size(); ++i)
+            QL_REQUIRE(marketObjects_[i], "null market object #" << i);
+    }
+
+    void PortfolioPricer::calculate() {
+        const Size n = instruments_.size();
+        NPVs_.assign(n, Null<Real>());
+        additionalResults_.assign(n, std::map<std::string,boost::any>());
+        errors_.assign(n, std::string());
+
+        // instruments sharing an engine must be priced by one thread
+        std::vector<std::vector<Size> > groups;
+        std::map<PricingEngine*, Size> groupOfEngine;
+        for (Size i=0; i<n; ++i) {
+            PricingEngine* engine = instruments_[i]->pricingEngine().get();
+            if (engine == 0) {
+                groups.push_back(std::vector<Size>(1, i));
+                continue;
+            }
+            std::map<PricingEngine*, Size>::const_iterator g =
+                groupOfEngine.find(engine);
+            if (g == groupOfEngine.end()) {
+                groupOfEngine[engine] = groups.size();
+                groups.push_back(std::vector<Size>(1, i));
+            } else {
+                groups[g->second].push_back(i);
+            }
+        }
+
+        FrozenMarket frozen(marketObjects_);
+
+        #pragma omp parallel for default(shared) schedule(dynamic)
+        for (long k=0; k<long(groups.size()); ++k) {
+            for (Size j=0; j<groups[k].size(); ++j) {
+                const Size i = groups[k][j];
+                try {
+                    NPVs_[i] = instruments_[i]->NPV();
+                    additionalResults_[i] =
+                        instruments_[i]->additionalResults();
+                } catch (std::exception& e) {
+                    NPVs_[i] = Null<Real>();
+                    errors_[i] = e.what();
+                } catch (...) {
+                    NPVs_[i] = Null<Real>();
+                    errors_[i] = "unknown error";
+                }
+            }
+        }
+    }
+
+    Size PortfolioPricer::failures() const {
+        Size count = 0;
+        for (Size i=0; i<errors_.size(); ++i)
+            if (!errors_[i].empty())
+                ++count;
+        return count;
+    }
+
+}
+
@@ -0,0 +1,91 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliopricer.hpp
+    \brief batch pricing of a portfolio of instruments
+*/
+
+#ifndef quantlib_portfolio_pricer_hpp
+#define quantlib_portfolio_pricer_hpp
+
+#include <ql/instrument.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Batch pricing of a portfolio of instruments
+    /*! The instruments are priced in parallel (if OpenMP is enabled)
+        and their results are collected in contiguous arrays, in the
+        same order as the instruments passed to the constructor.
+
+        Instruments sharing the same pricing engine are priced
+        sequentially by the same thread, since engines store their
+        arguments and results; different engine instances are
+        processed concurrently, with threads picking up the next
+        group as soon as they are done with the previous one.  To
+        increase parallelism, the instruments should thus be
+        partitioned among a few instances of each engine.
+
+        The market objects passed to the constructor (e.g.,
+        bootstrapped curves or calibrated models) are recalculated
+        and frozen before pricing, so that their results are
+        read-only while the threads run, and unfrozen afterwards.
+
+        Failures of single instruments do not stop the calculation:
+        their NPV is set to Null<Real>() and the reason is available
+        from the errors() inspector.
+
+        \warning unless QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN is
+                 defined, engines that register observers with
+                 shared objects during their calculations (e.g., by
+                 building term structures on the fly) must not be
+                 used on more than one thread.
+
+        \ingroup instruments
+    */
+    class PortfolioPricer {
+      public:
+        PortfolioPricer(
+            const std::vector<boost::shared_ptr<Instrument> >& instruments,
+            const std::vector<boost::shared_ptr<LazyObject> >& marketObjects
+                          = std::vector<boost::shared_ptr<LazyObject> >());
+        //! prices all instruments
+        void calculate();
+        //! \name Inspectors
+        //@{
+        const std::vector<boost::shared_ptr<Instrument> >&
+        instruments() const { return instruments_; }
+        const std::vector<Real>& NPVs() const { return NPVs_; }
+        const std::vector<std::map<std::string,boost::any> >&
+        additionalResults() const { return additionalResults_; }
+        //! error messages; empty for successfully priced instruments
+        const std::vector<std::string>& errors() const { return errors_; }
+        //! number of instruments that could not be priced
+        Size failures() const;
+        //@}
+      private:
+        std::vector<boost::shared_ptr<Instrument> > instruments_;
+        std::vector<boost::shared_ptr<LazyObject> > marketObjects_;
+        std::vector<Real> NPVs_;
+        std::vector<std::map<std::string,boost::any> > additionalResults_;
+        std::vector<std::string> errors_;
+    };
+
+}
+
+
+#endif
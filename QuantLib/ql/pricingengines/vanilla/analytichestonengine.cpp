@@ -105,6 +105,8 @@ namespace QuantLib {
             Size j);
 
         Real operator()(Real phi)      const;
+        // strike-independent part of the exponent of the integrand
+        std::complex<Real> exponent(Real phi) const;
 
     private:
         const Size j_;
@@ -205,6 +207,37 @@ namespace QuantLib {
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
+                }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
+            }
+            else {
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
+            }
+        }
+
+        return std::exp(exponent(phi)
+                        + std::complex<Real>(0.0, phi*(dd_-sx_))
+                        ).imag()/phi;
+    }
+
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::exponent(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -214,57 +247,27 @@ namespace QuantLib {
                       *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
         const std::complex<Real> ex = std::exp(-d*term_);
         const std::complex<Real> addOnTerm
-            = engine_ > 0 ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+            = engine_ != 0 ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                       + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                       + addOnTerm;
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                return v0_*td*(1.0-ex)/(1.0-p*ex)
+                       + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                       + addOnTerm;
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -310,11 +313,9 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            return v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                   + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
+                   + addOnTerm;
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
@@ -435,6 +436,15 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
+        if (!integration_->isAdaptiveIntegration()) {
+            results_.value = multiStrikeValue(nodeValues(term),
+                                              riskFreeDiscount,
+                                              dividendDiscount,
+                                              spotPrice, strikePrice,
+                                              payoff->optionType());
+            return;
+        }
+
         doCalculation(riskFreeDiscount,
                       dividendDiscount,
                       spotPrice,
@@ -454,6 +464,141 @@ namespace QuantLib {
     }
 
 
+    void AnalyticHestonEngine::update() {
+        nodeCache_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    std::vector<Real> AnalyticHestonEngine::multiStrikeValues(
+                                    Option::Type type,
+                                    const std::vector<Real>& strikes,
+                                    const Date& exerciseDate) const {
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(exerciseDate);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(exerciseDate);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real term = process->time(exerciseDate);
+
+        std::vector<Real> values(strikes.size());
+        if (integration_->isAdaptiveIntegration()) {
+            evaluations_ = 0;
+            for (Size i=0; i < strikes.size(); ++i) {
+                Size evaluations;
+                doCalculation(riskFreeDiscount, dividendDiscount,
+                              spotPrice, strikes[i], term,
+                              model_->kappa(), model_->theta(),
+                              model_->sigma(), model_->v0(), model_->rho(),
+                              PlainVanillaPayoff(type, strikes[i]),
+                              *integration_, cpxLog_, this,
+                              values[i], evaluations);
+                evaluations_ += evaluations;
+            }
+        }
+        else {
+            const NodeValues& nodes = nodeValues(term);
+            for (Size i=0; i < strikes.size(); ++i)
+                values[i] = multiStrikeValue(nodes, riskFreeDiscount,
+                                             dividendDiscount, spotPrice,
+                                             strikes[i], type);
+        }
+        return values;
+    }
+
+    const AnalyticHestonEngine::NodeValues&
+    AnalyticHestonEngine::nodeValues(Time term) const {
+        // the parameters can change without notification,
+        // e.g. while the model is being calibrated
+        const Array& params = model_->params();
+        if (params.size() != cachedParams_.size()
+            || !std::equal(params.begin(), params.end(),
+                           cachedParams_.begin())) {
+            nodeCache_.clear();
+            cachedParams_ = params;
+        }
+
+        evaluations_ = 0;
+        const std::map<Time, NodeValues>::const_iterator iter
+            = nodeCache_.find(term);
+        if (iter != nodeCache_.end())
+            return iter->second;
+
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        const Real c_inf = std::min(10.0, std::max(0.0001,
+                std::sqrt(1.0-square<Real>()(rho))/sigma))
+                *(v0 + kappa*theta*term);
+
+        NodeValues nodes;
+        integration_->gaussianNodes(c_inf, nodes.phi, nodes.weights);
+
+        // spot, strike and discount ratio only enter the strike
+        // dependent part of the integrand; the helpers are evaluated
+        // in node order to keep the branch correction consistent.
+        const Fj_Helper f1(kappa, theta, sigma, v0, 1.0, rho, this,
+                           cpxLog_, term, 1.0, 1.0, 1);
+        const Fj_Helper f2(kappa, theta, sigma, v0, 1.0, rho, this,
+                           cpxLog_, term, 1.0, 1.0, 2);
+
+        const Size n = nodes.phi.size();
+        nodes.cf1.resize(n);
+        nodes.cf2.resize(n);
+        for (Size i=0; i < n; ++i) {
+            nodes.cf1[i] = std::exp(f1.exponent(nodes.phi[i]));
+            nodes.cf2[i] = std::exp(f2.exponent(nodes.phi[i]));
+        }
+        evaluations_ = 2*n;
+
+        NodeValues& cached = nodeCache_[term];
+        std::swap(cached, nodes);
+        return cached;
+    }
+
+    Real AnalyticHestonEngine::multiStrikeValue(const NodeValues& nodes,
+                                                Real riskFreeDiscount,
+                                                Real dividendDiscount,
+                                                Real spotPrice,
+                                                Real strikePrice,
+                                                Option::Type type) const {
+        const Real x = std::log(spotPrice)
+            - std::log(riskFreeDiscount/dividendDiscount)
+            - std::log(strikePrice);
+
+        Real p1 = 0.0, p2 = 0.0;
+        for (Size i=0; i < nodes.phi.size(); ++i) {
+            const Real phi = nodes.phi[i];
+            const Real c = std::cos(phi*x), s = std::sin(phi*x);
+            const Real w = nodes.weights[i]/phi;
+            p1 += w*(nodes.cf1[i].imag()*c + nodes.cf1[i].real()*s);
+            p2 += w*(nodes.cf2[i].imag()*c + nodes.cf2[i].real()*s);
+        }
+        p1 /= M_PI;
+        p2 /= M_PI;
+
+        switch (type) {
+          case Option::Call:
+            return spotPrice*dividendDiscount*(p1+0.5)
+                - strikePrice*riskFreeDiscount*(p2+0.5);
+          case Option::Put:
+            return spotPrice*dividendDiscount*(p1-0.5)
+                - strikePrice*riskFreeDiscount*(p2-0.5);
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+
     AnalyticHestonEngine::Integration::Integration(
             Algorithm intAlgo,
             const boost::shared_ptr<Integrator>& integrator)
@@ -580,4 +725,33 @@ namespace QuantLib {
 
         return retVal;
      }
+
+    void AnalyticHestonEngine::Integration::gaussianNodes(
+                                        Real c_inf,
+                                        std::vector<Real>& nodes,
+                                        std::vector<Real>& weights) const {
+        QL_REQUIRE(gaussianQuadrature_,
+                   "Gaussian quadrature nodes are not available for "
+                   "adaptive integration methods");
+
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+
+        nodes.clear();
+        weights.clear();
+        nodes.reserve(x.size());
+        weights.reserve(x.size());
+
+        // same order as GaussianQuadrature::operator()
+        for (Integer i=Integer(x.size())-1; i >=0; --i) {
+            if (intAlgo_ == GaussLaguerre) {
+                nodes.push_back(x[i]);
+                weights.push_back(w[i]);
+            }
+            else if ((x[i]+1.0)*c_inf > QL_EPSILON) {
+                nodes.push_back(-std::log(0.5*x[i]+0.5)/c_inf);
+                weights.push_back(w[i]/((x[i]+1.0)*c_inf));
+            }
+        }
+    }
 }
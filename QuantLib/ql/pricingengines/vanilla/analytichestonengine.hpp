@@ -33,6 +33,7 @@
 
 #include <boost/function.hpp>
 #include <complex>
+#include <map>
 
 namespace QuantLib {
 
@@ -103,8 +104,22 @@ namespace QuantLib {
 
 
         void calculate() const;
+        void update();
+        //! characteristic-function evaluations during the last calculation
         Size numberOfEvaluations() const;
 
+        //! values of European options with a common exercise date
+        /*! With Gaussian quadratures, the characteristic function is
+            evaluated once per quadrature node and exercise date and
+            then reused for all strikes, both here and by calculate()
+            until the model parameters change; adaptive algorithms
+            price each strike separately.
+        */
+        std::vector<Real> multiStrikeValues(
+                                    Option::Type type,
+                                    const std::vector<Real>& strikes,
+                                    const Date& exerciseDate) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -127,10 +142,24 @@ namespace QuantLib {
 
       private:
         class Fj_Helper;
+        // integrand values at the quadrature nodes for one exercise time
+        struct NodeValues {
+            std::vector<Real> phi, weights;
+            std::vector<std::complex<Real> > cf1, cf2;
+        };
+        const NodeValues& nodeValues(Time term) const;
+        Real multiStrikeValue(const NodeValues& nodes,
+                              Real riskFreeDiscount,
+                              Real dividendDiscount,
+                              Real spotPrice,
+                              Real strikePrice,
+                              Option::Type type) const;
 
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
+        mutable std::map<Time, NodeValues> nodeCache_;
+        mutable Array cachedParams_;
     };
 
 
@@ -160,6 +189,14 @@ namespace QuantLib {
         Real calculate(Real c_inf,
                        const boost::function1<Real, Real>& f) const;
 
+        /*! nodes and weights of Gaussian quadratures on the
+            integration domain, in the order used by calculate();
+            nodes whose contribution is dropped are skipped.
+        */
+        void gaussianNodes(Real c_inf,
+                           std::vector<Real>& nodes,
+                           std::vector<Real>& weights) const;
+
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
 
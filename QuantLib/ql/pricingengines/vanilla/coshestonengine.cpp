@@ -0,0 +1,191 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file coshestonengine.cpp
+    \brief Heston engine based on the Fourier-cosine series expansion
+*/
+
+#include <ql/instruments/payoffs.hpp>
+#include <ql/pricingengines/vanilla/coshestonengine.hpp>
+
+namespace QuantLib {
+
+    COSHestonEngine::COSHestonEngine(
+                              const boost::shared_ptr<HestonModel>& model,
+                              Real L, Size N)
+    : GenericModelEngine<HestonModel,
+                         VanillaOption::arguments,
+                         VanillaOption::results>(model),
+      L_(L), N_(N) {
+        QL_REQUIRE(L_ > 0.0, "positive truncation range required");
+        QL_REQUIRE(N_ > 0, "positive number of expansion terms required");
+    }
+
+    void COSHestonEngine::calculate() const {
+        // this is a european option pricer
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::European,
+                   "not an European option");
+
+        // plain vanilla
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non plain vanilla payoff given");
+
+        results_.value = multiStrikeValues(
+            payoff->optionType(),
+            std::vector<Real>(1, payoff->strike()),
+            arguments_.exercise->lastDate()).front();
+    }
+
+    std::vector<Real> COSHestonEngine::multiStrikeValues(
+                                    Option::Type type,
+                                    const std::vector<Real>& strikes,
+                                    const Date& exerciseDate) const {
+        QL_REQUIRE(type == Option::Call || type == Option::Put,
+                   "unknown option type");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const DiscountFactor riskFreeDiscount =
+            process->riskFreeRate()->discount(exerciseDate);
+        const DiscountFactor dividendDiscount =
+            process->dividendYield()->discount(exerciseDate);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Real forward = spotPrice*dividendDiscount/riskFreeDiscount;
+        const Time t = process->time(exerciseDate);
+
+        std::vector<Real> values(strikes.size());
+        if (t <= 0.0) {
+            // expiry today: the cumulants vanish, return the payoff
+            for (Size i=0; i < strikes.size(); ++i) {
+                QL_REQUIRE(strikes[i] > 0.0, "positive strike required");
+                values[i] = riskFreeDiscount
+                    * PlainVanillaPayoff(type, strikes[i])(forward);
+            }
+            return values;
+        }
+
+        QL_REQUIRE(model_->kappa() > 0.0,
+                   "positive mean-reversion speed required");
+        QL_REQUIRE(model_->sigma() > 0.0,
+                   "positive volatility of variance required");
+
+        // the truncation range [a, b] is centered around x+c1 with
+        // x = ln(F/K), hence the frequencies and x-a do not depend
+        // on the strike and the characteristic function is evaluated
+        // once for all strikes.
+        const Real cumulant1 = c1(t);
+        const Real d = L_*std::sqrt(std::fabs(c2(t)));
+        const Real bma = 2.0*d;
+        const Real xma = d - cumulant1;
+
+        std::vector<Real> u(N_), reF(N_);
+        for (Size k=0; k < N_; ++k) {
+            u[k] = k*M_PI/bma;
+            const std::complex<Real> phi = chF(u[k], t);
+            reF[k] = phi.real()*std::cos(u[k]*xma)
+                   - phi.imag()*std::sin(u[k]*xma);
+        }
+        reF[0] *= 0.5;
+
+        for (Size i=0; i < strikes.size(); ++i) {
+            const Real strike = strikes[i];
+            QL_REQUIRE(strike > 0.0, "positive strike required");
+
+            const Real a = std::log(forward/strike) + cumulant1 - d;
+
+            // put payoff coefficients on [a, min(0, b)]
+            Real put = 0.0;
+            if (a < 0.0) {
+                const Real c = std::min(0.0, a + bma);
+                const Real expA = std::exp(a), expC = std::exp(c);
+
+                Real sum = reF[0]*((c - a) - (expC - expA));
+                for (Size k=1; k < N_; ++k) {
+                    const Real cosK = std::cos(u[k]*(c-a));
+                    const Real sinK = std::sin(u[k]*(c-a));
+
+                    const Real chi = (cosK*expC - expA + u[k]*sinK*expC)
+                        / (1.0 + u[k]*u[k]);
+                    const Real psi = sinK/u[k];
+
+                    sum += reF[k]*(psi - chi);
+                }
+                put = strike*riskFreeDiscount*2.0/bma*sum;
+            }
+
+            values[i] = (type == Option::Put)
+                ? put
+                : put + spotPrice*dividendDiscount - strike*riskFreeDiscount;
+        }
+
+        return values;
+    }
+
+    std::complex<Real> COSHestonEngine::chF(Real u, Time t) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        const Real sigma2 = sigma*sigma;
+
+        const std::complex<Real> t1 =
+            std::complex<Real>(kappa, -rho*sigma*u);
+        const std::complex<Real> d =
+            std::sqrt(t1*t1 + sigma2*std::complex<Real>(u*u, u));
+        const std::complex<Real> g = (t1 - d)/(t1 + d);
+        const std::complex<Real> ex = std::exp(-d*t);
+
+        return std::exp(v0/sigma2*(1.0-ex)/(1.0-g*ex)*(t1-d)
+                        + kappa*theta/sigma2
+                            *((t1-d)*t - 2.0*std::log((1.0-g*ex)/(1.0-g))));
+    }
+
+    Real COSHestonEngine::c1(Time t) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real v0    = model_->v0();
+
+        return (1.0-std::exp(-kappa*t))*(theta-v0)/(2.0*kappa)
+            - 0.5*theta*t;
+    }
+
+    Real COSHestonEngine::c2(Time t) const {
+        const Real kappa = model_->kappa();
+        const Real theta = model_->theta();
+        const Real sigma = model_->sigma();
+        const Real v0    = model_->v0();
+        const Real rho   = model_->rho();
+
+        const Real sigma2 = sigma*sigma;
+        const Real kappa2 = kappa*kappa;
+        const Real e1 = std::exp(-kappa*t);
+        const Real e2 = e1*e1;
+
+        return 1.0/(8.0*kappa2*kappa)
+            *(  sigma*t*kappa*e1*(v0-theta)*(8.0*kappa*rho-4.0*sigma)
+              + kappa*rho*sigma*(1.0-e1)*(16.0*theta-8.0*v0)
+              + 2.0*theta*kappa*t*(-4.0*kappa*rho*sigma+sigma2+4.0*kappa2)
+              + sigma2*((theta-2.0*v0)*e2 + theta*(6.0*e1-7.0) + 2.0*v0)
+              + 8.0*kappa2*(v0-theta)*(1.0-e1));
+    }
+}
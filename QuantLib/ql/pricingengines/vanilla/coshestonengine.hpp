@@ -0,0 +1,85 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file coshestonengine.hpp
+    \brief Heston engine based on the Fourier-cosine series expansion
+*/
+
+#ifndef quantlib_cos_heston_engine_hpp
+#define quantlib_cos_heston_engine_hpp
+
+#include <ql/pricingengines/genericmodelengine.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <complex>
+
+namespace QuantLib {
+
+    //! Heston-model engine for European options based on the COS method
+    /*! The density of the log-price at exercise is expanded in a
+        cosine series on a truncated range of width 2L times the
+        standard deviation of the log-price; the payoff coefficients
+        are known in closed form.  The characteristic function only
+        depends on the exercise time, so that a whole option chain
+        can be priced with a single set of N evaluations.
+
+        References:
+
+        F. Fang, C.W. Oosterlee, A novel pricing method for European
+        options based on Fourier-cosine series expansions,
+        SIAM J. Sci. Comput. 31(2), 2008, 826-848.
+
+        The closed-form cumulants and characteristic function are
+        singular for vanishing kappa or sigma, hence both must be
+        strictly positive.  Options expiring on the evaluation date
+        are given their intrinsic value.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned value is tested by
+              comparison with the analytic Heston engine.
+    */
+    class COSHestonEngine
+        : public GenericModelEngine<HestonModel,
+                                    VanillaOption::arguments,
+                                    VanillaOption::results> {
+      public:
+        COSHestonEngine(const boost::shared_ptr<HestonModel>& model,
+                        Real L = 16, Size N = 200);
+
+        void calculate() const;
+
+        //! values of European options with a common exercise date
+        std::vector<Real> multiStrikeValues(
+                                    Option::Type type,
+                                    const std::vector<Real>& strikes,
+                                    const Date& exerciseDate) const;
+
+        //! characteristic function of the log forward moneyness
+        std::complex<Real> chF(Real u, Time t) const;
+
+        //! first and second cumulant of the log forward moneyness
+        Real c1(Time t) const;
+        Real c2(Time t) const;
+
+      private:
+        const Real L_;
+        const Size N_;
+    };
+}
+
+#endif
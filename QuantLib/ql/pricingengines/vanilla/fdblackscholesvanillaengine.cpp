@@ -20,13 +20,20 @@
 */
 
 #include <ql/exercise.hpp>
+#include <ql/instruments/payoffs.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <algorithm>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 
 namespace QuantLib {
@@ -47,6 +54,41 @@ namespace QuantLib {
 
     void FdBlackScholesVanillaEngine::calculate() const {
 
+        // cache lookup for precalculated results
+        for (Size i=0; i < cachedArgs2results_.size(); ++i) {
+            if (   cachedArgs2results_[i].first.exercise->type()
+                        == arguments_.exercise->type()
+                && cachedArgs2results_[i].first.exercise->dates()
+                        == arguments_.exercise->dates()
+                && cachedArgs2results_[i].first.cashFlow
+                        == arguments_.cashFlow) {
+                boost::shared_ptr<PlainVanillaPayoff> p1 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                            arguments_.payoff);
+                boost::shared_ptr<PlainVanillaPayoff> p2 =
+                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                          cachedArgs2results_[i].first.payoff);
+
+                if (p1 && p1->strike()     == p2->strike()
+                       && p1->optionType() == p2->optionType()) {
+                    results_ = cachedArgs2results_[i].second;
+                    return;
+                }
+            }
+        }
+
+        // the whole chain is rolled back only for strikes in it, so
+        // that the cached results don't depend on the first option
+        const boost::shared_ptr<PlainVanillaPayoff> plainPayoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                       arguments_.payoff);
+        if (plainPayoff
+            && std::find(strikes_.begin(), strikes_.end(),
+                         plainPayoff->strike()) != strikes_.end()) {
+            calculateMultipleStrikes();
+            return;
+        }
+
         // 1. Mesher
         const boost::shared_ptr<StrikedTypePayoff> payoff =
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
@@ -92,4 +134,130 @@ namespace QuantLib {
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
     }
+
+    void FdBlackScholesVanillaEngine::calculateMultipleStrikes() const {
+
+        const boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+
+        std::vector<Real> strikes(strikes_);
+        std::sort(strikes.begin(), strikes.end());
+        strikes.erase(std::unique(strikes.begin(), strikes.end()),
+                      strikes.end());
+        const Size nStrikes = strikes.size();
+
+        // 1. Mesher: log-spot in direction 0, one grid line per strike
+        //    in direction 1. The grid covers all strikes and the spot,
+        //    and it is concentrated around the spot rather than around
+        //    any particular strike.
+        const Real spot = process_->x0();
+        const Time maturity = process_->time(arguments_.exercise->lastDate());
+
+        std::vector<Real> mesherStrikes(strikes);
+        mesherStrikes.push_back(spot);
+
+        const boost::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMultiStrikeMesher(
+                    xGrid_, process_, maturity, mesherStrikes,
+                    0.0001, 1.5,
+                    std::pair<Real, Real>(spot, 0.1)));
+
+        const boost::shared_ptr<FdmMesher> mesher (
+            new FdmMesherComposite(equityMesher,
+                boost::shared_ptr<Fdm1dMesher>(
+                                        new Predefined1dMesher(strikes))));
+
+        // 2. Calculator
+        std::vector<boost::shared_ptr<Payoff> > payoffs(nStrikes);
+        for (Size k=0; k < nStrikes; ++k)
+            payoffs[k] = boost::shared_ptr<Payoff>(
+                new PlainVanillaPayoff(payoff->optionType(), strikes[k]));
+
+        const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                      new FdmLogMultiPayoffInnerValue(payoffs, mesher, 0, 1));
+
+        // 3. Step conditions, with a snapshot close to t=0 for theta
+        const boost::shared_ptr<FdmStepConditionComposite> conditions =
+            FdmStepConditionComposite::vanillaComposite(
+                                    arguments_.cashFlow, arguments_.exercise,
+                                    mesher, calculator,
+                                    process_->riskFreeRate()->referenceDate(),
+                                    process_->riskFreeRate()->dayCounter());
+
+        const boost::shared_ptr<FdmSnapshotCondition> thetaCondition(
+            new FdmSnapshotCondition(
+                0.99*std::min(1.0/365.0,
+                              conditions->stoppingTimes().empty()
+                                  ? maturity
+                                  : conditions->stoppingTimes().front())));
+
+        // 4. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 5. Operator and backward induction of all strikes at once;
+        //    the Black variance is taken per strike unless local
+        //    volatility is used
+        const boost::shared_ptr<FdmLinearOpComposite> op(
+            new FdmBlackScholesOp(mesher, process_, spot,
+                                  localVol_, illegalLocalVolOverwrite_, 0,
+                                  localVol_ ? Null<Size>() : Size(1)));
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        Array rhs(layout->size());
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            rhs[iter.index()] = calculator->avgInnerValue(iter, maturity);
+        }
+
+        FdmBackwardSolver(op, boundaries,
+                          FdmStepConditionComposite::joinConditions(
+                                               thetaCondition, conditions),
+                          schemeDesc_)
+            .rollback(rhs, maturity, 0.0, tGrid_, dampingSteps_);
+
+        // 6. Results, direction 0 is the fastest running index
+        const std::vector<Real>& x = equityMesher->locations();
+        const Size nx = x.size();
+        const Real logSpot = std::log(spot);
+        const Array& thetaValues = thetaCondition->getValues();
+
+        cachedArgs2results_.resize(nStrikes);
+        for (Size k=0; k < nStrikes; ++k) {
+            const MonotonicCubicNaturalSpline interpolation(
+                x.begin(), x.end(), rhs.begin() + k*nx);
+            const Real value = interpolation(logSpot);
+            const Real dx = interpolation.derivative(logSpot);
+            const Real dxx = interpolation.secondDerivative(logSpot);
+            const Real thetaValue = MonotonicCubicNaturalSpline(
+                x.begin(), x.end(), thetaValues.begin() + k*nx)(logSpot);
+
+            DividendVanillaOption::arguments& args
+                                        = cachedArgs2results_[k].first;
+            args.exercise = arguments_.exercise;
+            args.cashFlow = arguments_.cashFlow;
+            args.payoff = payoffs[k];
+
+            DividendVanillaOption::results&
+                                results = cachedArgs2results_[k].second;
+            results.value = value;
+            results.delta = dx/spot;
+            results.gamma = (dxx - dx)/(spot*spot);
+            results.theta = (thetaValue - value)/thetaCondition->getTime();
+
+            if (strikes[k] == payoff->strike())
+                results_ = results;
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        cachedArgs2results_.clear();
+        DividendVanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableMultipleStrikesCaching(
+                                        const std::vector<Real>& strikes) {
+        strikes_ = strikes;
+        cachedArgs2results_.clear();
+    }
 }
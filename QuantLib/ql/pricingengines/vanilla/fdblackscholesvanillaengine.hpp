@@ -54,12 +54,30 @@ namespace QuantLib {
 
         void calculate() const;
 
+        // multiple strikes caching engine
+        void update();
+        /*! Plain vanilla options with one of the given strikes are
+            then priced together: their payoffs are stacked along a
+            second grid dimension and rolled back in a single backward
+            pass on a grid concentrated around the spot, and the
+            results for all strikes are cached until the next update.
+            Options with other strikes are priced individually.
+        */
+        void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
       private:
+        void calculateMultipleStrikes() const;
+
         const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+
+        std::vector<Real> strikes_;
+        mutable std::vector<std::pair<DividendVanillaOption::arguments,
+                                      DividendVanillaOption::results> >
+                                                            cachedArgs2results_;
     };
 }
 
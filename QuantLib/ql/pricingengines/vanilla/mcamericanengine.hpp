@@ -61,7 +61,8 @@ namespace QuantLib {
              BigNatural seed,
              Size polynomOrder,
              LsmBasisSystem::PolynomType polynomType,
-             Size nCalibrationSamples = Null<Size>());
+             Size nCalibrationSamples = Null<Size>(),
+             bool replayCalibrationPaths = false);
 
         void calculate() const;
         
@@ -116,6 +117,7 @@ namespace QuantLib {
         MakeMCAmericanEngine& withPolynomOrder(Size polynomOrer);
         MakeMCAmericanEngine& withBasisSystem(LsmBasisSystem::PolynomType);
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
+        MakeMCAmericanEngine& withCalibrationPathsReplay(bool b = true);
 
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -124,6 +126,7 @@ namespace QuantLib {
         bool antithetic_, controlVariate_;
         Size steps_, stepsPerYear_;
         Size samples_, maxSamples_, calibrationSamples_;
+        bool replayCalibrationPaths_;
         Real tolerance_;
         BigNatural seed_;
         Size polynomOrder_;
@@ -138,14 +141,15 @@ namespace QuantLib {
         Size requiredSamples, Real requiredTolerance,
         Size maxSamples,BigNatural seed,
         Size polynomOrder, LsmBasisSystem::PolynomType polynomType,
-        Size nCalibrationSamples)
+        Size nCalibrationSamples, bool replayCalibrationPaths)
     : MCLongstaffSchwartzEngine<VanillaOption::engine,
                                 SingleVariate,RNG,S>(
                                          process, timeSteps, timeStepsPerYear,
                                          false, antitheticVariate,
                                          controlVariate, requiredSamples,
                                          requiredTolerance, maxSamples,
-                                         seed, nCalibrationSamples),
+                                         seed, nCalibrationSamples,
+                                         replayCalibrationPaths),
       polynomOrder_(polynomOrder),
       polynomType_(polynomType) {}
 
@@ -249,7 +253,7 @@ namespace QuantLib {
     : process_(process), antithetic_(false), controlVariate_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      calibrationSamples_(2048),
+      calibrationSamples_(2048), replayCalibrationPaths_(false),
       tolerance_(Null<Real>()), seed_(0),
       polynomOrder_(2),
       polynomType_ (LsmBasisSystem::Monomial) {}
@@ -318,6 +322,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCAmericanEngine<RNG,S>&
+    MakeMCAmericanEngine<RNG,S>::withCalibrationPathsReplay(bool b) {
+        replayCalibrationPaths_ = b;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCAmericanEngine<RNG,S>&
     MakeMCAmericanEngine<RNG,S>::withSeed(BigNatural seed) {
@@ -359,7 +370,8 @@ namespace QuantLib {
                                      seed_,
                                      polynomOrder_,
                                      polynomType_,
-                                     calibrationSamples_));
+                                     calibrationSamples_,
+                                     replayCalibrationPaths_));
     }
 
 }
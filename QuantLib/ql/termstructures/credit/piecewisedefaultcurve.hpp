@@ -28,6 +28,7 @@
 #define quantlib_piecewise_default_curve_hpp
 
 #include <ql/termstructures/iterativebootstrap.hpp>
+#include <ql/termstructures/newtonbootstrap.hpp>
 #include <ql/termstructures/credit/probabilitytraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/quote.hpp>
@@ -148,6 +149,23 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Bootstrap results
+        //@{
+        /*! Jacobian of the implied quotes of the alive helpers with
+            respect to the curve nodes after the reference date.
+
+            \pre the bootstrap policy must provide it, as is the case
+                 for IterativeBootstrap and NewtonBootstrap.
+        */
+        const Matrix& jacobian() const;
+        /*! sensitivities of the curve nodes after the reference date
+            (rows) with respect to the quotes of the alive helpers
+            (columns), i.e., the inverse of the Jacobian. They allow
+            to obtain quote sensitivities from node sensitivities
+            without bootstrapping the curve again.
+        */
+        Disposable<Matrix> nodeSensitivities() const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -211,6 +229,17 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseDefaultCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
+    template <class C, class I, template <class> class B>
+    inline Disposable<Matrix> PiecewiseDefaultCurve<C,I,B>::nodeSensitivities() const {
+        return inverse(jacobian());
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseDefaultCurve<C,I,B>::update() {
         base_curve::update();
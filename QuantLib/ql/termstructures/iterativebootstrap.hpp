@@ -31,11 +31,21 @@
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 namespace QuantLib {
 
     //! Universal piecewise-term-structure boostrapper.
+    /*! The bootstrapper keeps track of the helpers which sent a
+        notification since the last calculation.  For local
+        interpolations (i.e., when the value at a pillar only affects
+        the curve up to the next one) the nodes before the first
+        notifying helper are still valid and only the following ones
+        are solved again; global interpolations, a change of the
+        pillar dates or notifications coming from other observables
+        trigger a full bootstrap.
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
@@ -44,16 +54,60 @@ namespace QuantLib {
         IterativeBootstrap();
         void setup(Curve* ts);
         void calculate() const;
+        //! Jacobian of the implied quotes of the alive helpers
+        /*! rows correspond to the alive helpers, columns to the
+            curve nodes after the reference date, i.e., to
+            data()[1], data()[2], ...  It is calculated by finite
+            differences on first use after each bootstrap; for local
+            interpolations it is lower triangular and only the
+            non-zero elements are evaluated.
+        */
+        const Matrix& jacobian() const;
+        //! index of the first helper which is not expired
+        Size firstAliveHelper() const;
       private:
+        class HelperObserver : public Observer {
+          public:
+            explicit HelperObserver(
+                const boost::shared_ptr<typename Traits::helper>& helper)
+            : helper_(helper), notified_(false) {
+                registerWith(helper_);
+            }
+            void update() { notified_ = true; }
+            const boost::shared_ptr<typename Traits::helper>& helper() const {
+                return helper_;
+            }
+            bool notified() const { return notified_; }
+            void reset() { notified_ = false; }
+          private:
+            boost::shared_ptr<typename Traits::helper> helper_;
+            bool notified_;
+        };
+        // registered with the observables of the curve except the helpers
+        class CurveObserver : public Observer {
+          public:
+            CurveObserver() : notified_(false) {}
+            void update() { notified_ = true; }
+            bool notified() const { return notified_; }
+            void reset() { notified_ = false; }
+          private:
+            bool notified_;
+        };
+        static void noDeletion(Observer*) {}
+        void registerCurveObserver() const;
         void initialize() const;
+        Size firstChangedPillar() const;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
-        mutable bool initialized_, validCurve_;
+        mutable bool initialized_, validCurve_, validJacobian_;
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
+        mutable Matrix jacobian_;
         mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+        std::vector<boost::shared_ptr<HelperObserver> > helperObservers_;
+        boost::shared_ptr<CurveObserver> curveObserver_;
     };
 
 
@@ -61,7 +115,7 @@ namespace QuantLib {
 
     template <class Curve>
     IterativeBootstrap<Curve>::IterativeBootstrap()
-        : ts_(0), initialized_(false), validCurve_(false) {}
+        : ts_(0), initialized_(false), validCurve_(false), validJacobian_(false) {}
 
     template <class Curve>
     void IterativeBootstrap<Curve>::setup(Curve* ts) {
@@ -69,8 +123,14 @@ namespace QuantLib {
         ts_ = ts;
         n_ = ts_->instruments_.size();
         QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
-        for (Size j=0; j<n_; ++j)
+        helperObservers_.clear();
+        for (Size j=0; j<n_; ++j) {
             ts_->registerWith(ts_->instruments_[j]);
+            helperObservers_.push_back(boost::shared_ptr<HelperObserver>(
+                             new HelperObserver(ts_->instruments_[j])));
+        }
+        curveObserver_ = boost::shared_ptr<CurveObserver>(new CurveObserver);
+        registerCurveObserver();
 
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
@@ -128,6 +188,43 @@ namespace QuantLib {
         initialized_ = true;
     }
 
+    template <class Curve>
+    void IterativeBootstrap<Curve>::registerCurveObserver() const {
+        // the curve might have registered with further observables
+        // since the last time
+        boost::shared_ptr<Observer> curve(ts_, &IterativeBootstrap::noDeletion);
+        curveObserver_->registerWithObservables(curve);
+        for (Size j=0; j<n_; ++j)
+            curveObserver_->unregisterWith(ts_->instruments_[j]);
+    }
+
+    template <class Curve>
+    Size IterativeBootstrap<Curve>::firstChangedPillar() const {
+        // a change in anything but the helpers (e.g., jumps) can
+        // affect all the nodes
+        if (curveObserver_->notified())
+            return 1;
+
+        // pillar i is bootstrapped on helper firstAliveHelper_+i-1
+        Size firstPillar = alive_+1;
+        bool notified = false;
+        for (Size k=0; k<helperObservers_.size(); ++k) {
+            if (!helperObservers_[k]->notified())
+                continue;
+            notified = true;
+            for (Size j=firstAliveHelper_; j<n_; ++j) {
+                if (ts_->instruments_[j] == helperObservers_[k]->helper()) {
+                    firstPillar = std::min(firstPillar,
+                                           j-firstAliveHelper_+1);
+                    break;
+                }
+            }
+        }
+        // without any helper notification the recalculation was
+        // triggered by something else, e.g. jumps
+        return notified ? firstPillar : 1;
+    }
+
     template <class Curve>
     void IterativeBootstrap<Curve>::calculate() const {
 
@@ -136,8 +233,13 @@ namespace QuantLib {
         // with evaluation date change.
         // anyway it makes little sense to use date relative helpers with a
         // non-moving curve if the evaluation date changes
-        if (!initialized_ || ts_->moving_)
+        bool sameDates = initialized_;
+        validJacobian_ = false;
+        if (!initialized_ || ts_->moving_) {
+            const std::vector<Date> previousDates = ts_->dates_;
             initialize();
+            sameDates = sameDates && (ts_->dates_ == previousDates);
+        }
 
         // setup helpers
         for (Size j=firstAliveHelper_; j<n_; ++j) {
@@ -153,6 +255,16 @@ namespace QuantLib {
             helper->setTermStructure(const_cast<Curve*>(ts_));
         }
 
+        // with a local interpolation, the nodes before the first
+        // helper that changed can be kept
+        Size firstPillar = 1;
+        if (!Interpolator::global && validCurve_ && sameDates)
+            firstPillar = firstChangedPillar();
+        for (Size k=0; k<helperObservers_.size(); ++k)
+            helperObservers_[k]->reset();
+        registerCurveObserver();
+        curveObserver_->reset();
+
         const std::vector<Time>& times = ts_->times_;
         const std::vector<Real>& data = ts_->data_;
         Real accuracy = ts_->accuracy_;
@@ -165,7 +277,7 @@ namespace QuantLib {
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 // bracket root and calculate guess
                 Real min = Traits::minValueAfter(i, ts_, validData,
@@ -208,6 +320,12 @@ namespace QuantLib {
                     // let's restart without using it
                     if (validCurve_) {
                         validCurve_ = validData = false;
+                        // start from scratch if only the last
+                        // nodes were being solved
+                        if (firstPillar > 1) {
+                            firstPillar = 1;
+                            i = 0;
+                        }
                         continue;
                     }
                     QL_FAIL(io::ordinal(iteration+1) << " iteration: failed "
@@ -238,6 +356,61 @@ namespace QuantLib {
         validCurve_ = true;
     }
 
+    template <class Curve>
+    const Matrix& IterativeBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped yet");
+        if (validJacobian_)
+            return jacobian_;
+
+        // the helpers might have been bootstrapped on another curve
+        // since; they must price on this one
+        for (Size j=firstAliveHelper_; j<n_; ++j)
+            ts_->instruments_[j]->setTermStructure(const_cast<Curve*>(ts_));
+
+        std::vector<Real>& data = ts_->data_;
+        const std::vector<Real> nodes = data;
+        jacobian_ = Matrix(alive_, alive_, 0.0);
+        try {
+            for (Size k=1; k<=alive_; ++k) {
+                const Real x = nodes[k];
+                const Real h = 1.0e-7*std::max(1.0, std::fabs(x));
+                // with a local interpolation the k-th node does not
+                // affect the helpers of the previous pillars
+                const Size first = Interpolator::global ? 1 : k;
+
+                Traits::updateGuess(data, x+h, k);
+                ts_->interpolation_.update();
+                for (Size i=first; i<=alive_; ++i)
+                    jacobian_[i-1][k-1] = ts_->instruments_[
+                                    firstAliveHelper_+i-1]->impliedQuote();
+
+                Traits::updateGuess(data, x-h, k);
+                ts_->interpolation_.update();
+                for (Size i=first; i<=alive_; ++i)
+                    jacobian_[i-1][k-1] = (jacobian_[i-1][k-1]
+                        - ts_->instruments_[
+                                    firstAliveHelper_+i-1]->impliedQuote())
+                        /(2.0*h);
+
+                Traits::updateGuess(data, x, k);
+            }
+        } catch (...) {
+            // don't leave the curve with a bumped node
+            std::copy(nodes.begin(), nodes.end(), data.begin());
+            ts_->interpolation_.update();
+            throw;
+        }
+        ts_->interpolation_.update();
+        validJacobian_ = true;
+
+        return jacobian_;
+    }
+
+    template <class Curve>
+    Size IterativeBootstrap<Curve>::firstAliveHelper() const {
+        return firstAliveHelper_;
+    }
+
 }
 
 #endif
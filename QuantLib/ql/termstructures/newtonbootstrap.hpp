@@ -0,0 +1,409 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file newtonbootstrap.hpp
+    \brief global Newton bootstrapper for piecewise term structures
+*/
+
+#ifndef quantlib_newton_bootstrap_hpp
+#define quantlib_newton_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/termstructures/bootstraperror.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <ql/utilities/dataformatters.hpp>
+
+namespace QuantLib {
+
+    //! Global Newton bootstrapper for piecewise term structures
+    /*! Instead of solving pillar by pillar, all pillar values are
+        solved simultaneously as the root of the vector of helper
+        quote errors. The Newton iteration uses the Jacobian
+        \f[ J_{jk} = \frac{\partial q_j}{\partial x_k} \f]
+        of the helper implied quotes \f$ q_j \f$ with respect to the
+        curve nodes \f$ x_k \f$.
+
+        Bootstrap helpers do not provide derivatives; the Jacobian is
+        therefore calculated by central finite differences the first
+        time the curve is bootstrapped and kept up to date by Broyden
+        rank-one updates during the following iterations and
+        re-bootstraps. A full recalculation is triggered whenever a
+        Newton step fails to reduce the quote errors. When the quotes
+        move by small amounts, as is the case for intraday ticks, the
+        curve is usually rebuilt within a couple of Newton steps,
+        i.e., by repricing each helper just a few times. This holds
+        for global interpolation schemes as well, which require
+        repeated sweeps over all the pillars with IterativeBootstrap.
+
+        The first bootstrap of the curve is started from a sequential
+        pillar-by-pillar guess.
+
+        The Jacobian is available after the curve was bootstrapped.
+        Since the one used by the solver is kept up to date by Broyden
+        updates, it is recalculated by finite differences at the
+        solution when requested, unless it is already exact.
+    */
+    template <class Curve>
+    class NewtonBootstrap {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+      public:
+        NewtonBootstrap(Size maxIterations = 50,
+                        Real finiteDifferenceStep = 1.0e-7);
+        void setup(Curve* ts);
+        void calculate() const;
+        //! Jacobian of the implied quotes of the alive helpers
+        /*! rows correspond to the alive helpers, columns to the
+            curve nodes after the reference date, i.e., to
+            data()[1], data()[2], ...  It is calculated by finite
+            differences at the bootstrapped nodes.
+        */
+        const Matrix& jacobian() const;
+        //! number of helpers expired at the curve reference date
+        Size firstAliveHelper() const;
+      private:
+        void calculateJacobian() const;
+        void initialize() const;
+        void sequentialGuess() const;
+        void setNodes(const Array& x) const;
+        Disposable<Array> residuals() const;
+        Real maxAbs(const Array& a) const;
+        Curve* ts_;
+        Size n_, maxIterations_;
+        Real finiteDifferenceStep_;
+        Brent firstSolver_;
+        mutable bool initialized_, validCurve_, validJacobian_;
+        // whether jacobian_ was calculated at the current nodes
+        mutable bool exactJacobian_;
+        mutable Size firstAliveHelper_, alive_;
+        mutable Matrix jacobian_;
+        mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    NewtonBootstrap<Curve>::NewtonBootstrap(Size maxIterations,
+                                            Real finiteDifferenceStep)
+    : ts_(0), maxIterations_(maxIterations),
+      finiteDifferenceStep_(finiteDifferenceStep),
+      initialized_(false), validCurve_(false), validJacobian_(false),
+      exactJacobian_(false), firstAliveHelper_(0), alive_(0) {}
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
+        for (Size j=0; j<n_; ++j)
+            ts_->registerWith(ts_->instruments_[j]);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::initialize() const {
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_[n_-1]->latestDate()>firstDate,
+                   "all instruments expired");
+        firstAliveHelper_ = 0;
+        while (ts_->instruments_[firstAliveHelper_]->latestDate() <= firstDate)
+            ++firstAliveHelper_;
+        const Size alive = n_-firstAliveHelper_;
+        QL_REQUIRE(alive>=Interpolator::requiredPoints-1,
+                   "not enough alive instruments: " << alive <<
+                   " provided, " << Interpolator::requiredPoints-1 <<
+                   " required");
+        if (alive != alive_)
+            validJacobian_ = false;
+        alive_ = alive;
+
+        // calculate dates and times, create errors_
+        std::vector<Date>& dates = ts_->dates_;
+        std::vector<Time>& times = ts_->times_;
+        dates.resize(alive_+1);
+        times.resize(alive_+1);
+        errors_.resize(alive_+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(dates[0]);
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            dates[i] = helper->latestDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            // check for duplicated maturity
+            QL_REQUIRE(dates[i-1]!=dates[i],
+                       "more than one instrument with maturity " << dates[i]);
+            errors_[i] = boost::shared_ptr<BootstrapError<Curve> >(new
+                BootstrapError<Curve>(ts_, helper, i));
+        }
+
+        // set initial guess only if the current curve cannot be used as guess
+        if (!validCurve_ || ts_->data_.size()!=alive_+1) {
+            ts_->data_ = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
+            validCurve_ = false;
+        }
+        initialized_ = true;
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::sequentialGuess() const {
+        const std::vector<Time>& times = ts_->times_;
+        const std::vector<Real>& data = ts_->data_;
+
+        for (Size i=1; i<=alive_; ++i) {
+            Real min = Traits::minValueAfter(i, ts_, false, firstAliveHelper_);
+            Real max = Traits::maxValueAfter(i, ts_, false, firstAliveHelper_);
+            Real guess = Traits::guess(i, ts_, false, firstAliveHelper_);
+            if (guess>=max)
+                guess = max - (max-min)/5.0;
+            else if (guess<=min)
+                guess = min + (max-min)/5.0;
+
+            // extend interpolation a point at a time; global schemes
+            // are replaced by linear interpolation as long as they are
+            // not usable yet. The Newton iteration will fix the nodes.
+            try {
+                ts_->interpolation_ = ts_->interpolator_.interpolate(
+                    times.begin(), times.begin()+i+1, data.begin());
+            } catch (...) {
+                if (!Interpolator::global)
+                    throw;
+                ts_->interpolation_ = Linear().interpolate(
+                    times.begin(), times.begin()+i+1, data.begin());
+            }
+            ts_->interpolation_.update();
+
+            try {
+                firstSolver_.solve(*errors_[i], ts_->accuracy_,
+                                   guess, min, max);
+            } catch (std::exception& e) {
+                QL_FAIL("initial guess failed at " << io::ordinal(i) <<
+                        " alive instrument, maturity " <<
+                        errors_[i]->helper()->latestDate() <<
+                        ", reference date " << ts_->dates_[0] <<
+                        ": " << e.what());
+            }
+        }
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::setNodes(const Array& x) const {
+        for (Size i=0; i<alive_; ++i)
+            Traits::updateGuess(ts_->data_, x[i], i+1);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    Disposable<Array> NewtonBootstrap<Curve>::residuals() const {
+        Array r(alive_);
+        for (Size i=0; i<alive_; ++i)
+            r[i] = -ts_->instruments_[firstAliveHelper_+i]->quoteError();
+        return r;
+    }
+
+    template <class Curve>
+    Real NewtonBootstrap<Curve>::maxAbs(const Array& a) const {
+        Real m = 0.0;
+        for (Size i=0; i<a.size(); ++i) {
+            // a NaN must not pass as a small error
+            if (!(std::fabs(a[i]) <= m))
+                m = (a[i] == a[i]) ? std::fabs(a[i]) : QL_MAX_REAL;
+        }
+        return m;
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::calculateJacobian() const {
+        // the helpers might have been bootstrapped on another curve
+        // since; they must price on this one
+        for (Size j=firstAliveHelper_; j<n_; ++j)
+            ts_->instruments_[j]->setTermStructure(const_cast<Curve*>(ts_));
+
+        Array x(alive_);
+        for (Size i=0; i<alive_; ++i)
+            x[i] = ts_->data_[i+1];
+
+        const Array nodes = x;
+
+        Matrix jacobian(alive_, alive_);
+        try {
+            for (Size k=0; k<alive_; ++k) {
+                const Real h =
+                    finiteDifferenceStep_*std::max(1.0,std::fabs(x[k]));
+
+                x[k] += h;
+                setNodes(x);
+                const Array up = residuals();
+                x[k] -= 2.0*h;
+                setNodes(x);
+                const Array down = residuals();
+                x[k] = nodes[k];
+
+                for (Size j=0; j<alive_; ++j)
+                    jacobian[j][k] = (up[j] - down[j])/(2.0*h);
+            }
+        } catch (...) {
+            // don't leave the curve with a bumped node
+            setNodes(nodes);
+            throw;
+        }
+        setNodes(nodes);
+        jacobian_.swap(jacobian);
+        validJacobian_ = exactJacobian_ = true;
+    }
+
+    template <class Curve>
+    void NewtonBootstrap<Curve>::calculate() const {
+
+        if (!initialized_ || ts_->moving_)
+            initialize();
+
+        // setup helpers
+        for (Size j=firstAliveHelper_; j<n_; ++j) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            // check for valid quote
+            QL_REQUIRE(helper->quote()->isValid(),
+                       io::ordinal(j+1) << " instrument (maturity: " <<
+                       helper->latestDate() << ") has an invalid quote");
+            // don't try this at home!
+            // This call creates helpers, and removes "const".
+            // There is a significant interaction with observability.
+            helper->setTermStructure(const_cast<Curve*>(ts_));
+        }
+
+        if (!validCurve_)
+            sequentialGuess();
+
+        // the nodes are solved all at once on the full interpolation
+        ts_->interpolation_ = ts_->interpolator_.interpolate(
+            ts_->times_.begin(), ts_->times_.end(), ts_->data_.begin());
+        ts_->interpolation_.update();
+        validCurve_ = false;
+
+        Array x(alive_);
+        for (Size i=0; i<alive_; ++i)
+            x[i] = ts_->data_[i+1];
+        Array r = residuals();
+        Real error = maxAbs(r);
+
+        exactJacobian_ = false;
+        if (!validJacobian_)
+            calculateJacobian();
+        bool freshJacobian = true;
+
+        for (Size iteration=0; ; ++iteration) {
+            QL_REQUIRE(iteration < maxIterations_,
+                       "convergence not reached after " << iteration <<
+                       " iterations; last quote error " << error);
+
+            const Array dx = qrSolve(jacobian_, -r);
+            // the Newton step estimates the distance to the solution;
+            // it is only trusted when the quotes are repriced as well
+            if (maxAbs(dx) <= ts_->accuracy_) {
+                if (error <= ts_->accuracy_)
+                    break;
+                // a small step from an approximate Jacobian might just
+                // be a poor estimate; retry with the exact one
+                if (!freshJacobian) {
+                    calculateJacobian();
+                    freshJacobian = true;
+                    continue;
+                }
+            }
+
+            // backtracking line search on the maximum quote error
+            Real lambda = 1.0, newError = QL_MAX_REAL;
+            Array xNew, rNew;
+            for (Size k=0; k<8; ++k, lambda*=0.5) {
+                xNew = x + lambda*dx;
+                try {
+                    setNodes(xNew);
+                    rNew = residuals();
+                    newError = maxAbs(rNew);
+                } catch (std::exception&) {
+                    newError = QL_MAX_REAL;
+                }
+                if (newError < error || newError == 0.0)
+                    break;
+            }
+
+            if (!(newError < error || newError == 0.0)) {
+                setNodes(x);
+                // an approximate Jacobian might be responsible
+                QL_REQUIRE(!freshJacobian,
+                           io::ordinal(iteration+1) << " iteration: "
+                           "unable to reduce the quote error " << error <<
+                           ", reference date " << ts_->dates_[0]);
+                calculateJacobian();
+                freshJacobian = true;
+                continue;
+            }
+
+            const Array s = xNew - x;
+
+            // Broyden rank-one update of the Jacobian
+            const Array y = rNew - r;
+            const Array js = jacobian_*s;
+            const Real ss = DotProduct(s, s);
+            if (ss > 0.0) {
+                for (Size j=0; j<alive_; ++j) {
+                    const Real c = (y[j] - js[j])/ss;
+                    for (Size k=0; k<alive_; ++k)
+                        jacobian_[j][k] += c*s[k];
+                }
+            }
+            freshJacobian = exactJacobian_ = false;
+
+            x.swap(xNew);
+            r.swap(rNew);
+            error = newError;
+
+            if (error == 0.0)
+                break;
+        }
+        validCurve_ = true;
+    }
+
+    template <class Curve>
+    const Matrix& NewtonBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped yet");
+        // Broyden updates only approximate it
+        if (!exactJacobian_)
+            calculateJacobian();
+        return jacobian_;
+    }
+
+    template <class Curve>
+    Size NewtonBootstrap<Curve>::firstAliveHelper() const {
+        return firstAliveHelper_;
+    }
+
+}
+
+#endif
@@ -70,6 +70,7 @@ namespace QuantLib {
         const std::vector<Date>& dates() const;
         const std::vector<Real>& data() const;
         const std::vector<DiscountFactor>& discounts() const;
+        using YieldTermStructure::discounts;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
       protected:
@@ -94,6 +95,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, Size n, DiscountFactor* out) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -165,6 +167,19 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(
+                           const Time* t, Size n, DiscountFactor* out) const {
+        // non-virtual calls; sorted times are located in constant time
+        Size hint = 0;
+        for (Size i=0; i<n; ++i) {
+            if (t[i] <= this->times_.back())
+                out[i] = this->interpolation_(t[i], hint, true);
+            else
+                out[i] = InterpolatedDiscountCurve<T>::discountImpl(t[i]);
+        }
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
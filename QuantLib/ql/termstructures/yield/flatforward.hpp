@@ -84,6 +84,7 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, Size n, DiscountFactor* out) const;
         //@}
 
         Handle<Quote> forward_;
@@ -103,6 +104,13 @@ namespace QuantLib {
         calculate();
         return rate_.discountFactor(t);
     }
+
+    inline void FlatForward::discountsImpl(const Time* t, Size n,
+                                           DiscountFactor* out) const {
+        calculate();
+        for (Size i=0; i<n; ++i)
+            out[i] = rate_.discountFactor(t[i]);
+    }
   
     inline void FlatForward::performCalculations() const {
         rate_ = InterestRate(forward_->value(), dayCounter(),
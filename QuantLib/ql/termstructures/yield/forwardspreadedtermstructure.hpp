@@ -67,6 +67,10 @@ namespace QuantLib {
         /* This method must disappear should the spread become a curve */
         Rate zeroYieldImpl(Time t) const;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const Time* t, Size n, DiscountFactor* out) const;
+        //@}
       private:
         Handle<YieldTermStructure> originalCurve_;
         Handle<Quote> spread_;
@@ -126,6 +130,16 @@ namespace QuantLib {
             + spread_->value();
     }
 
+    inline void ForwardSpreadedTermStructure::discountsImpl(
+                           const Time* t, Size n, DiscountFactor* out) const {
+        // a constant continuous spread multiplies the original
+        // discount factors by exp(-spread*t)
+        originalCurve_->discounts(std::vector<Time>(t, t+n), out, true);
+        const Spread spread = spread_->value();
+        for (Size i=0; i<n; ++i)
+            out[i] *= std::exp(-spread*t[i]);
+    }
+
 }
 
 #endif
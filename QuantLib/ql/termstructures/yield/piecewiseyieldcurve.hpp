@@ -28,6 +28,7 @@
 
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
+#include <ql/termstructures/newtonbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 
@@ -166,6 +167,25 @@ namespace QuantLib {
         const std::vector<Date>& dates() const;
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
+        //! the interpolator used between the nodes
+        const Interpolator& interpolator() const;
+        //@}
+        //! \name Bootstrap results
+        //@{
+        /*! Jacobian of the implied quotes of the alive helpers with
+            respect to the curve nodes after the reference date.
+
+            \pre the bootstrap policy must provide it, as is the case
+                 for IterativeBootstrap and NewtonBootstrap.
+        */
+        const Matrix& jacobian() const;
+        /*! sensitivities of the curve nodes after the reference date
+            (rows) with respect to the quotes of the alive helpers
+            (columns), i.e., the inverse of the Jacobian. They allow
+            to obtain quote sensitivities from node sensitivities
+            without bootstrapping the curve again.
+        */
+        Disposable<Matrix> nodeSensitivities() const;
         //@}
         //! \name Observer interface
         //@{
@@ -178,6 +198,7 @@ namespace QuantLib {
         //@}
         // methods
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const Time* t, Size n, DiscountFactor* out) const;
         // data members
         std::vector<boost::shared_ptr<typename Traits::helper> > instruments_;
         Real accuracy_;
@@ -226,6 +247,22 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const I& PiecewiseYieldCurve<C,I,B>::interpolator() const {
+        return this->interpolator_;
+    }
+
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseYieldCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
+    template <class C, class I, template <class> class B>
+    inline Disposable<Matrix> PiecewiseYieldCurve<C,I,B>::nodeSensitivities() const {
+        return inverse(jacobian());
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
@@ -247,6 +284,13 @@ namespace QuantLib {
         return base_curve::discountImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseYieldCurve<C,I,B>::discountsImpl(
+                           const Time* t, Size n, DiscountFactor* out) const {
+        calculate();
+        base_curve::discountsImpl(t, n, out);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::performCalculations() const {
         // just delegate to the bootstrapper
@@ -103,6 +103,10 @@ namespace QuantLib {
         //@{
         Rate zeroYieldImpl(Time t) const;
         //@}
+        //! \name YieldTermStructure implementation
+        //@{
+        void discountsImpl(const Time* t, Size n, DiscountFactor* out) const;
+        //@}
         mutable std::vector<Date> dates_;
       private:
         void initialize(const Compounding& compounding, const Frequency& frequency);
@@ -167,6 +171,24 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::discountsImpl(
+                           const Time* t, Size n, DiscountFactor* out) const {
+        // same as ZeroYieldStructure::discountImpl, without virtual
+        // calls; sorted times are located in constant time
+        Size hint = 0;
+        for (Size i=0; i<n; ++i) {
+            if (t[i] == 0.0) {
+                out[i] = 1.0;
+            } else {
+                Rate r = t[i] <= this->times_.back() ?
+                    Rate(this->interpolation_(t[i], hint, true)) :
+                    InterpolatedZeroCurve<T>::zeroYieldImpl(t[i]);
+                out[i] = DiscountFactor(std::exp(-r*t[i]));
+            }
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
@@ -69,6 +69,8 @@ namespace QuantLib {
         //! returns the spreaded forward rate
         /* This method must disappear should the spread become a curve */
         Rate forwardImpl(Time) const;
+        //! returns the spreaded discount factors
+        void discountsImpl(const Time* t, Size n, DiscountFactor* out) const;
       private:
         Handle<YieldTermStructure> originalCurve_;
         Handle<Quote> spread_;
@@ -138,6 +140,20 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    inline void ZeroSpreadedTermStructure::discountsImpl(
+                           const Time* t, Size n, DiscountFactor* out) const {
+        if (comp_ != Continuous) {
+            ZeroYieldStructure::discountsImpl(t, n, out);
+            return;
+        }
+        // a continuous spread multiplies the original discount
+        // factors by exp(-spread*t)
+        originalCurve_->discounts(std::vector<Time>(t, t+n), out, true);
+        const Spread spread = spread_->value();
+        for (Size i=0; i<n; ++i)
+            out[i] *= std::exp(-spread*t[i]);
+    }
+
     inline Rate ZeroSpreadedTermStructure::forwardImpl(Time t) const {
         return originalCurve_->forwardRate(t, t, comp_, freq_, true)
             + spread_->value();
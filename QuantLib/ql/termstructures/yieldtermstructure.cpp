@@ -93,6 +93,10 @@ namespace QuantLib {
         if (jumps_.empty())
             return discountImpl(t);
 
+        return jumpEffect(t) * discountImpl(t);
+    }
+
+    DiscountFactor YieldTermStructure::jumpEffect(Time t) const {
         DiscountFactor jumpEffect = 1.0;
         for (Size i=0; i<nJumps_; ++i) {
             if (jumpTimes_[i]>0 && jumpTimes_[i]<t) {
@@ -105,8 +109,31 @@ namespace QuantLib {
                 jumpEffect *= thisJump;
             }
         }
-        return jumpEffect * discountImpl(t);
+        return jumpEffect;
+    }
+
+    void YieldTermStructure::discounts(const std::vector<Time>& t,
+                                       DiscountFactor* out,
+                                       bool extrapolate) const {
+        const Size n = t.size();
+        if (n == 0)
+            return;
 
+        for (Size i=0; i<n; ++i)
+            checkRange(t[i], extrapolate);
+
+        discountsImpl(&t[0], n, out);
+
+        if (!jumps_.empty()) {
+            for (Size i=0; i<n; ++i)
+                out[i] *= jumpEffect(t[i]);
+        }
+    }
+
+    void YieldTermStructure::discountsImpl(const Time* t, Size n,
+                                           DiscountFactor* out) const {
+        for (Size i=0; i<n; ++i)
+            out[i] = discountImpl(t[i]);
     }
 
     InterestRate YieldTermStructure::zeroRate(const Date& d,
@@ -184,6 +211,37 @@ namespace QuantLib {
                                          t2-t1);
     }
 
+    void YieldTermStructure::forwardRates(const std::vector<Time>& t1,
+                                          const std::vector<Time>& t2,
+                                          Compounding comp,
+                                          Frequency freq,
+                                          Rate* out,
+                                          bool extrapolate) const {
+        QL_REQUIRE(t1.size() == t2.size(),
+                   "size mismatch between start (" << t1.size() <<
+                   ") and end (" << t2.size() << ") times");
+        const Size n = t1.size();
+        if (n == 0)
+            return;
+
+        std::vector<DiscountFactor> d1(n), d2(n);
+        discounts(t1, &d1[0], extrapolate);
+        discounts(t2, &d2[0], extrapolate);
+        for (Size i=0; i<n; ++i) {
+            if (t1[i] == t2[i]) {
+                // instantaneous forward, see forwardRate()
+                out[i] = forwardRate(t1[i], t2[i], comp, freq,
+                                     extrapolate).rate();
+            } else {
+                QL_REQUIRE(t2[i]>t1[i],
+                           "t2 (" << t2[i] << ") < t1 (" << t1[i] << ")");
+                out[i] = InterestRate::impliedRate(d1[i]/d2[i],
+                                                   dayCounter(), comp, freq,
+                                                   t2[i]-t1[i]).rate();
+            }
+        }
+    }
+
     void YieldTermStructure::update() {
         TermStructure::update();
         Date newReference = Date();
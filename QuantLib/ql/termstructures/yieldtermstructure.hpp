@@ -77,6 +77,14 @@ namespace QuantLib {
         */
         DiscountFactor discount(Time t,
                                 bool extrapolate = false) const;
+        /*! writes the discount factors for the given times to the
+            array starting at out, which must have room for t.size()
+            elements.  When the times are sorted, interpolated curves
+            locate each of them in constant time.
+        */
+        void discounts(const std::vector<Time>& t,
+                       DiscountFactor* out,
+                       bool extrapolate = false) const;
         //@}
 
         /*! \name Zero-yield rates
@@ -144,6 +152,18 @@ namespace QuantLib {
                                  Compounding comp,
                                  Frequency freq = Annual,
                                  bool extrapolate = false) const;
+
+        /*! writes the forward rates between t1[i] and t2[i] to the
+            array starting at out, which must have room for t1.size()
+            elements. The rates have the same day-counting rule used
+            by the term structure.
+        */
+        void forwardRates(const std::vector<Time>& t1,
+                          const std::vector<Time>& t2,
+                          Compounding comp,
+                          Frequency freq,
+                          Rate* out,
+                          bool extrapolate = false) const;
         //@}
 
         //! \name Jump inspectors
@@ -167,10 +187,18 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        //! discount factor calculation for n times
+        /*! The default implementation calls discountImpl() for each
+            time; derived classes can override it to save the virtual
+            calls and any per-call overhead.
+        */
+        virtual void discountsImpl(const Time* t, Size n,
+                                   DiscountFactor* out) const;
         //@}
       private:
         // methods
         void setJumps();
+        DiscountFactor jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
@@ -72,4 +72,13 @@
 //#   define QL_ENABLE_SESSIONS
 #endif
 
+/* Define this to make registration, unregistration and notification
+   of observers, as well as the creation of singleton instances, safe
+   to use from multiple threads. Together with QL_ENABLE_SESSIONS, it
+   allows to have per-thread settings. It requires linking with the
+   Boost thread library. */
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+//#   define QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+#endif
+
 #endif
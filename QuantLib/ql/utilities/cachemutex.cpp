@@ -0,0 +1,71 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/cachemutex.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/thread/mutex.hpp>
+#elif defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    namespace detail {
+
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+
+        class CacheMutex::Impl {
+          public:
+            void lock() { mutex_.lock(); }
+            void unlock() { mutex_.unlock(); }
+          private:
+            boost::mutex mutex_;
+        };
+
+        #elif defined(_OPENMP)
+
+        class CacheMutex::Impl {
+          public:
+            Impl() { omp_init_lock(&lock_); }
+            ~Impl() { omp_destroy_lock(&lock_); }
+            void lock() { omp_set_lock(&lock_); }
+            void unlock() { omp_unset_lock(&lock_); }
+          private:
+            omp_lock_t lock_;
+        };
+
+        #else
+
+        class CacheMutex::Impl {
+          public:
+            void lock() {}
+            void unlock() {}
+        };
+
+        #endif
+
+        CacheMutex::CacheMutex() : impl_(new Impl) {}
+
+        CacheMutex::~CacheMutex() { delete impl_; }
+
+        void CacheMutex::lock() { impl_->lock(); }
+
+        void CacheMutex::unlock() { impl_->unlock(); }
+
+    }
+
+}
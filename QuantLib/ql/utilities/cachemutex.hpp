@@ -0,0 +1,63 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cachemutex.hpp
+    \brief mutex guarding lazily filled caches
+*/
+
+#ifndef quantlib_cache_mutex_hpp
+#define quantlib_cache_mutex_hpp
+
+#include <ql/qldefines.hpp>
+#include <boost/noncopyable.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! mutex guarding lazily filled caches
+        /*! It is a boost::mutex when the thread-safe observer pattern
+            is enabled, and an OpenMP lock when the library is compiled
+            with OpenMP; otherwise, it does nothing.  The implementation
+            is kept in the source file, so that the header brings in
+            neither Boost.Thread nor OpenMP.
+        */
+        class CacheMutex : private boost::noncopyable {
+          public:
+            CacheMutex();
+            ~CacheMutex();
+            void lock();
+            void unlock();
+
+            class scoped_lock : private boost::noncopyable {
+              public:
+                explicit scoped_lock(CacheMutex& m) : m_(m) { m_.lock(); }
+                ~scoped_lock() { m_.unlock(); }
+              private:
+                CacheMutex& m_;
+            };
+          private:
+            class Impl;
+            Impl* impl_;
+        };
+
+    }
+
+}
+
+
+#endif
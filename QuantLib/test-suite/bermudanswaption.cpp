@@ -28,6 +28,7 @@
 #include <ql/time/daycounters/thirty360.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/time/schedule.hpp>
+#include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -225,9 +226,125 @@ void BermudanSwaptionTest::testCachedValues() {
 }
 
 
+void BermudanSwaptionTest::testTreeCache() {
+
+    BOOST_TEST_MESSAGE("Testing Bermudan swaptions on a shared tree...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    boost::shared_ptr<SimpleQuote> rate(new SimpleQuote(0.04875825));
+    vars.termStructure.linkTo(flatRate(vars.settlement, rate,
+                                       Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+
+    std::vector<boost::shared_ptr<VanillaSwap> > swaps;
+    swaps.push_back(vars.makeSwap(0.8*atmRate));
+    swaps.push_back(vars.makeSwap(atmRate));
+    swaps.push_back(vars.makeSwap(1.2*atmRate));
+
+    Real a = 0.048696, sigma = 0.0058904;
+    boost::shared_ptr<HullWhite> model(new HullWhite(vars.termStructure,
+                                                     a, sigma));
+
+    // common grid containing the coupon dates of all the swaps
+    Date referenceDate = vars.termStructure->referenceDate();
+    DayCounter dayCounter = vars.termStructure->dayCounter();
+    std::vector<Date> exerciseDates;
+    std::vector<Time> times;
+    for (Size k=0; k<swaps.size(); ++k) {
+        const Leg* legs[] = { &swaps[k]->fixedLeg(),
+                              &swaps[k]->floatingLeg() };
+        for (Size l=0; l<2; ++l) {
+            for (Size i=0; i<legs[l]->size(); ++i) {
+                boost::shared_ptr<Coupon> coupon =
+                    boost::dynamic_pointer_cast<Coupon>((*legs[l])[i]);
+                times.push_back(dayCounter.yearFraction(
+                             referenceDate, coupon->accrualStartDate()));
+                times.push_back(dayCounter.yearFraction(
+                             referenceDate, coupon->date()));
+                if (k == 0 && l == 0)
+                    exerciseDates.push_back(coupon->accrualStartDate());
+            }
+        }
+    }
+    TimeGrid grid(times.begin(), times.end(), 50);
+    boost::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+
+    boost::shared_ptr<Lattice> tree = model->cachedTree(grid);
+    if (model->cachedTree(TimeGrid(times.begin(), times.end(), 50)) != tree)
+        BOOST_ERROR("tree not shared for equal time grids");
+
+    std::vector<boost::shared_ptr<Swaption> > swaptions;
+    for (Size k=0; k<swaps.size(); ++k) {
+        swaptions.push_back(boost::shared_ptr<Swaption>(
+                                         new Swaption(swaps[k], exercise)));
+        swaptions.back()->setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                      new TreeSwaptionEngine(model, grid)));
+        swaptions.back()->NPV();
+    }
+
+    if (model->cachedTree(grid) != tree)
+        BOOST_ERROR("tree rebuilt while pricing");
+
+    Real tolerance = 1.0e-10;
+
+    // a change in the market must discard the cached tree
+    rate->setValue(0.05);
+    if (model->cachedTree(grid) == tree)
+        BOOST_ERROR("cached tree not discarded after market change");
+
+    boost::shared_ptr<HullWhite> freshModel(
+                              new HullWhite(vars.termStructure, a, sigma));
+    boost::shared_ptr<PricingEngine> freshEngine(
+                                 new TreeSwaptionEngine(freshModel, grid));
+    for (Size k=0; k<swaptions.size(); ++k) {
+        Swaption swaption(swaps[k], exercise);
+        swaption.setPricingEngine(freshEngine);
+        Real expected = swaption.NPV();
+        Real calculated = swaptions[k]->NPV();
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reprice swaption after market change:"
+                        << QL_FIXED << std::setprecision(10)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    // and so must a change in the model parameters
+    tree = model->cachedTree(grid);
+    Array params = model->params();
+    params[1] *= 1.1;
+    model->setParams(params);
+    if (model->cachedTree(grid) == tree)
+        BOOST_ERROR("cached tree not discarded after parameter change");
+
+    freshModel = boost::shared_ptr<HullWhite>(
+                        new HullWhite(vars.termStructure, a, 1.1*sigma));
+    freshEngine = boost::shared_ptr<PricingEngine>(
+                                 new TreeSwaptionEngine(freshModel, grid));
+    for (Size k=0; k<swaptions.size(); ++k) {
+        Swaption swaption(swaps[k], exercise);
+        swaption.setPricingEngine(freshEngine);
+        Real expected = swaption.NPV();
+        Real calculated = swaptions[k]->NPV();
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reprice swaption after parameter change:"
+                        << QL_FIXED << std::setprecision(10)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+}
+
+
 test_suite* BermudanSwaptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bermudan swaption tests");
     suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedValues));
+    suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testTreeCache));
     return suite;
 }
 
@@ -20,12 +20,17 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
 #include <ql/cashflows/couponpricer.hpp>
 #include <ql/termstructures/volatility/optionlet/constantoptionletvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/actualactual.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/schedule.hpp>
@@ -264,6 +269,194 @@ void CashFlowsTest::testNullFixingDays() {
         .withFixingDays(Null<Natural>());
 }
 
+void CashFlowsTest::testCompiledLeg() {
+    BOOST_TEST_MESSAGE("Testing cash-flow analytics on compiled legs...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, June, 2015);
+    Settings::instance().evaluationDate() = today;
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-2*Months).to(today+10*Years-2*Months)
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Unadjusted)
+        .backwards();
+
+    Leg leg = FixedRateLeg(schedule)
+              .withNotionals(100.0)
+              .withCouponRates(0.04, ActualActual(ActualActual::ISMA))
+              .withPaymentCalendar(TARGET())
+              .withPaymentAdjustment(Following);
+    leg.push_back(boost::shared_ptr<CashFlow>(
+                         new SimpleCashFlow(100.0, leg.back()->date())));
+
+    Date settlement = today + 2;
+    CompiledLeg compiled(leg, false, settlement);
+
+    if (compiled.size() != leg.size())
+        BOOST_ERROR("wrong number of compiled cash flows"
+                    << "\n    calculated: " << compiled.size()
+                    << "\n    expected:   " << leg.size());
+
+    boost::shared_ptr<YieldTermStructure> curve(
+        new FlatForward(today, 0.03, Actual365Fixed()));
+
+    Real tolerance = 1.0e-10;
+
+    Real expected = CashFlows::npv(leg, *curve, false, settlement);
+    Real calculated = CashFlows::npv(compiled, *curve);
+    if (std::fabs(calculated-expected) > tolerance)
+        BOOST_ERROR("npv mismatch on compiled leg"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+
+    expected = CashFlows::bps(leg, *curve, false, settlement);
+    calculated = CashFlows::bps(compiled, *curve);
+    if (std::fabs(calculated-expected) > tolerance)
+        BOOST_ERROR("bps mismatch on compiled leg"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+
+    Compounding compoundings[] = { Simple, Compounded, Continuous,
+                                   SimpleThenCompounded };
+    DayCounter dc = ActualActual(ActualActual::ISMA);
+
+    for (Size i=0; i<LENGTH(compoundings); ++i) {
+        InterestRate y(0.035, dc, compoundings[i], Semiannual);
+
+        // yield round trip
+        Real price = CashFlows::npv(compiled, y);
+        Rate yield = CashFlows::yield(compiled, price, dc,
+                                      compoundings[i], Semiannual);
+        if (std::fabs(yield-y.rate()) > 1.0e-8)
+            BOOST_ERROR("unable to reproduce yield on compiled leg"
+                        << "\n    compounding: " << compoundings[i]
+                        << std::setprecision(12)
+                        << "\n    calculated:  " << yield
+                        << "\n    expected:    " << y.rate());
+
+        Real duration = CashFlows::duration(compiled, y,
+                                            Duration::Modified);
+
+        /* with simple compounding the npv chains the discount
+           over each period, while durations and convexity discount
+           over the whole time; they only agree for the others. */
+        if (compoundings[i] == Compounded ||
+            compoundings[i] == Continuous) {
+            Real h = 1.0e-5;
+            InterestRate up(y.rate()+h, dc, compoundings[i], Semiannual);
+            InterestRate down(y.rate()-h, dc, compoundings[i], Semiannual);
+            Real priceUp = CashFlows::npv(compiled, up);
+            Real priceDown = CashFlows::npv(compiled, down);
+            Real numDuration = -(priceUp-priceDown)/(2*h*price);
+            if (std::fabs(duration-numDuration) > 1.0e-5)
+                BOOST_ERROR("modified duration mismatch on compiled leg"
+                            << "\n    compounding: " << compoundings[i]
+                            << std::setprecision(12)
+                            << "\n    calculated:  " << duration
+                            << "\n    numerical:   " << numDuration);
+
+            Real numConvexity = (priceUp-2*price+priceDown)/(h*h*price);
+            Real convexity = CashFlows::convexity(compiled, y);
+            if (std::fabs(convexity-numConvexity) > 1.0e-3)
+                BOOST_ERROR("convexity mismatch on compiled leg"
+                            << "\n    compounding: " << compoundings[i]
+                            << std::setprecision(12)
+                            << "\n    calculated:  " << convexity
+                            << "\n    numerical:   " << numConvexity);
+        }
+
+        // the leg-based functions forward to the compiled ones
+        Real legDuration = CashFlows::duration(leg, y, Duration::Modified,
+                                               false, settlement);
+        if (legDuration != duration)
+            BOOST_ERROR("duration mismatch between leg and compiled leg"
+                        << std::setprecision(16)
+                        << "\n    leg:          " << legDuration
+                        << "\n    compiled leg: " << duration);
+    }
+
+    // z-spread against an explicitly spreaded curve
+    for (Size i=0; i<LENGTH(compoundings); ++i) {
+        Spread spread = 0.0125;
+        ZeroSpreadedTermStructure spreaded(
+            Handle<YieldTermStructure>(curve),
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(spread))),
+            compoundings[i], Annual);
+        Real expected = CashFlows::npv(leg, spreaded, false, settlement);
+        Real calculated = CashFlows::npv(compiled, curve, spread,
+                                         Actual365Fixed(),
+                                         compoundings[i], Annual);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("z-spreaded npv mismatch on compiled leg"
+                        << "\n    compounding: " << compoundings[i]
+                        << std::setprecision(12)
+                        << "\n    calculated:  " << calculated
+                        << "\n    expected:    " << expected);
+
+        Spread implied = CashFlows::zSpread(compiled, expected, curve,
+                                            Actual365Fixed(),
+                                            compoundings[i], Annual);
+        if (std::fabs(implied-spread) > 1.0e-8)
+            BOOST_ERROR("unable to reproduce z-spread on compiled leg"
+                        << "\n    compounding: " << compoundings[i]
+                        << std::setprecision(12)
+                        << "\n    calculated:  " << implied
+                        << "\n    expected:    " << spread);
+    }
+}
+
+void CashFlowsTest::testBpsWithoutFixings() {
+    BOOST_TEST_MESSAGE("Testing bps of floating leg without fixings...");
+
+    SavedSettings backup;
+
+    Date today = Date(15, June, 2015);
+    Settings::instance().evaluationDate() = today;
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-2*Months).to(today+5*Years-2*Months)
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Following)
+        .backwards();
+
+    // no past fixing and no forecast curve: the coupon amounts
+    // can't be calculated, but the bps doesn't need them
+    boost::shared_ptr<IborIndex> index(new USDLibor(6*Months));
+    Leg leg = IborLeg(schedule, index).withNotionals(100.0);
+
+    boost::shared_ptr<YieldTermStructure> curve(
+        new FlatForward(today, 0.03, Actual365Fixed()));
+
+    Real expected = 0.0;
+    for (Size i=0; i<leg.size(); ++i) {
+        boost::shared_ptr<Coupon> c =
+            boost::dynamic_pointer_cast<Coupon>(leg[i]);
+        expected += c->nominal() * c->accrualPeriod() *
+                    curve->discount(c->date());
+    }
+    expected *= 1.0e-4;
+
+    Real calculated = 0.0;
+    try {
+        calculated = CashFlows::bps(leg, *curve, false);
+    } catch (std::exception& e) {
+        BOOST_FAIL("bps calculation failed: " << e.what());
+    }
+    if (std::fabs(calculated-expected) > 1.0e-10)
+        BOOST_ERROR("bps mismatch on floating leg without fixings"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
@@ -272,6 +465,8 @@ test_suite* CashFlowsTest::suite() {
     #ifndef QL_USE_INDEXED_COUPON
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testNullFixingDays));
     #endif
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLeg));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testBpsWithoutFixings));
     return suite;
 }
 
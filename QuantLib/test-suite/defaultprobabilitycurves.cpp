@@ -387,6 +387,114 @@ void DefaultProbabilityCurveTest::testUpfrontBootstrap() {
 }
 
 
+void DefaultProbabilityCurveTest::testNewtonBootstrap() {
+    BOOST_TEST_MESSAGE("Testing global Newton bootstrap of default curves...");
+
+    Calendar calendar = TARGET();
+
+    Date today = Settings::instance().evaluationDate();
+
+    Integer settlementDays = 1;
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quote;
+    quote.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.005)));
+    quote.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.006)));
+    quote.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.007)));
+    quote.push_back(boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.009)));
+
+    std::vector<Integer> n;
+    n.push_back(1);
+    n.push_back(2);
+    n.push_back(3);
+    n.push_back(5);
+
+    Frequency frequency = Quarterly;
+    BusinessDayConvention convention = Following;
+    DateGeneration::Rule rule = DateGeneration::TwentiethIMM;
+    DayCounter dayCounter = Thirty360();
+    Real recoveryRate = 0.4;
+
+    RelinkableHandle<YieldTermStructure> discountCurve;
+    discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+                                    new FlatForward(today,0.06,Actual360())));
+
+    std::vector<boost::shared_ptr<DefaultProbabilityHelper> >
+        newtonHelpers, iterativeHelpers;
+    for (Size i=0; i<n.size(); i++) {
+        newtonHelpers.push_back(
+            boost::shared_ptr<DefaultProbabilityHelper>(
+                new SpreadCdsHelper(Handle<Quote>(quote[i]),
+                                    Period(n[i], Years),
+                                    settlementDays, calendar,
+                                    frequency, convention, rule,
+                                    dayCounter, recoveryRate,
+                                    discountCurve)));
+        iterativeHelpers.push_back(
+            boost::shared_ptr<DefaultProbabilityHelper>(
+                new SpreadCdsHelper(Handle<Quote>(quote[i]),
+                                    Period(n[i], Years),
+                                    settlementDays, calendar,
+                                    frequency, convention, rule,
+                                    dayCounter, recoveryRate,
+                                    discountCurve)));
+    }
+
+    typedef PiecewiseDefaultCurve<HazardRate,BackwardFlat,NewtonBootstrap>
+                                                                 NewtonCurve;
+    const NewtonCurve newtonCurve(today, newtonHelpers, Thirty360());
+    const PiecewiseDefaultCurve<HazardRate,BackwardFlat> iterativeCurve(
+                                      today, iterativeHelpers, Thirty360());
+
+    const std::vector<Real>& x = newtonCurve.data();
+    const std::vector<Real>& y = iterativeCurve.data();
+    for (Size j=0; j<x.size(); ++j) {
+        if (std::fabs(x[j] - y[j]) > 1.0e-10)
+            BOOST_ERROR("failed to reproduce iterative bootstrap at "
+                        << io::ordinal(j) << " node"
+                        << std::setprecision(12)
+                        << "\n    newton:    " << x[j]
+                        << "\n    iterative: " << y[j]);
+    }
+
+    const Matrix& jacobian = newtonCurve.jacobian();
+    const Matrix& expected = iterativeCurve.jacobian();
+    if (jacobian.rows() != n.size() || jacobian.columns() != n.size())
+        BOOST_FAIL("wrong Jacobian dimensions: " << jacobian.rows()
+                   << "x" << jacobian.columns());
+    for (Size i=0; i<jacobian.rows(); ++i) {
+        for (Size j=0; j<jacobian.columns(); ++j) {
+            if (std::fabs(jacobian[i][j] - expected[i][j]) > 1.0e-6)
+                BOOST_ERROR("Jacobian mismatch at (" << i << "," << j << ")"
+                            << std::setprecision(12)
+                            << "\n    newton:    " << jacobian[i][j]
+                            << "\n    iterative: " << expected[i][j]);
+        }
+    }
+
+    // the node sensitivities must match bump-and-rebootstrap ones
+    const Matrix sensitivities = newtonCurve.nodeSensitivities();
+    const Real h = 1.0e-5;
+    for (Size j=0; j<n.size(); ++j) {
+        const Real q = quote[j]->value();
+        quote[j]->setValue(q + h);
+        const std::vector<Real> up = newtonCurve.data();
+        quote[j]->setValue(q - h);
+        const std::vector<Real> down = newtonCurve.data();
+        quote[j]->setValue(q);
+
+        for (Size i=0; i<n.size(); ++i) {
+            const Real bumped = (up[i+1] - down[i+1])/(2.0*h);
+            if (std::fabs(sensitivities[i][j] - bumped) > 1.0e-5)
+                BOOST_ERROR("node sensitivity mismatch at ("
+                            << i << "," << j << ")"
+                            << std::setprecision(12)
+                            << "\n    from Jacobian: " << sensitivities[i][j]
+                            << "\n    bumped:        " << bumped);
+        }
+    }
+}
+
+
 test_suite* DefaultProbabilityCurveTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Default-probability curve tests");
     suite->add(QUANTLIB_TEST_CASE(
@@ -405,5 +513,7 @@ test_suite* DefaultProbabilityCurveTest::suite() {
                 &DefaultProbabilityCurveTest::testSingleInstrumentBootstrap));
     suite->add(QUANTLIB_TEST_CASE(
                          &DefaultProbabilityCurveTest::testUpfrontBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                          &DefaultProbabilityCurveTest::testNewtonBootstrap));
     return suite;
 }
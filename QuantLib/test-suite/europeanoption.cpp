@@ -24,6 +24,8 @@
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/instruments/dividendvanillaoption.hpp>
+#include <ql/exercise.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
@@ -1250,6 +1252,82 @@ void EuropeanOptionTest::testMcEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMultiThreadedMcEngines() {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded Monte Carlo European engines "
+                       "against analytic results...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Call, 105.0));
+    boost::shared_ptr<Exercise> exercise(
+                                  new EuropeanExercise(today + 360));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+    const Real expected = option.NPV();
+
+    const Size threads = 4;
+    const Size samples = 40001;
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withThreads(threads));
+    const Real calculated = option.NPV();
+    const Real error = option.errorEstimate();
+
+    if (std::fabs(calculated-expected) > 3.0*error)
+        BOOST_ERROR("failed to reproduce analytic price with "
+                    << threads << " threads:"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << error);
+
+    // same thread count and seed must give the same samples
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withSamples(samples)
+                            .withSeed(42)
+                            .withThreads(threads));
+    const Real repeated = option.NPV();
+    if (repeated != calculated)
+        BOOST_ERROR("multi-threaded simulation is not reproducible:"
+                    << "\n    first run:  " << calculated
+                    << "\n    second run: " << repeated
+                    << "\n    difference: " << repeated-calculated);
+
+    // tolerance-driven simulation
+    const Real tolerance = 0.05;
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1)
+                            .withAbsoluteTolerance(tolerance)
+                            .withSeed(42)
+                            .withThreads(threads));
+    if (option.errorEstimate() > tolerance)
+        BOOST_ERROR("required tolerance not reached with "
+                    << threads << " threads:"
+                    << "\n    error estimate: " << option.errorEstimate()
+                    << "\n    tolerance:      " << tolerance);
+}
+
 void EuropeanOptionTest::testQmcEngines() {
 
     BOOST_TEST_MESSAGE("Testing Quasi Monte Carlo European engines "
@@ -1514,6 +1592,188 @@ void EuropeanOptionTest::testLocalVolatility() {
 }
 
 
+void EuropeanOptionTest::testFdMultipleStrikes() {
+    BOOST_TEST_MESSAGE(
+        "Testing finite-differences with multiple strikes caching...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    const boost::shared_ptr<Quote> s0(new SimpleQuote(100.0));
+    const boost::shared_ptr<YieldTermStructure> rTS
+        = flatRate(settlementDate, 0.05, dayCounter);
+    const boost::shared_ptr<YieldTermStructure> qTS
+        = flatRate(settlementDate, 0.02, dayCounter);
+
+    // a smile, so that each strike needs its own Black variance
+    std::vector<Date> volDates;
+    volDates.push_back(settlementDate + Period(6, Months));
+    volDates.push_back(settlementDate + Period(2, Years));
+    std::vector<Real> volStrikes;
+    Matrix blackVols(5, 2);
+    const Real smile[] = { 0.32, 0.26, 0.22, 0.21, 0.23 };
+    for (Size i=0; i < 5; ++i) {
+        volStrikes.push_back(60.0 + 20.0*i);
+        blackVols[i][0] = smile[i];
+        blackVols[i][1] = smile[i] - 0.02;
+    }
+    const boost::shared_ptr<BlackVolTermStructure> volTS(
+        new BlackVarianceSurface(settlementDate, calendar, volDates,
+                                 volStrikes, blackVols, dayCounter));
+
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+                                              makeProcess(s0, qTS, rTS, volTS);
+
+    const Real strikes[] = { 70.0, 85.0, 95.0, 100.0, 110.0, 125.0 };
+    const std::vector<Real> strikeVector(strikes, strikes+LENGTH(strikes));
+    const Date maturity = settlementDate + Period(1, Years);
+
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> multiStrikeEngine(
+        new FdBlackScholesVanillaEngine(process, 200, 400));
+    multiStrikeEngine->enableMultipleStrikesCaching(strikeVector);
+
+    const boost::shared_ptr<PricingEngine> singleStrikeEngine(
+        new FdBlackScholesVanillaEngine(process, 200, 400));
+    const boost::shared_ptr<PricingEngine> analyticEngine(
+        new AnalyticEuropeanEngine(process));
+
+    const boost::shared_ptr<Exercise> exercises[] = {
+        boost::shared_ptr<Exercise>(new EuropeanExercise(maturity)),
+        boost::shared_ptr<Exercise>(
+                      new AmericanExercise(settlementDate, maturity)) };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    const Real tol = 1e-3;
+
+    for (Size i=0; i < LENGTH(exercises); ++i) {
+        for (Size j=0; j < LENGTH(types); ++j) {
+            for (Size k=0; k < LENGTH(strikes); ++k) {
+                const boost::shared_ptr<StrikedTypePayoff> payoff(
+                    new PlainVanillaPayoff(types[j], strikes[k]));
+                VanillaOption option(payoff, exercises[i]);
+
+                option.setPricingEngine(
+                    (exercises[i]->type() == Exercise::European)
+                    ? analyticEngine : singleStrikeEngine);
+                const Real expectedNPV   = option.NPV();
+                const Real expectedDelta = option.delta();
+                const Real expectedGamma = option.gamma();
+
+                option.setPricingEngine(multiStrikeEngine);
+                const Real calculatedNPV   = option.NPV();
+                const Real calculatedDelta = option.delta();
+                const Real calculatedGamma = option.gamma();
+
+                if (std::fabs(expectedNPV - calculatedNPV)
+                                                > tol*std::max(1.0, expectedNPV)
+                    || std::fabs(expectedDelta - calculatedDelta) > tol
+                    || std::fabs(expectedGamma - calculatedGamma) > tol) {
+                    BOOST_ERROR("Failed to reproduce option results for "
+                           << "\n    exercise:         " << i
+                           << "\n    type:             " << types[j]
+                           << "\n    strike:           " << strikes[k]
+                           << "\n    calculated npv:   " << calculatedNPV
+                           << "\n    expected npv:     " << expectedNPV
+                           << "\n    calculated delta: " << calculatedDelta
+                           << "\n    expected delta:   " << expectedDelta
+                           << "\n    calculated gamma: " << calculatedGamma
+                           << "\n    expected gamma:   " << expectedGamma);
+                }
+            }
+        }
+    }
+
+    // discrete dividends and local volatility; the single-strike
+    // engine uses the same grid sizes
+    const std::vector<Date> dividendDates(
+                                    1, settlementDate + Period(6, Months));
+    const std::vector<Real> dividends(1, 2.0);
+    const bool localVols[] = { false, true };
+
+    for (Size l=0; l < LENGTH(localVols); ++l) {
+        const boost::shared_ptr<FdBlackScholesVanillaEngine> chainEngine(
+            new FdBlackScholesVanillaEngine(process, 200, 400, 0,
+                                            FdmSchemeDesc::Douglas(),
+                                            localVols[l], 0.25));
+        chainEngine->enableMultipleStrikesCaching(strikeVector);
+
+        const boost::shared_ptr<PricingEngine> plainEngine(
+            new FdBlackScholesVanillaEngine(process, 200, 400, 0,
+                                            FdmSchemeDesc::Douglas(),
+                                            localVols[l], 0.25));
+
+        for (Size i=0; i < LENGTH(exercises); ++i) {
+            for (Size k=0; k < LENGTH(strikes); ++k) {
+                const boost::shared_ptr<StrikedTypePayoff> payoff(
+                    new PlainVanillaPayoff(Option::Put, strikes[k]));
+                DividendVanillaOption option(payoff, exercises[i],
+                                             dividendDates, dividends);
+
+                option.setPricingEngine(plainEngine);
+                const Real expectedNPV   = option.NPV();
+                const Real expectedDelta = option.delta();
+
+                option.setPricingEngine(chainEngine);
+                const Real calculatedNPV   = option.NPV();
+                const Real calculatedDelta = option.delta();
+
+                if (std::fabs(expectedNPV - calculatedNPV)
+                                                > tol*std::max(1.0, expectedNPV)
+                    || std::fabs(expectedDelta - calculatedDelta) > tol) {
+                    BOOST_ERROR("Failed to reproduce dividend option results"
+                           << "\n    local vol:        " << localVols[l]
+                           << "\n    exercise:         " << i
+                           << "\n    strike:           " << strikes[k]
+                           << "\n    calculated npv:   " << calculatedNPV
+                           << "\n    expected npv:     " << expectedNPV
+                           << "\n    calculated delta: " << calculatedDelta
+                           << "\n    expected delta:   " << expectedDelta);
+                }
+            }
+        }
+    }
+
+    // the cached results must not depend on the option priced first
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> ascendingEngine(
+        new FdBlackScholesVanillaEngine(process, 200, 400));
+    ascendingEngine->enableMultipleStrikesCaching(strikeVector);
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> descendingEngine(
+        new FdBlackScholesVanillaEngine(process, 200, 400));
+    descendingEngine->enableMultipleStrikesCaching(strikeVector);
+
+    std::vector<Real> ascendingNPVs, descendingNPVs;
+    for (Size k=0; k < LENGTH(strikes); ++k) {
+        VanillaOption option(
+            boost::shared_ptr<StrikedTypePayoff>(
+                      new PlainVanillaPayoff(Option::Call, strikes[k])),
+            exercises[0]);
+        option.setPricingEngine(ascendingEngine);
+        ascendingNPVs.push_back(option.NPV());
+    }
+    for (Size k=LENGTH(strikes); k > 0; --k) {
+        VanillaOption option(
+            boost::shared_ptr<StrikedTypePayoff>(
+                      new PlainVanillaPayoff(Option::Call, strikes[k-1])),
+            exercises[0]);
+        option.setPricingEngine(descendingEngine);
+        descendingNPVs.push_back(option.NPV());
+    }
+    for (Size k=0; k < LENGTH(strikes); ++k) {
+        const Real descendingNPV = descendingNPVs[LENGTH(strikes)-1-k];
+        if (ascendingNPVs[k] != descendingNPV)
+            BOOST_ERROR("cached results depend on the pricing order"
+                        << std::setprecision(12)
+                        << "\n    strike:           " << strikes[k]
+                        << "\n    ascending order:  " << ascendingNPVs[k]
+                        << "\n    descending order: " << descendingNPV);
+    }
+}
+
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testValues));
@@ -1537,10 +1797,13 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(
+                            &EuropeanOptionTest::testMultiThreadedMcEngines));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdMultipleStrikes));
 
     return suite;
 }
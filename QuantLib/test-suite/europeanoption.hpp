@@ -44,9 +44,11 @@ class EuropeanOptionTest {
     static void testIntegralEngines();
     static void testQmcEngines();
     static void testMcEngines();
+    static void testMultiThreadedMcEngines();
     static void testFFTEngines();
     static void testPriceCurve();
     static void testLocalVolatility();
+    static void testFdMultipleStrikes();
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
 };
@@ -29,7 +29,12 @@
 #include <ql/processes/hullwhiteprocess.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/hybridhestonhullwhiteprocess.hpp>
+#include <ql/processes/batesprocess.hpp>
+#include <ql/experimental/processes/extouwithjumpsprocess.hpp>
+#include <ql/experimental/processes/extendedornsteinuhlenbeckprocess.hpp>
+#include <ql/experimental/finitedifferences/fdmextoujumpop.hpp>
 #include <ql/experimental/math/numericaldifferentiation.hpp>
+#include <ql/math/functional.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
@@ -41,6 +46,8 @@
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/amgpreconditioner.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
@@ -49,6 +56,8 @@
 #include <ql/methods/finitedifferences/meshers/uniform1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmsimpleprocess1dmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/exponentialjump1dmesher.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
@@ -59,6 +68,7 @@
 #include <ql/methods/finitedifferences/operators/fdmhestonhullwhiteop.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmbatesop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
@@ -1235,6 +1245,124 @@ void FdmLinearOpTest::testFdmHestonHullWhiteOp() {
     }
 }
 
+void FdmLinearOpTest::testInPlaceOperators() {
+    BOOST_TEST_MESSAGE("Testing in-place variants of FDM operators...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const Date exerciseDate(28, March, 2012);
+    const Time maturity = Actual365Fixed().yearFraction(today, exerciseDate);
+
+    Size dims[] = {21, 11, 11};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    boost::shared_ptr<FdmLinearOpComposite> linearOp(
+        new FdmHestonHullWhiteOp(mesher,
+                                 jointProcess->hestonProcess(),
+                                 hwProcess,
+                                 jointProcess->eta()));
+    linearOp->setTime(0.5, 0.6);
+
+    Array r(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        r[iter.index()] = desc.calculator->avgInnerValue(iter, maturity);
+    }
+
+    const Real tol = 1e-14;
+    Array out, mixed;
+    const Array expectedFull = linearOp->apply(r);
+    const Array expectedMixed = linearOp->apply_mixed(r);
+    linearOp->apply_into(r, out);
+    linearOp->apply_mixed_into(r, mixed);
+    for (Size j=0; j < r.size(); ++j) {
+        if (   std::fabs(out[j] - expectedFull[j]) > tol
+            || std::fabs(mixed[j] - expectedMixed[j]) > tol) {
+            BOOST_FAIL("in-place apply or apply_mixed differs"
+                       << "\n    index:      " << j
+                       << "\n    apply:      " << out[j]
+                       << "\n    expected:   " << expectedFull[j]
+                       << "\n    mixed:      " << mixed[j]
+                       << "\n    expected:   " << expectedMixed[j]);
+        }
+    }
+
+    for (Size i=0; i < linearOp->size(); ++i) {
+        const Array expected = linearOp->apply_direction(i, r);
+        linearOp->apply_direction_into(i, r, out);
+        for (Size j=0; j < r.size(); ++j) {
+            if (std::fabs(out[j] - expected[j]) > tol) {
+                BOOST_FAIL("in-place apply_direction differs"
+                           << "\n    direction:  " << i
+                           << "\n    index:      " << j
+                           << "\n    in-place:   " << out[j]
+                           << "\n    expected:   " << expected[j]);
+            }
+        }
+
+        const Array expectedSol = linearOp->solve_splitting(i, r, -0.01);
+        linearOp->solve_splitting_into(i, r, out, -0.01);
+        // the right hand side is allowed to be overwritten
+        Array inPlace(r);
+        linearOp->solve_splitting_into(i, inPlace, inPlace, -0.01);
+        for (Size j=0; j < r.size(); ++j) {
+            if (   std::fabs(out[j] - expectedSol[j]) > tol
+                || std::fabs(inPlace[j] - expectedSol[j]) > tol) {
+                BOOST_FAIL("in-place solve_splitting differs"
+                           << "\n    direction:  " << i
+                           << "\n    index:      " << j
+                           << "\n    in-place:   " << out[j]
+                           << "\n    aliased:    " << inPlace[j]
+                           << "\n    expected:   " << expectedSol[j]);
+            }
+        }
+    }
+
+    // time stepping must reproduce the operator-returning formulation
+    const Time dt = 0.05;
+    const Real theta = 0.5+std::sqrt(3.0)/6.;
+    DouglasScheme douglas(theta, linearOp);
+    douglas.setStep(dt);
+
+    Array a(r), expected(r);
+    for (Size n=0; n < 3; ++n) {
+        const Time t = maturity - n*dt;
+        douglas.step(a, t);
+
+        linearOp->setTime(t-dt, t);
+        Array y = expected + dt*linearOp->apply(expected);
+        for (Size i=0; i < linearOp->size(); ++i) {
+            Array rhs = y - theta*dt*linearOp->apply_direction(i, expected);
+            y = linearOp->solve_splitting(i, rhs, -theta*dt);
+        }
+        expected = y;
+    }
+
+    for (Size j=0; j < r.size(); ++j) {
+        if (std::fabs(a[j] - expected[j]) > tol) {
+            BOOST_FAIL("in-place Douglas scheme differs"
+                       << "\n    index:      " << j
+                       << "\n    in-place:   " << a[j]
+                       << "\n    expected:   " << expected[j]);
+        }
+    }
+}
+
 #if !defined(QL_NO_UBLAS_SUPPORT)
 namespace {
     Disposable<Array> axpy(
@@ -1252,6 +1380,160 @@ namespace {
 #endif
 
 
+void FdmLinearOpTest::testTripleBandMapOnGridLines() {
+
+    BOOST_TEST_MESSAGE("Testing triple-band map along all grid lines...");
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    // large enough to exercise the multi-threaded code path and
+    // the partitioning of the outermost direction into several tasks
+    Size dims[] = {9, 17, 40};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries(
+        dim.size(), std::pair<Real, Real>(0.0, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size());
+    for (Size i=0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    for (Size direction=0; direction < dim.size(); ++direction) {
+        SecondDerivativeOp dxx(direction, mesher);
+        dxx.axpyb(Array(1, 0.5), FirstDerivativeOp(direction, mesher),
+                  dxx, Array(1, 1.0));
+
+        const Array calculated = dxx.apply(u);
+        const Array expected = axpy(dxx.toMatrix(), u);
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(calculated[i] - expected[i]) > 1e-10) {
+                BOOST_FAIL("apply along grid lines failed "
+                           << "\n    direction:  " << direction
+                           << "\n    index:      " << i
+                           << "\n    calculated: " << calculated[i]
+                           << "\n    expected:   " << expected[i]);
+            }
+        }
+
+        const Array t = dxx.solve_splitting(calculated, 1.0, 0.0);
+        for (Size i=0; i < u.size(); ++i) {
+            if (std::fabs(u[i] - t[i]) > 1e-8) {
+                BOOST_FAIL("solve and apply are not consistent "
+                           << "\n    direction:  " << direction
+                           << "\n    index:      " << i
+                           << "\n    expected:   " << u[i]
+                           << "\n    calculated: " << t[i]);
+            }
+        }
+    }
+#endif
+}
+
+void FdmLinearOpTest::testCSRMatrix() {
+
+    BOOST_TEST_MESSAGE("Testing compressed sparse row matrices...");
+
+    SavedSettings backup;
+
+    const Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    const Date exerciseDate(28, March, 2012);
+    const Time maturity = Actual365Fixed().yearFraction(today, exerciseDate);
+
+    Size dims[] = {21, 11, 11};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<HybridHestonHullWhiteProcess> jointProcess
+                                            = createHestonHullWhite(maturity);
+    FdmSolverDesc desc = createSolverDesc(dim, jointProcess);
+    boost::shared_ptr<FdmMesher> mesher = desc.mesher;
+
+    boost::shared_ptr<HullWhiteForwardProcess> hwFwdProcess
+                                            = jointProcess->hullWhiteProcess();
+    boost::shared_ptr<HullWhiteProcess> hwProcess(
+        new HullWhiteProcess(jointProcess->hestonProcess()->riskFreeRate(),
+                             hwFwdProcess->a(), hwFwdProcess->sigma()));
+
+    boost::shared_ptr<FdmLinearOpComposite> linearOp(
+        new FdmHestonHullWhiteOp(mesher,
+                                 jointProcess->hestonProcess(),
+                                 hwProcess,
+                                 jointProcess->eta()));
+    linearOp->setTime(0.5, 0.6);
+
+    Array x(mesher->layout()->size());
+    for (Size i=0; i < x.size(); ++i)
+        x[i] = std::sin(0.1*i)+std::cos(0.35*i);
+
+    const CSRMatrix m = linearOp->toCSRMatrix();
+    const Array calculated = m.apply(x);
+    const Array expected = linearOp->apply(x);
+
+    const Real tol = 1e-10;
+    for (Size i=0; i < x.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i])
+                > tol*std::max(1.0, std::fabs(expected[i]))) {
+            BOOST_FAIL("CSR matrix and operator are not consistent"
+                       << "\n    index:      " << i
+                       << "\n    calculated: " << calculated[i]
+                       << "\n    expected:   " << expected[i]);
+        }
+    }
+
+    const std::vector<CSRMatrix> decomp = linearOp->toCSRMatrixDecomp();
+    for (Size i=0; i < decomp.size()-1; ++i) {
+        const Array c = decomp[i].apply(x);
+        const Array e = linearOp->apply_direction(i, x);
+        for (Size j=0; j < x.size(); ++j) {
+            if (std::fabs(c[j] - e[j]) > tol*std::max(1.0, std::fabs(e[j]))) {
+                BOOST_FAIL("CSR decomposition and operator are not consistent"
+                           << "\n    direction:  " << i
+                           << "\n    index:      " << j
+                           << "\n    calculated: " << c[j]
+                           << "\n    expected:   " << e[j]);
+            }
+        }
+    }
+
+#if !defined(QL_NO_UBLAS_SUPPORT)
+    const SparseMatrix sm = linearOp->toMatrix();
+    const CSRMatrix converted(sm);
+
+    for (Size i=0; i < m.rows(); ++i) {
+        for (Size k=m.rowStart()[i]; k < m.rowStart()[i+1]; ++k) {
+            const Size j = m.columnIndex()[k];
+            if (   std::fabs(sm(i, j) - m(i, j)) > tol
+                || std::fabs(converted(i, j) - m(i, j)) > tol) {
+                BOOST_FAIL("ublas and CSR matrix are not consistent"
+                           << "\n    row:        " << i
+                           << "\n    column:     " << j
+                           << "\n    ublas:      " << sm(i, j)
+                           << "\n    CSR:        " << m(i, j));
+            }
+        }
+    }
+#endif
+
+    // shifting the matrix
+    CSRMatrix shifted = m;
+    shifted.scaleAndShift(-0.5, 1.0);
+    const Array shiftedProd = shifted.apply(x);
+    for (Size i=0; i < x.size(); ++i) {
+        const Real e = x[i] - 0.5*expected[i];
+        if (std::fabs(shiftedProd[i] - e) > tol*std::max(1.0, std::fabs(e))) {
+            BOOST_FAIL("shifted CSR matrix is not consistent"
+                       << "\n    index:      " << i
+                       << "\n    calculated: " << shiftedProd[i]
+                       << "\n    expected:   " << e);
+        }
+    }
+}
+
 void FdmLinearOpTest::testBiCGstab() {
 #if !defined(QL_NO_UBLAS_SUPPORT)
     BOOST_TEST_MESSAGE("Testing bi-conjugated gradient stabilized algorithm "
@@ -1310,6 +1592,328 @@ void FdmLinearOpTest::testBiCGstab() {
 #endif
 }
 
+namespace {
+    Disposable<Array> implicitEulerOp(
+        const boost::shared_ptr<FdmLinearOpComposite>& op, Real dt,
+        const Array& x) {
+        Array retVal = x - dt*op->apply(x);
+        return retVal;
+    }
+}
+
+void FdmLinearOpTest::testGMRESAndMultigrid() {
+    BOOST_TEST_MESSAGE("Testing GMRES and algebraic multigrid "
+                       "with Heston operator...");
+
+    SavedSettings backup;
+
+    Size dims[] = {101, 51};
+    const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+    boost::shared_ptr<FdmLinearOpLayout> index(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.push_back(std::pair<Real, Real>( 3.8, 4.905274778));
+    boundaries.push_back(std::pair<Real, Real>( 0.000, 1.0));
+
+    boost::shared_ptr<FdmMesher> mesher(
+        new UniformGridMesher(index, boundaries));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.0 , Actual365Fixed()));
+
+    boost::shared_ptr<HestonProcess> hestonProcess(
+        new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+
+    boost::shared_ptr<FdmLinearOpComposite> hestonOp(
+                                   new FdmHestonOp(mesher, hestonProcess));
+    const Real dt = 0.05;
+    hestonOp->setTime(0.5, 0.5+dt);
+
+    boost::function<Disposable<Array>(const Array&)> matmult(
+                boost::bind(&implicitEulerOp, hestonOp, dt, _1));
+
+    Array b(mesher->layout()->size());
+    MersenneTwisterUniformRng rng(1234);
+    for (Size i=0; i < b.size(); ++i) {
+        b[i] = rng.next().value;
+    }
+
+    const Real tol = 1e-10;
+
+    const GMRESResult plain = GMRES(matmult, b.size(), tol)
+                                    .solveWithRestart(30, b);
+
+    CSRMatrix m = hestonOp->toCSRMatrix();
+    m.scaleAndShift(-dt, 1.0);
+    const AMGPreconditioner amg(m);
+    if (amg.levels() < 2) {
+        BOOST_FAIL("no coarse level created by algebraic multigrid");
+    }
+
+    boost::function<Disposable<Array>(const Array&)> precond(
+         boost::bind(&AMGPreconditioner::apply, &amg, _1));
+    const GMRESResult preconditioned = GMRES(matmult, b.size(), tol, precond)
+                                            .solveWithRestart(30, b);
+
+    const GMRESResult* results[] = { &plain, &preconditioned };
+    for (Size i=0; i < LENGTH(results); ++i) {
+        const Array r = b - matmult(results[i]->x);
+        const Real error = std::sqrt(DotProduct(r, r)/DotProduct(b, b));
+        if (error > tol) {
+            BOOST_FAIL("Error calculating the inverse using GMRES" <<
+                       "\n tolerance:  " << tol <<
+                       "\n error:      " << error);
+        }
+    }
+
+    if (preconditioned.iterations >= plain.iterations) {
+        BOOST_FAIL("algebraic multigrid does not reduce number of "
+                   "GMRES iterations" <<
+                   "\n without preconditioner: " << plain.iterations <<
+                   "\n with preconditioner:    " << preconditioned.iterations);
+    }
+
+    // full rollback with the different solvers of the implicit scheme
+    Array rhs(mesher->layout()->size());
+    const FdmLinearOpIterator endIter = mesher->layout()->end();
+    for (FdmLinearOpIterator iter = mesher->layout()->begin();
+         iter != endIter; ++iter) {
+        rhs[iter.index()]=std::max(std::exp(mesher->location(iter,0))-100, 0.0);
+    }
+
+    ImplicitEulerScheme biCGstabScheme(hestonOp, FdmBoundaryConditionSet(),
+                                       1e-10);
+    ImplicitEulerScheme gmresScheme(hestonOp, FdmBoundaryConditionSet(), 1e-10,
+                                    ImplicitEulerScheme::GMRES,
+                                    ImplicitEulerScheme::AlgebraicMultigrid);
+
+    Array expected(rhs), calculated(rhs);
+    FiniteDifferenceModel<ImplicitEulerScheme>(biCGstabScheme)
+        .rollback(expected, 1.0, 0.0, 20);
+    FiniteDifferenceModel<ImplicitEulerScheme>(gmresScheme)
+        .rollback(calculated, 1.0, 0.0, 20);
+
+    for (Size i=0; i < rhs.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > 1e-5) {
+            BOOST_FAIL("implicit Euler rollback with GMRES and algebraic "
+                       "multigrid differs from BiCGstab" <<
+                       "\n index:      " << i <<
+                       "\n calculated: " << calculated[i] <<
+                       "\n expected:   " << expected[i]);
+        }
+    }
+
+    // same through the backward solver used by the engines
+    Array viaSolver(rhs);
+    FdmBackwardSolver(hestonOp, FdmBoundaryConditionSet(),
+                      boost::shared_ptr<FdmStepConditionComposite>(),
+                      FdmSchemeDesc::ImplicitEuler(
+                                     ImplicitEulerScheme::GMRES,
+                                     ImplicitEulerScheme::AlgebraicMultigrid,
+                                     1e-10))
+        .rollback(viaSolver, 1.0, 0.0, 20, 0);
+
+    for (Size i=0; i < rhs.size(); ++i) {
+        if (std::fabs(viaSolver[i] - expected[i]) > 1e-5) {
+            BOOST_FAIL("backward solver with GMRES and algebraic "
+                       "multigrid differs from BiCGstab" <<
+                       "\n index:      " << i <<
+                       "\n calculated: " << viaSolver[i] <<
+                       "\n expected:   " << expected[i]);
+        }
+    }
+}
+
+namespace {
+    void testJumpOperatorWithMultigrid(
+                        const std::string& name,
+                        const boost::shared_ptr<FdmLinearOpComposite>& op,
+                        const Array& rhs) {
+
+        const Real dt = 0.05;
+        op->setTime(0.5, 0.5+dt);
+
+        boost::function<Disposable<Array>(const Array&)> matmult(
+                    boost::bind(&implicitEulerOp, op, dt, _1));
+
+        Array b(rhs.size());
+        MersenneTwisterUniformRng rng(1234);
+        for (Size i=0; i < b.size(); ++i) {
+            b[i] = rng.next().value;
+        }
+
+        const Real tol = 1e-10;
+
+        const GMRESResult plain = GMRES(matmult, 10*b.size(), tol)
+                                        .solveWithRestart(50, b);
+
+        // the multigrid hierarchy is built on the sparse part of the
+        // operator; the jump integral stays in the Krylov iteration
+        CSRMatrix m = op->preconditionerMatrix();
+        m.scaleAndShift(-dt, 1.0);
+        const AMGPreconditioner amg(m);
+
+        boost::function<Disposable<Array>(const Array&)> precond(
+             boost::bind(&AMGPreconditioner::apply, &amg, _1));
+        const GMRESResult preconditioned =
+            GMRES(matmult, 10*b.size(), tol, precond)
+                .solveWithRestart(50, b);
+
+        const GMRESResult* results[] = { &plain, &preconditioned };
+        for (Size i=0; i < LENGTH(results); ++i) {
+            const Array r = b - matmult(results[i]->x);
+            const Real error = std::sqrt(DotProduct(r, r)/DotProduct(b, b));
+            if (error > tol) {
+                BOOST_FAIL("Error calculating the inverse using GMRES" <<
+                           "\n operator:   " << name <<
+                           "\n tolerance:  " << tol <<
+                           "\n error:      " << error);
+            }
+        }
+
+        if (preconditioned.iterations >= plain.iterations) {
+            BOOST_FAIL("algebraic multigrid does not reduce number of "
+                       "GMRES iterations" <<
+                       "\n operator:               " << name <<
+                       "\n without preconditioner: " << plain.iterations <<
+                       "\n with preconditioner:    "
+                       << preconditioned.iterations);
+        }
+
+        // rollback with warm-started GMRES and multigrid
+        const Size steps = 20;
+        ImplicitEulerScheme biCGstabScheme(op, FdmBoundaryConditionSet(),
+                                           1e-10);
+        ImplicitEulerScheme gmresScheme(op, FdmBoundaryConditionSet(), 1e-10,
+                                        ImplicitEulerScheme::GMRES,
+                                        ImplicitEulerScheme::AlgebraicMultigrid);
+
+        // stepped by hand, since the finite-difference model would
+        // work on copies of the schemes and hide their iteration count
+        biCGstabScheme.setStep(1.0/steps);
+        gmresScheme.setStep(1.0/steps);
+
+        Array expected(rhs), calculated(rhs);
+        for (Size i=steps; i > 0; --i) {
+            biCGstabScheme.step(expected, Real(i)/steps);
+            gmresScheme.step(calculated, Real(i)/steps);
+        }
+
+        for (Size i=0; i < rhs.size(); ++i) {
+            if (std::fabs(calculated[i] - expected[i]) > 1e-5) {
+                BOOST_FAIL("implicit Euler rollback with GMRES and algebraic "
+                           "multigrid differs from BiCGstab" <<
+                           "\n operator:   " << name <<
+                           "\n index:      " << i <<
+                           "\n calculated: " << calculated[i] <<
+                           "\n expected:   " << expected[i]);
+            }
+        }
+
+        // starting from the previous solution, a step needs fewer
+        // iterations on average than a preconditioned solve from scratch
+        if (gmresScheme.numberOfIterations() >=
+                                        steps*preconditioned.iterations) {
+            BOOST_FAIL("warm-started GMRES with algebraic multigrid "
+                       "needs too many iterations" <<
+                       "\n operator:        " << name <<
+                       "\n iterations:      "
+                       << gmresScheme.numberOfIterations() <<
+                       "\n steps:           " << steps <<
+                       "\n cold iterations: " << preconditioned.iterations);
+        }
+    }
+}
+
+void FdmLinearOpTest::testGMRESAndMultigridWithJumps() {
+    BOOST_TEST_MESSAGE("Testing GMRES and algebraic multigrid "
+                       "with jump operators...");
+
+    SavedSettings backup;
+
+    const Date today(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+
+    // Bates operator
+    {
+        Size dims[] = {101, 51};
+        const std::vector<Size> dim(dims, dims+LENGTH(dims));
+
+        boost::shared_ptr<FdmLinearOpLayout> index(
+                                                new FdmLinearOpLayout(dim));
+
+        std::vector<std::pair<Real, Real> > boundaries;
+        boundaries.push_back(std::pair<Real, Real>( 3.8, 4.905274778));
+        boundaries.push_back(std::pair<Real, Real>( 0.000, 1.0));
+
+        boost::shared_ptr<FdmMesher> mesher(
+            new UniformGridMesher(index, boundaries));
+
+        Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+        Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+        Handle<YieldTermStructure> qTS(flatRate(0.0 , Actual365Fixed()));
+
+        boost::shared_ptr<BatesProcess> batesProcess(
+            new BatesProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8,
+                             2.0, -0.2, 0.2));
+
+        boost::shared_ptr<FdmLinearOpComposite> batesOp(
+            new FdmBatesOp(mesher, batesProcess,
+                           FdmBoundaryConditionSet(), 16));
+
+        Array rhs(mesher->layout()->size());
+        const FdmLinearOpIterator endIter = mesher->layout()->end();
+        for (FdmLinearOpIterator iter = mesher->layout()->begin();
+             iter != endIter; ++iter) {
+            rhs[iter.index()]
+                = std::max(std::exp(mesher->location(iter,0))-100, 0.0);
+        }
+
+        testJumpOperatorWithMultigrid("FdmBatesOp", batesOp, rhs);
+    }
+
+    // extended Ornstein-Uhlenbeck operator with exponential jumps
+    {
+        const Real x0 = 3.0;
+        const Real beta = 5.0, eta = 2.0, jumpIntensity = 1.0;
+
+        boost::shared_ptr<ExtendedOrnsteinUhlenbeckProcess> ouProcess(
+            new ExtendedOrnsteinUhlenbeckProcess(1.0, 2.0, x0,
+                                                 constant<Real, Real>(x0)));
+        boost::shared_ptr<ExtOUWithJumpsProcess> jumpProcess(
+            new ExtOUWithJumpsProcess(ouProcess, 0.0, beta,
+                                      jumpIntensity, eta));
+
+        boost::shared_ptr<FdmMesher> mesher(new FdmMesherComposite(
+            boost::shared_ptr<Fdm1dMesher>(
+                new FdmSimpleProcess1dMesher(51, ouProcess, 1.0)),
+            boost::shared_ptr<Fdm1dMesher>(
+                new ExponentialJump1dMesher(51, beta, jumpIntensity, eta))));
+
+        boost::shared_ptr<FdmLinearOpComposite> jumpOp(
+            new FdmExtOUJumpOp(mesher, jumpProcess,
+                               flatRate(today, 0.1, Actual365Fixed()),
+                               FdmBoundaryConditionSet(), 32));
+
+        Array rhs(mesher->layout()->size());
+        const FdmLinearOpIterator endIter = mesher->layout()->end();
+        for (FdmLinearOpIterator iter = mesher->layout()->begin();
+             iter != endIter; ++iter) {
+            rhs[iter.index()] = std::max(
+                std::exp(mesher->location(iter,0)+mesher->location(iter,1))
+                    - 30.0, 0.0);
+        }
+
+        testJumpOperatorWithMultigrid("FdmExtOUJumpOp", jumpOp, rhs);
+    }
+}
+
 void FdmLinearOpTest::testCrankNicolsonWithDamping() {
 
     BOOST_TEST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -1560,7 +2164,14 @@ test_suite* FdmLinearOpTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonAmerican));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonExpress));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmHestonHullWhiteOp));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testInPlaceOperators));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdmLinearOpTest::testTripleBandMapOnGridLines));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCSRMatrix));
     suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testBiCGstab));
+    suite->add(QUANTLIB_TEST_CASE(&FdmLinearOpTest::testGMRESAndMultigrid));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &FdmLinearOpTest::testGMRESAndMultigridWithJumps));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testCrankNicolsonWithDamping));
     suite->add(
@@ -40,7 +40,12 @@ public:
     static void testFdmHestonAmerican();
     static void testFdmHestonExpress();
     static void testFdmHestonHullWhiteOp();
+    static void testInPlaceOperators();
+    static void testTripleBandMapOnGridLines();
+    static void testCSRMatrix();
     static void testBiCGstab();
+    static void testGMRESAndMultigrid();
+    static void testGMRESAndMultigridWithJumps();
     static void testCrankNicolsonWithDamping();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
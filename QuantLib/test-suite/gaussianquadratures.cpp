@@ -173,6 +173,57 @@ void GaussianQuadraturesTest::testTabulated() {
                          (2.0/5.0), 1.0e-13);
 }
 
+void GaussianQuadraturesTest::testCachedRules() {
+     BOOST_TEST_MESSAGE("Testing cached Gaussian quadrature rules...");
+
+     const GaussLegendreIntegration legendre(24);
+     const GaussLegendreIntegration cachedLegendre(24);
+     testSingleJacobi(cachedLegendre);
+
+     const GaussGegenbauerIntegration gegenbauer(20, 1.0);
+     const GaussChebyshev2ndIntegration chebyshev2nd(20);
+
+     const GaussianQuadrature* same[][2] = {
+         { &legendre, &cachedLegendre },
+         { &gegenbauer, &chebyshev2nd } };
+
+     for (Size i=0; i < LENGTH(same); ++i) {
+         const GaussianQuadrature& q1 = *same[i][0];
+         const GaussianQuadrature& q2 = *same[i][1];
+         // the second instance must reuse the cached rule
+         if (&q1.x() != &q2.x() || &q1.weights() != &q2.weights())
+             BOOST_ERROR("equivalent quadrature rules " << i
+                         << " don't share their nodes and weights");
+     }
+
+     // different parameters must not share a cached rule
+     const GaussLaguerreIntegration laguerre(16, 0.0);
+     const GaussLaguerreIntegration shiftedLaguerre(16, 1.0);
+     const GaussHermiteIntegration hermite(16, 0.0);
+     const GaussHermiteIntegration shiftedHermite(16, 0.5);
+     const GaussLegendreIntegration lowerOrderLegendre(16);
+
+     const GaussianQuadrature* different[][2] = {
+         { &laguerre, &shiftedLaguerre },
+         { &hermite, &shiftedHermite },
+         { &legendre, &lowerOrderLegendre } };
+
+     for (Size i=0; i < LENGTH(different); ++i) {
+         const GaussianQuadrature& q1 = *different[i][0];
+         const GaussianQuadrature& q2 = *different[i][1];
+         if (&q1.x() == &q2.x()
+             || (q1.order() == q2.order()
+                 && std::equal(q1.x().begin(), q1.x().end(),
+                               q2.x().begin())))
+             BOOST_ERROR("different quadrature rules " << i
+                         << " share their nodes");
+     }
+
+     testSingle(shiftedLaguerre, "f(x) = x*exp(-x)",
+                std::ptr_fun<Real,Real>(x_inv_exp), 1.0);
+     testSingle(shiftedHermite, "f(x) = x*Gaussian(x)",
+                std::ptr_fun<Real,Real>(x_normaldistribution), 0.0);
+}
 
 test_suite* GaussianQuadraturesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Gaussian quadratures tests");
@@ -181,6 +232,7 @@ test_suite* GaussianQuadraturesTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testHermite));
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testHyperbolic));
     suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testTabulated));
+    suite->add(QUANTLIB_TEST_CASE(&GaussianQuadraturesTest::testCachedRules));
     return suite;
 }
 
@@ -32,6 +32,7 @@ class GaussianQuadraturesTest {
     static void testHermite();
     static void testHyperbolic();
     static void testTabulated();
+    static void testCachedRules();
     static boost::unit_test_framework::test_suite* suite();
 };
 
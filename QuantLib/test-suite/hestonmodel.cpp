@@ -28,6 +28,7 @@
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/coshestonengine.hpp>
 #include <ql/pricingengines/vanilla/hestonexpansionengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fddividendeuropeanengine.hpp>
@@ -290,6 +291,56 @@ void HestonModelTest::testDAXCalibration() {
     }
 }
 
+void HestonModelTest::testParallelCalibration() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration with one engine per helper...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<boost::shared_ptr<CalibrationHelper> > options
+                                                    = marketData.options;
+
+    Array calibrated[2];
+    for (Size k=0; k<2; ++k) {
+        boost::shared_ptr<HestonProcess> process(new HestonProcess(
+                        marketData.riskFreeTS, marketData.dividendYield,
+                        marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5));
+        boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+        // the first time all helpers share an engine and are
+        // repriced sequentially; the second time they can be
+        // repriced in parallel
+        boost::shared_ptr<PricingEngine> engine(
+                                     new AnalyticHestonEngine(model, 64));
+        for (Size i = 0; i < options.size(); ++i) {
+            if (k == 1)
+                engine = boost::shared_ptr<PricingEngine>(
+                                     new AnalyticHestonEngine(model, 64));
+            options[i]->setPricingEngine(engine);
+        }
+
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+        model->calibrate(options, om,
+                         EndCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8));
+        calibrated[k] = model->params();
+    }
+
+    for (Size j=0; j<calibrated[0].size(); ++j) {
+        if (std::fabs(calibrated[0][j] - calibrated[1][j]) > 1.0e-12)
+            BOOST_ERROR("calibrated parameters depend on engine sharing"
+                        << "\n    parameter:      " << j
+                        << std::setprecision(14)
+                        << "\n    shared engine:  " << calibrated[0][j]
+                        << "\n    one per helper: " << calibrated[1][j]);
+    }
+}
+
 void HestonModelTest::testAnalyticVsBlack() {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -1505,6 +1556,225 @@ void HestonModelTest::testExpansionOnFordeReference() {
     }
 }
 
+void HestonModelTest::testMultiStrikeAnalyticEngine() {
+    BOOST_TEST_MESSAGE("Testing multi-strike analytic Heston engine...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.01, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+
+    const Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    const boost::shared_ptr<HestonProcess> process(new HestonProcess(
+        riskFreeTS, dividendTS, s0, 0.04, 4.0, 0.25, 1.0, -0.5));
+    const boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+    typedef AnalyticHestonEngine::Integration Integration;
+    const AnalyticHestonEngine::ComplexLogFormula formulas[] = {
+        AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::BranchCorrection,
+        AnalyticHestonEngine::Gatheral,
+        AnalyticHestonEngine::Gatheral };
+    const Integration integrations[] = {
+        Integration::gaussLaguerre(128),
+        Integration::gaussLaguerre(128),
+        Integration::gaussLegendre(256),
+        Integration::gaussLobatto(1e-10, Null<Real>(), 100000u) };
+
+    const Real strikes[] = { 60, 80, 90, 100, 110, 120, 150 };
+    const std::vector<Real> strikeVector(strikes, strikes+LENGTH(strikes));
+    const Date maturities[] = { Date(5, January, 2003),
+                                Date(5, July, 2003),
+                                Date(5, July, 2007) };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    const Real tol = 1e-10;
+
+    for (Size i=0; i < LENGTH(integrations); ++i) {
+        const boost::shared_ptr<AnalyticHestonEngine> engine(
+            new AnalyticHestonEngine(model, formulas[i], integrations[i]));
+
+        for (Size l=0; l < 2; ++l) {
+            if (l == 1) {
+                // the cached characteristic function must not survive
+                // a change of the model parameters
+                Array params = model->params();
+                params[0] = 0.09; // theta
+                params[4] = 0.05; // v0
+                model->setParams(params);
+            }
+
+            for (Size j=0; j < LENGTH(maturities); ++j) {
+                const Time term = process->time(maturities[j]);
+                const Real rd = riskFreeTS->discount(maturities[j]);
+                const Real qd = dividendTS->discount(maturities[j]);
+
+                for (Size k=0; k < LENGTH(types); ++k) {
+                    const std::vector<Real> values =
+                        engine->multiStrikeValues(types[k], strikeVector,
+                                                  maturities[j]);
+
+                    for (Size m=0; m < LENGTH(strikes); ++m) {
+                        Real expected;
+                        Size evaluations;
+                        AnalyticHestonEngine::doCalculation(
+                            rd, qd, s0->value(), strikes[m], term,
+                            model->kappa(), model->theta(), model->sigma(),
+                            model->v0(), model->rho(),
+                            PlainVanillaPayoff(types[k], strikes[m]),
+                            integrations[i], formulas[i], 0,
+                            expected, evaluations);
+
+                        VanillaOption option(
+                            boost::make_shared<PlainVanillaPayoff>(
+                                types[k], strikes[m]),
+                            boost::make_shared<EuropeanExercise>(
+                                maturities[j]));
+                        option.setPricingEngine(engine);
+
+                        const Real calculated[] = { values[m], option.NPV() };
+                        for (Size n=0; n < LENGTH(calculated); ++n) {
+                            if (std::fabs(calculated[n]-expected) > tol) {
+                                BOOST_ERROR(
+                                    "failed to reproduce single strike price"
+                                    << "\n    strike     : " << strikes[m]
+                                    << "\n    maturity   : " << maturities[j]
+                                    << "\n    option type: " << types[k]
+                                    << "\n    integration: " << i
+                                    << "\n    calculated : " << calculated[n]
+                                    << "\n    expected   : " << expected);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        Array params = model->params();
+        params[0] = 0.25;
+        params[4] = 0.04;
+        model->setParams(params);
+    }
+}
+
+void HestonModelTest::testCOSHestonEngine() {
+    BOOST_TEST_MESSAGE("Testing COS Heston engine...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.01, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+
+    const Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    const Real kappas[] = { 4.0, 1.5 };
+    const Real thetas[] = { 0.25, 0.04 };
+    const Real sigmas[] = { 1.0, 0.3 };
+    const Real rhos[]   = { -0.5, -0.7 };
+
+    const Real strikes[] = { 70, 80, 90, 100, 110, 120, 130 };
+    const std::vector<Real> strikeVector(strikes, strikes+LENGTH(strikes));
+    const Date maturities[] = { Date(5, January, 2003),
+                                Date(5, July, 2003),
+                                Date(5, July, 2005) };
+    const Option::Type types[] = { Option::Put, Option::Call };
+
+    const Real tol = 1e-6;
+
+    for (Size i=0; i < LENGTH(kappas); ++i) {
+        const boost::shared_ptr<HestonProcess> process(new HestonProcess(
+            riskFreeTS, dividendTS, s0, 0.04,
+            kappas[i], thetas[i], sigmas[i], rhos[i]));
+        const boost::shared_ptr<HestonModel> model(new HestonModel(process));
+
+        const boost::shared_ptr<PricingEngine> analyticEngine(
+            new AnalyticHestonEngine(model, 192u));
+        const boost::shared_ptr<COSHestonEngine> cosEngine(
+            new COSHestonEngine(model));
+
+        for (Size j=0; j < LENGTH(maturities); ++j) {
+            const boost::shared_ptr<Exercise> exercise(
+                new EuropeanExercise(maturities[j]));
+
+            for (Size k=0; k < LENGTH(types); ++k) {
+                const std::vector<Real> values =
+                    cosEngine->multiStrikeValues(types[k], strikeVector,
+                                                 maturities[j]);
+
+                for (Size m=0; m < LENGTH(strikes); ++m) {
+                    VanillaOption option(
+                        boost::make_shared<PlainVanillaPayoff>(
+                            types[k], strikes[m]), exercise);
+
+                    option.setPricingEngine(analyticEngine);
+                    const Real expected = option.NPV();
+
+                    option.setPricingEngine(cosEngine);
+                    const Real calculated[] = { option.NPV(), values[m] };
+
+                    for (Size n=0; n < LENGTH(calculated); ++n) {
+                        if (std::fabs(calculated[n]-expected) > tol) {
+                            BOOST_ERROR(
+                                "failed to reproduce analytic Heston price"
+                                << "\n    strike     : " << strikes[m]
+                                << "\n    maturity   : " << maturities[j]
+                                << "\n    option type: " << types[k]
+                                << "\n    calculated : " << calculated[n]
+                                << "\n    expected   : " << expected
+                                << "\n    difference : "
+                                << calculated[n]-expected);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // options expiring today are worth their intrinsic value
+    const boost::shared_ptr<HestonModel> model(
+        new HestonModel(boost::make_shared<HestonProcess>(
+            riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.04, 0.3, -0.7)));
+    const std::vector<Real> calls = COSHestonEngine(model).multiStrikeValues(
+        Option::Call, strikeVector, settlementDate);
+    const std::vector<Real> puts = COSHestonEngine(model).multiStrikeValues(
+        Option::Put, strikeVector, settlementDate);
+    for (Size m=0; m < LENGTH(strikes); ++m) {
+        const Real expected[] = { std::max(100.0 - strikes[m], 0.0),
+                                  std::max(strikes[m] - 100.0, 0.0) };
+        const Real calculated[] = { calls[m], puts[m] };
+        for (Size n=0; n < LENGTH(calculated); ++n) {
+            if (std::fabs(calculated[n]-expected[n]) > 1e-12) {
+                BOOST_ERROR("failed to reproduce intrinsic value at expiry"
+                            << "\n    strike     : " << strikes[m]
+                            << "\n    calculated : " << calculated[n]
+                            << "\n    expected   : " << expected[n]);
+            }
+        }
+    }
+
+    // degenerate parameters must be rejected instead of giving NaN
+    const Real degenerate[][2] = { { 0.0, 0.3 }, { 1.5, 0.0 } };
+    for (Size i=0; i < LENGTH(degenerate); ++i) {
+        const boost::shared_ptr<HestonModel> degenerateModel(
+            new HestonModel(boost::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, degenerate[i][0], 0.04,
+                degenerate[i][1], -0.7)));
+        BOOST_CHECK_THROW(
+            COSHestonEngine(degenerateModel).multiStrikeValues(
+                Option::Call, strikeVector, maturities[0]),
+            Error);
+    }
+}
+
 test_suite* HestonModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Heston model tests");
 
@@ -1512,6 +1782,7 @@ test_suite* HestonModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBlackCalibration));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testParallelCalibration));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsCached));
@@ -1531,6 +1802,9 @@ test_suite* HestonModelTest::suite() {
                     &HestonModelTest::testExpansionOnAlanLewisReference));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testExpansionOnFordeReference));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testMultiStrikeAnalyticEngine));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testCOSHestonEngine));
     return suite;
 }
 
@@ -29,6 +29,7 @@ class HestonModelTest {
   public:
     static void testBlackCalibration();
     static void testDAXCalibration();
+    static void testParallelCalibration();
     static void testAnalyticVsBlack();
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
@@ -43,6 +44,8 @@ class HestonModelTest {
     static void testAnalyticPDFHestonEngine();
     static void testExpansionOnAlanLewisReference();
     static void testExpansionOnFordeReference();
+    static void testMultiStrikeAnalyticEngine();
+    static void testCOSHestonEngine();
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
 };
@@ -20,6 +20,12 @@
 #include "instruments.hpp"
 #include "utilities.hpp"
 #include <ql/instruments/stock.hpp>
+#include <ql/instruments/europeanoption.hpp>
+#include <ql/pricingengines/portfoliopricer.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/daycounters/actual360.hpp>
 #include <ql/quotes/simplequote.hpp>
 
 using namespace QuantLib;
@@ -60,10 +66,85 @@ void InstrumentTest::testObservable() {
         BOOST_FAIL("Observer was not notified of instrument change");
 }
 
+void InstrumentTest::testPortfolioPricer() {
+
+    BOOST_TEST_MESSAGE("Testing batch pricing of instrument portfolios...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<FlatForward> qTS(new FlatForward(today, 0.02, dc));
+    boost::shared_ptr<FlatForward> rTS(new FlatForward(today, 0.04, dc));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.2, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    // a few engine instances shared among the options
+    std::vector<boost::shared_ptr<PricingEngine> > engines;
+    for (Size i=0; i<3; ++i)
+        engines.push_back(boost::shared_ptr<PricingEngine>(
+                                     new AnalyticEuropeanEngine(process)));
+
+    std::vector<boost::shared_ptr<Instrument> > portfolio;
+    for (Size i=0; i<30; ++i) {
+        boost::shared_ptr<StrikedTypePayoff> payoff(new PlainVanillaPayoff(
+                      i%2 == 0 ? Option::Call : Option::Put, 80.0 + i*1.5));
+        boost::shared_ptr<Exercise> exercise(
+                     new EuropeanExercise(today + Period(1+i%5, Months)));
+        boost::shared_ptr<Instrument> option(
+                                    new EuropeanOption(payoff, exercise));
+        option->setPricingEngine(engines[i%engines.size()]);
+        portfolio.push_back(option);
+    }
+    // an instrument without engine cannot be priced
+    portfolio.push_back(boost::shared_ptr<Instrument>(new EuropeanOption(
+        boost::shared_ptr<StrikedTypePayoff>(
+                              new PlainVanillaPayoff(Option::Call, 100.0)),
+        boost::shared_ptr<Exercise>(new EuropeanExercise(today + 30)))));
+
+    std::vector<boost::shared_ptr<LazyObject> > market;
+    market.push_back(qTS);
+    market.push_back(rTS);
+
+    PortfolioPricer pricer(portfolio, market);
+    pricer.calculate();
+
+    if (pricer.failures() != 1 || pricer.errors().back().empty())
+        BOOST_FAIL("failure to price instrument without engine "
+                   "not reported");
+
+    for (Size i=0; i<portfolio.size()-1; ++i) {
+        if (!pricer.errors()[i].empty())
+            BOOST_FAIL("failed to price instrument #" << i << ": "
+                       << pricer.errors()[i]);
+        Real expected = portfolio[i]->NPV();
+        Real calculated = pricer.NPVs()[i];
+        if (std::fabs(expected-calculated) > 1.0e-12)
+            BOOST_ERROR("failed to reproduce NPV of instrument #" << i
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    // the market is no longer frozen after pricing
+    Flag f;
+    f.registerWith(portfolio.front());
+    rTS->update();
+    if (!f.isUp())
+        BOOST_FAIL("market objects still frozen after pricing");
+}
+
 
 test_suite* InstrumentTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Instrument tests");
     suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testObservable));
+    suite->add(QUANTLIB_TEST_CASE(&InstrumentTest::testPortfolioPricer));
     return suite;
 }
 
@@ -28,6 +28,7 @@
 class InstrumentTest {
   public:
     static void testObservable();
+    static void testPortfolioPricer();
     static boost::unit_test_framework::test_suite* suite();
 };
 
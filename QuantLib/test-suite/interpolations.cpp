@@ -24,11 +24,13 @@
 #include "interpolations.hpp"
 #include "utilities.hpp"
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/settings.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/math/interpolations/forwardflatinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
 #include <ql/math/interpolations/sabrinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation.hpp>
@@ -40,8 +42,12 @@
 #include <ql/math/richardsonextrapolation.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/optimization/levenbergmarquardt.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/experimental/volatility/noarbsabrinterpolation.hpp>
 #include <boost/foreach.hpp>
+#include <iomanip>
 #include <boost/assign/std/vector.hpp>
 
 
@@ -940,6 +946,106 @@ void InterpolationTest::testAsFunctor() {
 }
 
 
+namespace {
+
+    template <class I>
+    void checkBatchEvaluation(const std::string& name,
+                              const I& interpolator,
+                              const std::vector<Real>& x,
+                              const std::vector<Real>& y,
+                              const Array& points) {
+        Interpolation f = interpolator.interpolate(x.begin(), x.end(),
+                                                   y.begin());
+        f.update();
+        const Array values = f(points, true);
+
+        // the reference values are located by binary search
+        for (Size i=0; i<points.size(); ++i) {
+            const Real expected = f(points[i], true);
+            if (values[i] != expected)
+                BOOST_ERROR(name << " interpolation: "
+                            "failed to reproduce value at " << points[i]
+                            << std::setprecision(16)
+                            << "\n    batch:     " << values[i]
+                            << "\n    expected:  " << expected);
+        }
+    }
+
+    template <class I>
+    void checkBatchEvaluation(const std::string& name,
+                              const I& interpolator,
+                              const std::vector<Real>& x,
+                              const std::vector<Real>& y,
+                              const std::vector<Array>& grids) {
+        for (Size i=0; i<grids.size(); ++i)
+            checkBatchEvaluation(name, interpolator, x, y, grids[i]);
+    }
+
+}
+
+void InterpolationTest::testBatchEvaluation() {
+
+    BOOST_TEST_MESSAGE("Testing batch evaluation of interpolations...");
+
+    const Real xs[] = { 0.0, 0.1, 0.25, 0.5, 1.0, 2.0, 3.0, 5.0, 7.0, 10.0 };
+    const Real ys[] = { 0.03, 0.031, 0.029, 0.033, 0.035,
+                        0.04, 0.041, 0.043, 0.042, 0.045 };
+    const std::vector<Real> x(BEGIN(xs), END(xs)), y(BEGIN(ys), END(ys));
+
+    // sorted grid including the nodes and points outside the range
+    std::vector<Real> points(x);
+    for (Size i=0; i<=1000; ++i)
+        points.push_back(-1.0 + 12.0*i/1000.0);
+    std::sort(points.begin(), points.end());
+    const Array sorted(points.begin(), points.end());
+    const Array reversed(points.rbegin(), points.rend());
+
+    MersenneTwisterUniformRng rng(1234UL);
+    Array unsorted(500);
+    for (Size i=0; i<unsorted.size(); ++i)
+        unsorted[i] = -1.0 + 12.0*rng.next().value;
+
+    std::vector<Array> grids;
+    grids.push_back(sorted);
+    grids.push_back(reversed);
+    grids.push_back(unsorted);
+
+    checkBatchEvaluation("linear", Linear(), x, y, grids);
+    checkBatchEvaluation("backward-flat", BackwardFlat(), x, y, grids);
+    checkBatchEvaluation("forward-flat", ForwardFlat(), x, y, grids);
+    checkBatchEvaluation("cubic spline",
+                         Cubic(CubicInterpolation::Spline, false,
+                               CubicInterpolation::SecondDerivative, 0.0,
+                               CubicInterpolation::SecondDerivative, 0.0),
+                         x, y, grids);
+
+    // discount factors on a sorted time grid
+    const Date today = Settings::instance().evaluationDate();
+    std::vector<Date> dates;
+    for (Size i=0; i<x.size(); ++i)
+        dates.push_back(today + Integer(x[i]*365.0));
+    std::vector<Real> discounts(x.size());
+    for (Size i=0; i<x.size(); ++i)
+        discounts[i] = std::exp(-y[i]*x[i]);
+    const InterpolatedDiscountCurve<LogLinear> curve(dates, discounts,
+                                                     Actual365Fixed());
+    std::vector<Time> times(200);
+    for (Size i=0; i<times.size(); ++i)
+        times[i] = curve.maxTime()*i/(times.size()-1.0);
+    std::vector<DiscountFactor> calculated(times.size());
+    curve.discounts(times, &calculated[0]);
+    for (Size i=0; i<times.size(); ++i) {
+        const DiscountFactor expected = curve.discount(times[i]);
+        if (std::fabs(calculated[i] - expected) > 1.0e-15)
+            BOOST_ERROR("failed to reproduce discount factor at "
+                        << times[i]
+                        << std::setprecision(16)
+                        << "\n    batch:     " << calculated[i]
+                        << "\n    expected:  " << expected);
+    }
+}
+
+
 void InterpolationTest::testBackwardFlat() {
 
     BOOST_TEST_MESSAGE("Testing backward-flat interpolation...");
@@ -2000,6 +2106,7 @@ test_suite* InterpolationTest::suite() {
                         &InterpolationTest::testSplineErrorOnGaussianValues));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testMultiSpline));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testAsFunctor));
+    suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBatchEvaluation));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testBackwardFlat));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testForwardFlat));
     suite->add(QUANTLIB_TEST_CASE(&InterpolationTest::testSabrInterpolation));
@@ -40,6 +40,7 @@ class InterpolationTest {
     static void testSplineErrorOnGaussianValues();
     static void testMultiSpline();
     static void testAsFunctor();
+    static void testBatchEvaluation();
     // other interpolations
     static void testBackwardFlat();
     static void testForwardFlat();
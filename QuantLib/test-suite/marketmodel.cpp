@@ -26,6 +26,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include "utilities.hpp"
 #include <ql/models/marketmodels/accountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
+#include <ql/models/marketmodels/browniangenerators/partitionedbrowniangenerator.hpp>
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/models/marketmodels/callability/collectnodedata.hpp>
 #include <ql/models/marketmodels/callability/lsstrategy.hpp>
@@ -4877,6 +4878,195 @@ void MarketModelTest::testCovariance() {
     }
 }
 
+void MarketModelTest::testParallelStreams() {
+
+    BOOST_TEST_MESSAGE("Testing market-model simulations "
+                       "divided among parallel path streams...");
+
+    setup();
+
+    const Size numberOfStreams = 3;
+    const Real tolerance = 1.0e-12;
+
+    // 1. lower bound: optionlets and a swap in the accounting engine
+
+    std::vector<boost::shared_ptr<Payoff> > payoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i)
+        payoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+    MultiStepOptionlets optionlets(rateTimes, accruals,
+                                   paymentTimes, payoffs);
+    MultiStepSwap swap(rateTimes, accruals, accruals, paymentTimes,
+                       0.04, true);
+    MultiProductComposite products;
+    products.add(optionlets);
+    products.add(swap);
+    products.finalize();
+
+    EvolutionDescription evolution = products.evolution();
+    std::vector<Size> numeraires = makeMeasure(products, MoneyMarketPlus);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 4,
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    boost::shared_ptr<BrownianGeneratorFactory> factory(
+                                     new MTBrownianGeneratorFactory(seed_));
+
+    AccountingEngine serialEngine(
+        makeMarketModelEvolver(marketModel, numeraires, *factory, Pc),
+        products, initialNumeraireValue);
+    SequenceStatisticsInc serialStats(products.numberOfProducts());
+    serialEngine.multiplePathValues(serialStats, 4000);
+
+    AccountingEngine parallelEngine(
+        makeMarketModelEvolver(marketModel, numeraires,
+                               PartitionedBrownianGeneratorFactory(
+                                            factory, 0, numberOfStreams),
+                               Pc),
+        products, initialNumeraireValue);
+    for (Size k=1; k<numberOfStreams; ++k)
+        parallelEngine.addStream(
+            makeMarketModelEvolver(marketModel, numeraires,
+                                   PartitionedBrownianGeneratorFactory(
+                                            factory, k, numberOfStreams),
+                                   Pc));
+    SequenceStatisticsInc parallelStats(products.numberOfProducts());
+    // the paths are split across calls to check the stream bookkeeping
+    parallelEngine.multiplePathValues(parallelStats, 1501);
+    parallelEngine.multiplePathValues(parallelStats, 2499);
+
+    std::vector<Real> serialMeans = serialStats.mean();
+    std::vector<Real> parallelMeans = parallelStats.mean();
+    if (parallelStats.samples() != serialStats.samples())
+        BOOST_ERROR("accounting engine: " << parallelStats.samples()
+                    << " samples drawn by the streams, "
+                    << serialStats.samples() << " expected");
+    for (Size i=0; i<serialMeans.size(); ++i) {
+        if (std::fabs(parallelMeans[i]-serialMeans[i]) > tolerance)
+            BOOST_ERROR("accounting engine, " << io::ordinal(i+1)
+                        << " product:"
+                        << "\n    single stream:   " << serialMeans[i]
+                        << "\n    " << numberOfStreams << " streams:       "
+                        << parallelMeans[i]);
+    }
+
+    // 2. upper bound for a callable swap with a naif strategy
+
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               0.04, false);
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), 0.04);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), naifStrategy.exerciseTimes());
+    const Size outerPaths = 8, innerPaths = 16;
+
+    boost::shared_ptr<BrownianGeneratorFactory> outerFactory(
+        new SobolBrownianGeneratorFactory(SobolBrownianGenerator::Diagonal,
+                                          seed_+142));
+    std::vector<boost::shared_ptr<BrownianGeneratorFactory> >
+        innerFactories;
+    for (Size s=0; s<isExerciseTime.size(); ++s) {
+        if (isExerciseTime[s])
+            innerFactories.push_back(
+                boost::shared_ptr<BrownianGeneratorFactory>(
+                               new MTBrownianGeneratorFactory(seed_+s)));
+    }
+
+    std::vector<Statistics> upperBounds(2);
+    for (Size streams=1; streams<=numberOfStreams;
+         streams+=numberOfStreams-1) {
+        boost::shared_ptr<UpperBoundEngine> engine;
+        for (Size k=0; k<streams; ++k) {
+            boost::shared_ptr<MarketModelEvolver> evolver =
+                makeMarketModelEvolver(marketModel, numeraires,
+                                       PartitionedBrownianGeneratorFactory(
+                                               outerFactory, k, streams),
+                                       Pc);
+            // each outer path uses a block of inner paths
+            std::vector<boost::shared_ptr<MarketModelEvolver> >
+                innerEvolvers;
+            for (Size s=0, e=0; s<isExerciseTime.size(); ++s) {
+                if (isExerciseTime[s])
+                    innerEvolvers.push_back(
+                        makeMarketModelEvolver(
+                            marketModel, numeraires,
+                            PartitionedBrownianGeneratorFactory(
+                                 innerFactories[e++], k, streams, innerPaths),
+                            Pc, s));
+            }
+            if (k == 0)
+                engine = boost::shared_ptr<UpperBoundEngine>(
+                    new UpperBoundEngine(evolver, innerEvolvers,
+                                         receiverSwap, nullRebate,
+                                         receiverSwap, nullRebate,
+                                         naifStrategy,
+                                         initialNumeraireValue));
+            else
+                engine->addStream(evolver, innerEvolvers);
+        }
+        engine->multiplePathValues(upperBounds[streams>1 ? 1 : 0],
+                                   outerPaths, innerPaths);
+    }
+
+    if (std::fabs(upperBounds[1].mean()-upperBounds[0].mean()) > tolerance)
+        BOOST_ERROR("upper-bound engine:"
+                    << "\n    single stream:   " << upperBounds[0].mean()
+                    << "\n    " << numberOfStreams << " streams:       "
+                    << upperBounds[1].mean());
+
+    // 3. pathwise deltas of caplets
+
+    MarketModelPathwiseMultiCaplet caplets(rateTimes, accruals,
+                                           paymentTimes, todaysForwards);
+    std::vector<Size> moneyMarket = makeMeasure(optionlets, MoneyMarket);
+    boost::shared_ptr<MarketModel> abcdModel =
+        makeMarketModel(true, caplets.evolution(), 2,
+                        ExponentialCorrelationAbcdVolatility);
+    Real moneyMarketValue = todaysDiscounts[moneyMarket.front()];
+    Size numberOfValues =
+        caplets.numberOfProducts()*(todaysForwards.size()+1);
+
+    PathwiseAccountingEngine serialPathwise(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(abcdModel, *factory, moneyMarket)),
+        caplets, abcdModel, moneyMarketValue);
+    SequenceStatisticsInc serialDeltas(numberOfValues);
+    serialPathwise.multiplePathValues(serialDeltas, 3000);
+
+    PathwiseAccountingEngine parallelPathwise(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+            new LogNormalFwdRateEuler(abcdModel,
+                                      PartitionedBrownianGeneratorFactory(
+                                            factory, 0, numberOfStreams),
+                                      moneyMarket)),
+        caplets, abcdModel, moneyMarketValue);
+    for (Size k=1; k<numberOfStreams; ++k)
+        parallelPathwise.addStream(
+            boost::shared_ptr<LogNormalFwdRateEuler>(
+                new LogNormalFwdRateEuler(abcdModel,
+                                          PartitionedBrownianGeneratorFactory(
+                                                factory, k, numberOfStreams),
+                                          moneyMarket)));
+    SequenceStatisticsInc parallelDeltas(numberOfValues);
+    parallelPathwise.multiplePathValues(parallelDeltas, 3000);
+
+    serialMeans = serialDeltas.mean();
+    parallelMeans = parallelDeltas.mean();
+    for (Size i=0; i<serialMeans.size(); ++i) {
+        if (std::fabs(parallelMeans[i]-serialMeans[i]) > tolerance)
+            BOOST_ERROR("pathwise accounting engine, " << io::ordinal(i+1)
+                        << " value:"
+                        << "\n    single stream:   " << serialMeans[i]
+                        << "\n    " << numberOfStreams << " streams:       "
+                        << parallelMeans[i]);
+    }
+}
+
 // --- Call the desired tests
 test_suite* MarketModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Market-model tests");
@@ -4898,6 +5088,8 @@ test_suite* MarketModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCallableSwapNaif));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCallableSwapAnderson));
 
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelStreams));
+
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testGreeks));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdVolatilityIntegration));
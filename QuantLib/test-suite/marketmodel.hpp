@@ -38,6 +38,7 @@ class MarketModelTest {
     static void testCallableSwapNaif();
     static void testCallableSwapLS();
     static void testCallableSwapAnderson();
+    static void testParallelStreams();
     static void testGreeks();
     static void testPathwiseGreeks();
     static void testPathwiseVegas();
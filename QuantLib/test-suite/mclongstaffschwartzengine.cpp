@@ -81,7 +81,8 @@ namespace {
                             Real requiredTolerance,
                             Size maxSamples,
                             BigNatural seed,
-                            Size nCalibrationSamples = Null<Size>())
+                            Size nCalibrationSamples = Null<Size>(),
+                            bool replayCalibrationPaths = false)
         : MCLongstaffSchwartzEngine<VanillaOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -92,7 +93,8 @@ namespace {
                                                       requiredSamples,
                                                       requiredTolerance,
                                                       maxSamples,
-                                                      seed, nCalibrationSamples)
+                                                      seed, nCalibrationSamples,
+                                                      replayCalibrationPaths)
         { }
 
       protected:
@@ -315,6 +317,110 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testReplayedCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing Longstaff-Schwartz calibration "
+                       "with replayed paths...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<Exercise> americanExercise(
+        new AmericanExercise(today, Date(16, May, 2000)));
+
+    Handle<YieldTermStructure> flatTermStructure(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, 0.06, dayCounter)));
+    Handle<YieldTermStructure> flatDividendTS(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, 0.02, dayCounter)));
+    Handle<BlackVolTermStructure> flatVolTS(
+        boost::shared_ptr<BlackVolTermStructure>(
+            new BlackConstantVol(today, NullCalendar(), 0.25, dayCounter)));
+    Handle<Quote> underlyingH(
+        boost::shared_ptr<Quote>(new SimpleQuote(36.0)));
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> stochasticProcess(
+        new GeneralizedBlackScholesProcess(underlyingH, flatDividendTS,
+                                           flatTermStructure, flatVolTS));
+
+    // the regression is solved through a QR decomposition updated
+    // path by path instead of the SVD of the full design matrix; the
+    // resulting exercise strategies only differ by round-off errors.
+    const Real tolerance = 1.0e-8;
+
+    VanillaOption americanOption(
+        boost::shared_ptr<StrikedTypePayoff>(
+                               new PlainVanillaPayoff(Option::Put, 40.0)),
+        americanExercise);
+
+    Real calculated[2], exerciseProbability[2];
+    for (Size i=0; i<2; ++i) {
+        americanOption.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(stochasticProcess)
+            .withSteps(50)
+            .withAntitheticVariate()
+            .withSamples(4096)
+            .withCalibrationSamples(4096)
+            .withSeed(42)
+            .withPolynomOrder(3)
+            .withBasisSystem(LsmBasisSystem::Laguerre)
+            .withCalibrationPathsReplay(i == 1));
+        calculated[i] = americanOption.NPV();
+        exerciseProbability[i] =
+            americanOption.result<Real>("exerciseProbability");
+    }
+
+    if (std::fabs(calculated[0] - calculated[1]) > tolerance
+        || std::fabs(exerciseProbability[0]-exerciseProbability[1])
+           > tolerance) {
+        BOOST_ERROR("Failed to reproduce american option price "
+                    "with replayed calibration paths"
+                    << std::setprecision(12)
+                    << "\n    stored paths:   " << calculated[0]
+                    << " (exercise probability: "
+                    << exerciseProbability[0] << ")"
+                    << "\n    replayed paths: " << calculated[1]
+                    << " (exercise probability: "
+                    << exerciseProbability[1] << ")");
+    }
+
+    const Size numberAssets = 2;
+    Matrix corr(numberAssets, numberAssets, 0.3);
+    std::vector<boost::shared_ptr<StochasticProcess1D> > v;
+    for (Size i=0; i<numberAssets; ++i) {
+        v.push_back(stochasticProcess);
+        corr[i][i] = 1.0;
+    }
+    boost::shared_ptr<StochasticProcessArray> process(
+                                       new StochasticProcessArray(v, corr));
+
+    VanillaOption americanMaxOption(
+        boost::shared_ptr<StrikedTypePayoff>(
+                               new PlainVanillaPayoff(Option::Call, 36.0)),
+        americanExercise);
+
+    for (Size i=0; i<2; ++i) {
+        americanMaxOption.setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new MCAmericanMaxEngine<PseudoRandom>(process, 25, Null<Size>(),
+                                                  false, true, false, 2048,
+                                                  Null<Real>(), Null<Size>(),
+                                                  42, 1024, i == 1)));
+        calculated[i] = americanMaxOption.NPV();
+    }
+
+    if (std::fabs(calculated[0] - calculated[1]) > tolerance) {
+        BOOST_ERROR("Failed to reproduce american max option price "
+                    "with replayed calibration paths"
+                    << std::setprecision(12)
+                    << "\n    stored paths:   " << calculated[0]
+                    << "\n    replayed paths: " << calculated[1]);
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -322,6 +428,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testReplayedCalibration));
     return suite;
 }
 
@@ -20,14 +20,21 @@
 #include "pathgenerator.hpp"
 #include "utilities.hpp"
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/batchpathgenerator.hpp>
+#include <ql/methods/montecarlo/batchpathpricer.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/processes/hullwhiteprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <boost/make_shared.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -138,6 +145,95 @@ namespace {
         }
     }
 
+    class LastValuePricer : public PathPricer<MultiPath> {
+      public:
+        Real operator()(const MultiPath& path) const {
+            return path[path.assetNumber()-1].back();
+        }
+    };
+
+    template <class GSG>
+    MultiPath nextPath(PathGenerator<GSG>& generator, bool antithetic) {
+        return MultiPath(std::vector<Path>(1, antithetic ?
+                                           generator.antithetic().value :
+                                           generator.next().value));
+    }
+
+    template <class GSG>
+    MultiPath nextPath(MultiPathGenerator<GSG>& generator, bool antithetic) {
+        return antithetic ? generator.antithetic().value
+                          : generator.next().value;
+    }
+
+    template <class Generator>
+    void testBatch(const boost::shared_ptr<StochasticProcess>& process,
+                   const std::string& tag, bool brownianBridge) {
+        typedef PseudoRandom::rsg_type rsg_type;
+
+        BigNatural seed = 42;
+        TimeGrid grid(5.0, 10);
+        Size batchSize = 17, batches = 3;
+        Size assets = process->size();
+        Size dimension = process->factors()*(grid.size()-1);
+
+        BatchPathGenerator<rsg_type> batchGenerator(
+            process, grid, batchSize,
+            PseudoRandom::make_sequence_generator(dimension, seed),
+            brownianBridge);
+        Generator generator(
+            process, grid,
+            PseudoRandom::make_sequence_generator(dimension, seed),
+            brownianBridge);
+
+        PathPricerBatchAdapter<MultiPath> lastValue(
+                                   boost::make_shared<LastValuePricer>());
+        std::vector<Real> lastValues;
+
+        const Real tolerance = 1.0e-10;
+        std::vector<MultiPath> paths(batchSize), antitheticPaths(batchSize);
+        for (Size b=0; b<batches; ++b) {
+            for (Size p=0; p<batchSize; ++p) {
+                paths[p] = nextPath(generator, false);
+                antitheticPaths[p] = nextPath(generator, true);
+            }
+
+            for (Size k=0; k<2; ++k) {
+                const PathBatch& batch = (k == 0) ?
+                    batchGenerator.next() : batchGenerator.antithetic();
+                const std::vector<MultiPath>& expected =
+                    (k == 0) ? paths : antitheticPaths;
+                lastValue(batch, lastValues);
+
+                for (Size p=0; p<batchSize; ++p) {
+                    for (Size j=0; j<assets; ++j) {
+                        for (Size i=0; i<grid.size(); ++i) {
+                            Real calculated = batch(j, i, p);
+                            Real error = std::fabs(calculated-expected[p][j][i])
+                                / std::max(1.0, std::fabs(expected[p][j][i]));
+                            if (error > tolerance)
+                                BOOST_FAIL("failed to reproduce " << tag
+                                    << " path "
+                                    << (brownianBridge ? "with " : "without ")
+                                    << "brownian bridge"
+                                    << (k == 0 ? "" : " (antithetic)")
+                                    << ":\n"
+                                    << std::setprecision(13)
+                                    << "    asset:      " << j << "\n"
+                                    << "    time:       " << grid[i] << "\n"
+                                    << "    calculated: " << calculated << "\n"
+                                    << "    expected:   " << expected[p][j][i]
+                                    << "\n"
+                                    << "    error:      " << error);
+                        }
+                    }
+                    if (lastValues[p] != batch(assets-1, grid.size()-1, p))
+                        BOOST_FAIL("batch pricer adapter failed on "
+                                   << tag << " path");
+                }
+            }
+        }
+    }
+
 }
 
 
@@ -290,11 +386,91 @@ void PathGeneratorTest::testMultiPathGenerator() {
 }
 
 
+void PathGeneratorTest::testBatchPathGenerator() {
+
+    BOOST_TEST_MESSAGE("Testing batch path generation...");
+
+    SavedSettings backup;
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    typedef PathGenerator<rsg_type> single;
+    typedef MultiPathGenerator<rsg_type> multi;
+
+    Date today(26,April,2005);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+
+    Handle<Quote> x0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, dc));
+    Handle<YieldTermStructure> q(flatRate(0.02, dc));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, dc));
+
+    boost::shared_ptr<StochasticProcess> bsProcess(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    testBatch<single>(bsProcess, "Black-Scholes", false);
+    testBatch<single>(bsProcess, "Black-Scholes", true);
+
+    // strike-dependent volatility, evolved path by path
+    std::vector<Date> dates;
+    dates.push_back(today + Period(1, Years));
+    dates.push_back(today + Period(6, Years));
+    std::vector<Real> strikes;
+    strikes.push_back(50.0);
+    strikes.push_back(100.0);
+    strikes.push_back(150.0);
+    Matrix vols(3, 2);
+    vols[0][0] = 0.30; vols[0][1] = 0.25;
+    vols[1][0] = 0.20; vols[1][1] = 0.20;
+    vols[2][0] = 0.25; vols[2][1] = 0.22;
+    Handle<BlackVolTermStructure> surface(
+        boost::make_shared<BlackVarianceSurface>(today, TARGET(), dates,
+                                                 strikes, vols, dc));
+    testBatch<single>(boost::shared_ptr<StochasticProcess>(
+                          new BlackScholesMertonProcess(x0,q,r,surface)),
+                      "local-volatility", false);
+
+    testBatch<single>(boost::shared_ptr<StochasticProcess>(
+                          new HullWhiteProcess(r, 0.1, 0.01)),
+                      "Hull-White", false);
+    testBatch<single>(boost::shared_ptr<StochasticProcess>(
+                          new OrnsteinUhlenbeckProcess(0.1, 0.20)),
+                      "Ornstein-Uhlenbeck", true);
+
+    const HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::NonCentralChiSquareVariance,
+        HestonProcess::QuadraticExponential,
+        HestonProcess::QuadraticExponentialMartingale
+    };
+    for (Size i=0; i<LENGTH(schemes); ++i) {
+        testBatch<multi>(boost::shared_ptr<StochasticProcess>(
+                             new HestonProcess(r, q, x0, 0.04, 1.5, 0.04,
+                                               0.6, -0.7, schemes[i])),
+                         "Heston", false);
+    }
+
+    Matrix correlation(2,2);
+    correlation[0][0] = correlation[1][1] = 1.0;
+    correlation[0][1] = correlation[1][0] = 0.6;
+    std::vector<boost::shared_ptr<StochasticProcess1D> > processes(2);
+    processes[0] = boost::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma));
+    processes[1] = boost::shared_ptr<StochasticProcess1D>(
+                                 new SquareRootProcess(0.1, 0.1, 0.20, 10.0));
+    testBatch<multi>(boost::shared_ptr<StochasticProcess>(
+                         new StochasticProcessArray(processes,correlation)),
+                     "process-array", false);
+}
+
+
 test_suite* PathGeneratorTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Path generation tests");
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testPathGenerator));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testMultiPathGenerator));
+    suite->add(QUANTLIB_TEST_CASE(&PathGeneratorTest::testBatchPathGenerator));
     return suite;
 }
 
@@ -48,6 +48,7 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/pricingengines/bond/discountingbondengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/experimental/risk/parsensitivityanalysis.hpp>
 #include <iomanip>
 
 using namespace QuantLib;
@@ -759,6 +760,66 @@ void PiecewiseYieldCurveTest::testLocalBootstrapConsistency() {
 }
 
 
+void PiecewiseYieldCurveTest::testNewtonBootstrapConsistency() {
+    BOOST_TEST_MESSAGE(
+        "Testing consistency of global Newton bootstrap algorithm...");
+
+    CommonVars vars;
+    testCurveConsistency<Discount,LogLinear,NewtonBootstrap>(vars);
+    testBMACurveConsistency<Discount,LogLinear,NewtonBootstrap>(vars);
+
+    const Cubic spline(CubicInterpolation::Spline, true,
+                       CubicInterpolation::SecondDerivative, 0.0,
+                       CubicInterpolation::SecondDerivative, 0.0);
+    testCurveConsistency<ZeroYield,Cubic,NewtonBootstrap>(vars, spline);
+    testBMACurveConsistency<ZeroYield,Cubic,NewtonBootstrap>(vars, spline);
+
+    // re-bootstrapping after quote changes must give the same
+    // curve as the iterative bootstrap
+    typedef PiecewiseYieldCurve<ZeroYield,Cubic,NewtonBootstrap> NewtonCurve;
+    const NewtonCurve newtonCurve(vars.settlement, vars.instruments,
+                                  Actual360(), spline);
+    const PiecewiseYieldCurve<ZeroYield,Cubic> iterativeCurve(
+                      vars.settlement, vars.instruments, Actual360(), spline);
+
+    const Real tolerance = 1.0e-10;
+    for (Size i=0; i<vars.rates.size(); i+=3) {
+        vars.rates[i]->setValue(vars.rates[i]->value() + 0.0005);
+
+        const std::vector<Real>& x = newtonCurve.data();
+        const std::vector<Real>& y = iterativeCurve.data();
+        for (Size j=0; j<x.size(); ++j) {
+            if (std::fabs(x[j] - y[j]) > tolerance)
+                BOOST_ERROR("failed to reproduce iterative bootstrap "
+                            "after change of " << io::ordinal(i+1) <<
+                            " quote at " << io::ordinal(j) << " node"
+                            << std::setprecision(12)
+                            << "\n    newton:    " << x[j]
+                            << "\n    iterative: " << y[j]
+                            << "\n    tolerance: " << tolerance);
+        }
+    }
+
+    // the Jacobian is exact at the solution, even though the one
+    // used by the solver was updated during the re-bootstraps
+    const Matrix& jacobian = newtonCurve.jacobian();
+    if (jacobian.rows() != newtonCurve.data().size()-1
+        || jacobian.columns() != newtonCurve.data().size()-1)
+        BOOST_FAIL("wrong Jacobian dimensions: " << jacobian.rows()
+                   << "x" << jacobian.columns());
+    const Matrix& expected = iterativeCurve.jacobian();
+    for (Size i=0; i<jacobian.rows(); ++i) {
+        for (Size j=0; j<jacobian.columns(); ++j) {
+            if (std::fabs(jacobian[i][j] - expected[i][j]) > 1.0e-5)
+                BOOST_ERROR("Jacobian mismatch at (" << i << "," << j << ")"
+                            << std::setprecision(12)
+                            << "\n    newton:    " << jacobian[i][j]
+                            << "\n    iterative: " << expected[i][j]);
+        }
+    }
+}
+
+
 void PiecewiseYieldCurveTest::testObservability() {
 
     BOOST_TEST_MESSAGE("Testing observability of piecewise yield curve...");
@@ -802,6 +863,175 @@ void PiecewiseYieldCurveTest::testObservability() {
 }
 
 
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing incremental re-bootstrap after single quote changes...");
+
+    CommonVars vars, freshVars;
+
+    const PiecewiseYieldCurve<Discount,LogLinear> curve(vars.settlement,
+                                                        vars.instruments,
+                                                        Actual360());
+
+    const Real tolerance = 1.0e-10;
+    for (Size i=0; i<vars.rates.size(); i+=2) {
+        const std::vector<Real> previous = curve.data();
+
+        vars.rates[i]->setValue(vars.rates[i]->value() + 0.0005);
+        freshVars.rates[i]->setValue(vars.rates[i]->value());
+        const std::vector<Real>& data = curve.data();
+
+        // nodes before the changed instrument are not solved again...
+        for (Size j=0; j<=i; ++j) {
+            if (data[j] != previous[j])
+                BOOST_ERROR(io::ordinal(j) << " node changed after "
+                            "change of " << io::ordinal(i+1) << " quote"
+                            << std::setprecision(16)
+                            << "\n    before: " << previous[j]
+                            << "\n    after:  " << data[j]);
+        }
+
+        // ...and the result is the same as for a full bootstrap
+        const PiecewiseYieldCurve<Discount,LogLinear> fresh(
+                                                    freshVars.settlement,
+                                                    freshVars.instruments,
+                                                    Actual360());
+        const std::vector<Real>& expected = fresh.data();
+        for (Size j=0; j<data.size(); ++j) {
+            if (std::fabs(data[j] - expected[j]) > tolerance)
+                BOOST_ERROR("failed to reproduce full bootstrap "
+                            "after change of " << io::ordinal(i+1) <<
+                            " quote at " << io::ordinal(j) << " node"
+                            << std::setprecision(12)
+                            << "\n    incremental: " << data[j]
+                            << "\n    full:        " << expected[j]
+                            << "\n    tolerance:   " << tolerance);
+        }
+    }
+
+    // a change in other observables together with a helper must
+    // still cause a full bootstrap, even when notifications are
+    // collected and sent at once
+    boost::shared_ptr<SimpleQuote> jump(new SimpleQuote(0.999)),
+                                   freshJump(new SimpleQuote(0.999));
+    std::vector<Date> jumpDates(1, vars.calendar.advance(vars.settlement,
+                                                         1, Years));
+    const PiecewiseYieldCurve<Discount,LogLinear> jumpCurve(
+                      vars.settlement, vars.instruments, Actual360(),
+                      std::vector<Handle<Quote> >(1, Handle<Quote>(jump)),
+                      jumpDates);
+    jumpCurve.data();
+
+    const Size last = vars.rates.size()-1;
+    for (Size deferred=0; deferred<2; ++deferred) {
+        if (deferred)
+            ObservableSettings::instance().disableUpdates(true);
+        jump->setValue(jump->value() - 0.001);
+        vars.rates[last]->setValue(vars.rates[last]->value() + 0.0005);
+        if (deferred)
+            ObservableSettings::instance().enableUpdates();
+        freshJump->setValue(jump->value());
+        freshVars.rates[last]->setValue(vars.rates[last]->value());
+
+        const std::vector<Real>& data = jumpCurve.data();
+        const PiecewiseYieldCurve<Discount,LogLinear> fresh(
+                 freshVars.settlement, freshVars.instruments, Actual360(),
+                 std::vector<Handle<Quote> >(1, Handle<Quote>(freshJump)),
+                 jumpDates);
+        const std::vector<Real>& expected = fresh.data();
+        for (Size j=0; j<data.size(); ++j) {
+            if (std::fabs(data[j] - expected[j]) > tolerance)
+                BOOST_ERROR("failed to reproduce full bootstrap "
+                            "after change of jump and last quote"
+                            << (deferred ? " (deferred)" : "")
+                            << " at " << io::ordinal(j) << " node"
+                            << std::setprecision(12)
+                            << "\n    incremental: " << data[j]
+                            << "\n    full:        " << expected[j]
+                            << "\n    tolerance:   " << tolerance);
+        }
+    }
+}
+
+
+void PiecewiseYieldCurveTest::testParSensitivities() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing par-rate sensitivities from bootstrap Jacobian...");
+
+    CommonVars vars;
+
+    const boost::shared_ptr<PiecewiseYieldCurve<Discount,LogLinear> > curve(
+        new PiecewiseYieldCurve<Discount,LogLinear>(vars.settlement,
+                                                    vars.instruments,
+                                                    Actual360()));
+    RelinkableHandle<YieldTermStructure> curveHandle(curve);
+    boost::shared_ptr<IborIndex> euribor6m(new Euribor6M(curveHandle));
+
+    // the node sensitivities are the inverse of the Jacobian
+    const Matrix jacobian = curve->jacobian();
+    const Matrix nodeSensitivities = curve->nodeSensitivities();
+    const Matrix identity = jacobian*nodeSensitivities;
+    for (Size i=0; i<identity.rows(); ++i) {
+        for (Size j=0; j<identity.columns(); ++j) {
+            const Real expected = (i == j) ? 1.0 : 0.0;
+            if (std::fabs(identity[i][j] - expected) > 1.0e-10)
+                BOOST_ERROR("node sensitivities are not the inverse "
+                            "of the Jacobian at (" << i << "," << j << ")"
+                            << "\n    product: " << identity[i][j]);
+        }
+    }
+
+    std::vector<boost::shared_ptr<Instrument> > portfolio;
+    const Integer tenors[] = { 2, 7, 13, 30 };
+    const Rate fixedRates[] = { 0.045, 0.052, 0.058, 0.06 };
+    for (Size i=0; i<LENGTH(tenors); ++i) {
+        boost::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap(tenors[i]*Years, euribor6m, fixedRates[i])
+            .withEffectiveDate(vars.settlement)
+            .withNominal(1000000.0)
+            .withFixedLegDayCount(vars.fixedLegDayCounter)
+            .withFixedLegTenor(Period(vars.fixedLegFrequency))
+            .withFixedLegConvention(vars.fixedLegConvention)
+            .withFixedLegTerminationDateConvention(vars.fixedLegConvention);
+        portfolio.push_back(swap);
+    }
+    const Real quantities[] = { 1.0, -2.0, 0.5, 1.0 };
+    const std::vector<Real> quantity(quantities, quantities+LENGTH(quantities));
+
+    const std::vector<Real> calculated =
+        parAnalysis(curve, curveHandle, portfolio, quantity, 1.0e-6);
+
+    // bump and re-bootstrap for each quote
+    std::vector<Handle<SimpleQuote> > quotes;
+    for (Size i=0; i<vars.rates.size(); ++i)
+        quotes.push_back(Handle<SimpleQuote>(vars.rates[i]));
+    const std::vector<Real> expected =
+        bucketAnalysis(quotes, portfolio, quantity, 1.0e-6).first;
+
+    if (calculated.size() != expected.size())
+        BOOST_FAIL("wrong number of par sensitivities: "
+                   << calculated.size() << " instead of " << expected.size());
+
+    // relative to the largest sensitivity, as the ones to the short
+    // deposits almost cancel out
+    Real scale = 0.0;
+    for (Size i=0; i<expected.size(); ++i)
+        scale = std::max(scale, std::fabs(expected[i]));
+
+    const Real tolerance = 1.0e-6*scale;
+    for (Size i=0; i<expected.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce par sensitivity to "
+                        << io::ordinal(i+1) << " quote"
+                        << std::setprecision(10)
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+}
+
+
 void PiecewiseYieldCurveTest::testLiborFixing() {
 
     BOOST_TEST_MESSAGE(
@@ -1066,8 +1296,14 @@ test_suite* PiecewiseYieldCurveTest::suite() {
              &PiecewiseYieldCurveTest::testConvexMonotoneForwardConsistency));
     suite->add(QUANTLIB_TEST_CASE(
              &PiecewiseYieldCurveTest::testLocalBootstrapConsistency));
+    suite->add(QUANTLIB_TEST_CASE(
+             &PiecewiseYieldCurveTest::testNewtonBootstrapConsistency));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &PiecewiseYieldCurveTest::testIncrementalBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                   &PiecewiseYieldCurveTest::testParSensitivities));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testLiborFixing));
 
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testJpyLibor));
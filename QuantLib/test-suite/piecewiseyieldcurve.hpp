@@ -41,8 +41,11 @@ class PiecewiseYieldCurveTest {
 
     static void testConvexMonotoneForwardConsistency();
     static void testLocalBootstrapConsistency();
+    static void testNewtonBootstrapConsistency();
 
     static void testObservability();
+    static void testIncrementalBootstrap();
+    static void testParSensitivities();
     static void testLiborFixing();
 
     static void testJpyLibor();
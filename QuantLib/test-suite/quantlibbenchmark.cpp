@@ -22,54 +22,30 @@
  QuantLib Benchmark Suite
 
  Measures the performance of a preselected set of numerically intensive
- test cases. The overall QuantLib Benchmark Index is given by the average
- performance in mflops.
-
- The number of floating point operations of a given test case was measured
- using the perfex library, http://user.it.uu.se/~mikpe/linux/perfctr
- and PAPI, http://icl.cs.utk.edu/papi
-
- Example results: 1. i7 4702HQ@2.2GHz       :6524.9 mflops
- 	 	 	 	  2. i7 870@2.93GHz         :4759.2 mflops
-                  3. Core2 Q9300@2.5Ghz     :2272.6 mflops
-                  4. Core2 Q6600@2.4Ghz     :1984.0 mflops
-                  5. i3 540@3.1Ghz          :1755.3 mflops
-                  6. Core2 Dual@2.0Ghz      : 835.9 mflops
-                  7. Athlon 64 X2 4400+     : 824.2 mflops
-                  8. Core2 Dual@2.0Ghz      : 754.1 mflops
-                  9. Pentium4 Dual@2.8Ghz   : 423.8 mflops
-                 10. Pentium4@3.0Ghz        : 266.3 mflops
-                 11. PentiumIII@1.1Ghz      : 146.2 mflops
-                 12. Alpha 2xEV68@833Mhz    : 184.6 mflops
-                 13. Raspberry Pi ARM@700Mhz:  28.3 mflops
-                 14. Strong ARM@206Mhz      :   1.4 mflops
-
- Remarks: OS: Linux, static libs
-  1. g++-4.8.1 -O3 -ffast-math -march=core-avx2
-      Remark: eight processes
-  2. gcc-4.6.3, -O3 -ffast-math -mfpmath=sse,387 -march=corei7
-      Remark: eight processes
-  3. icc-11.0,  -gcc-version=420 -fast -fp-model fast=2 -ipo-jobs2
-      Remark: four processes
-  4. icc-11.0,  -gcc-version=420 -fast -fp-model fast=2 -ipo-jobs2
-      Remark: four processes
-  5. gcc-4.4.5, -O3 -ffast-math -mfpmath=sse,387 -msse4.2 -march=core2
-      Remark: four processes
-  6. icc-11.0,  -gcc-version=420 -fast -fp-model fast=2 -ipo-jobs2
-      Remark: two processes
-  7. icc-11.0,  -gcc-version=420 -xSSSE3 -O3 -ipo -no-prec-div -static
-                -fp-model fast=2 -ipo-jobs2, Remark: two processes
-  8. gcc-4.2.1, -O3 -ffast-math -mfpmath=sse,387 -msse3 -funroll-all-loops
-      Remark: two processes
-  9. gcc-4.0.1, -O3 -march=pentium4 -ffast-math
-      -mfpmath=sse,387 -msse2 -funroll-all-loops, Remark: two processes
- 10. gcc-4.0.1, -O3 -march=pentium4 -ffast-math
-                -mfpmath=sse,387 -msse2 -funroll-all-loops
- 11. gcc-4.1.1, -O3 -march=pentium3 -ffast-math
-                -mfpmath=sse,387 -msse -funroll-all-loops
- 12. gcc-3.3.5, -O3 -mcpu=e67 -funroll-all-loops, Remark: two processes
- 13. gcc-4.6.3, -O3
- 14. gcc-3.4.3, -O2 -g on a Zaurus PDA
+ kernels and test cases, grouped by subsystem (curves, fd, mc,
+ calibration, cashflows, calendars, ...). Every benchmark is run
+ several times; the suite reports the minimum, median, mean and
+ standard deviation of the wall-clock time, the number of operations
+ per second based on the median time and the number of heap
+ allocations per run.
+
+ Options are read from the command line (with recent Boost versions
+ they have to be given after a "--" separator):
+
+   --repetitions=n      number of timed runs per benchmark (default 3)
+   --subsystems=a,b,..  only run benchmarks of the given subsystems
+   --format=json|csv    machine-readable output format
+   --output=file        write the machine-readable results to file
+                        instead of the standard output
+   --baseline=file      csv results of a former run; benchmarks whose
+                        median time exceeds the baseline by more than
+                        the tolerance are reported as failures
+   --tolerance=x        relative tolerance for the baseline comparison
+                        (default 0.1)
+
+ Example:
+   quantlib-benchmark -- --format=csv --output=current.csv \
+                         --baseline=reference.csv
 
   This benchmark is derived from quantlibtestsuite.cpp. Please see the
   copyrights therein.
@@ -77,17 +53,49 @@
 
 #include <ql/types.hpp>
 #include <ql/version.hpp>
+#include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/methods/finitedifferences/meshers/uniformgridmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/models/equity/hestonmodel.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/time/calendars/japan.hpp>
+#include <ql/time/calendars/jointcalendar.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/unitedkingdom.hpp>
+#include <ql/time/calendars/unitedstates.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
 #include <boost/test/unit_test.hpp>
-#include <boost/timer.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
-#include <list>
+#include <map>
+#include <new>
+#include <set>
+#include <sstream>
 #include <string>
-
-/* PAPI code
-#include <stdio.h
-#include <papi.h>
-*/
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /* Use BOOST_MSVC instead of _MSC_VER since some other vendors (Metrowerks,
    for example) also #define _MSC_VER
@@ -127,98 +135,602 @@
 #include "riskstats.hpp"
 #include "shortratemodels.hpp"
 
+using namespace QuantLib;
 using namespace boost::unit_test_framework;
 
 
+namespace {
+
+    // heap allocations are counted by the replacement operator new below
+    unsigned long allocationCount = 0;
+    unsigned long allocatedBytes = 0;
+
+    void recordAllocation(std::size_t size) {
+        #pragma omp atomic
+        ++allocationCount;
+        #pragma omp atomic
+        allocatedBytes += size;
+    }
+
+}
+
+#if defined(BOOST_NO_CXX11_NOEXCEPT)
+#define QL_BENCHMARK_BAD_ALLOC throw(std::bad_alloc)
+#define QL_BENCHMARK_NOTHROW throw()
+#else
+#define QL_BENCHMARK_BAD_ALLOC
+#define QL_BENCHMARK_NOTHROW noexcept
+#endif
+
+void* operator new(std::size_t size) QL_BENCHMARK_BAD_ALLOC {
+    recordAllocation(size);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) QL_BENCHMARK_BAD_ALLOC {
+    return operator new(size);
+}
+
+void operator delete(void* p) QL_BENCHMARK_NOTHROW {
+    std::free(p);
+}
+
+void operator delete[](void* p) QL_BENCHMARK_NOTHROW {
+    std::free(p);
+}
+
+
 namespace {
 
     class Benchmark {
       public:
-        typedef void (*fct_ptr)();
-        Benchmark(std::string name, fct_ptr f, double mflop)
-        : f_(f), name_(name), mflop_(mflop) {
-        }
+        Benchmark(const std::string& name,
+                  const std::string& subsystem,
+                  const boost::function<void()>& f,
+                  Real ops = 1.0,
+                  const std::string& unit = "runs")
+        : name_(name), subsystem_(subsystem), unit_(unit), f_(f), ops_(ops) {}
+
+        void run() const { f_(); }
+        const std::string& name() const { return name_; }
+        const std::string& subsystem() const { return subsystem_; }
+        const std::string& unit() const { return unit_; }
+        //! operations performed by a single run
+        Real ops() const { return ops_; }
+      private:
+        std::string name_, subsystem_, unit_;
+        boost::function<void()> f_;
+        Real ops_;
+    };
 
-        test_case* getTestCase() const {
-            return QUANTLIB_TEST_CASE(f_);
+    struct BenchmarkResult {
+        std::vector<Real> times;
+        Real allocations, allocatedBytes;
+
+        Real min() const {
+            return *std::min_element(times.begin(), times.end());
         }
-        double getMflop() const {
-            return mflop_;
+        Real median() const {
+            std::vector<Real> t(times);
+            std::sort(t.begin(), t.end());
+            const Size n = t.size();
+            return (n % 2 == 1) ? t[n/2] : 0.5*(t[n/2-1] + t[n/2]);
         }
-        std::string getName() const {
-            return name_;
+        Real mean() const {
+            Real sum = 0.0;
+            for (Size i=0; i<times.size(); ++i)
+                sum += times[i];
+            return sum/times.size();
+        }
+        Real standardDeviation() const {
+            const Size n = times.size();
+            if (n < 2)
+                return 0.0;
+            const Real m = mean();
+            Real sum = 0.0;
+            for (Size i=0; i<n; ++i)
+                sum += (times[i]-m)*(times[i]-m);
+            return std::sqrt(sum/(n-1));
         }
-      private:
-        fct_ptr f_;
-        const std::string name_;
-        const double mflop_; // total number of mega floating
-                             // point operations (not per sec!)
     };
 
-    boost::timer t;
-    std::list<double> runTimes;
-    std::list<Benchmark> bm;
+    struct BenchmarkOptions {
+        BenchmarkOptions() : repetitions(3), tolerance(0.1) {}
+        Size repetitions;
+        Real tolerance;
+        std::string format, output, baseline;
+        std::set<std::string> subsystems;
+    };
+
+    BenchmarkOptions options;
+    std::vector<Benchmark> bm;
+    std::map<std::string, BenchmarkResult> results;
+
+    Real wallClock() {
+        using namespace boost::posix_time;
+        static const ptime epoch = microsec_clock::universal_time();
+        return (microsec_clock::universal_time() - epoch)
+            .total_microseconds()*1e-6;
+    }
+
+    std::string libraryName() {
+        #ifdef BOOST_MSVC
+        return QL_LIB_NAME;
+        #else
+        return "QuantLib " QL_VERSION;
+        #endif
+    }
+
+    int numberOfThreads() {
+        #ifdef _OPENMP
+        return omp_get_max_threads();
+        #else
+        return 1;
+        #endif
+    }
 
-    /* PAPI code
-    float real_time, proc_time, mflops;
-    long_long lflop, flop=0;
-    */
+    std::string escapeJson(const std::string& s) {
+        std::string result;
+        for (Size i=0; i<s.size(); ++i) {
+            if (s[i] == '"' || s[i] == '\\')
+                result += '\\';
+            result += s[i];
+        }
+        return result;
+    }
 
-    void startTimer() {
-        t.restart();
+    void parseOptions(int argc, char** argv) {
+        for (int i=1; i<argc; ++i) {
+            const std::string arg(argv[i]);
+            if (arg.compare(0, 2, "--") != 0
+                || arg.find('=') == std::string::npos)
+                continue;
+
+            const std::string key = arg.substr(2, arg.find('=')-2);
+            const std::string value = arg.substr(arg.find('=')+1);
+
+            if (key == "repetitions") {
+                options.repetitions = std::max(1, std::atoi(value.c_str()));
+            } else if (key == "tolerance") {
+                options.tolerance = std::atof(value.c_str());
+            } else if (key == "format") {
+                QL_REQUIRE(value == "json" || value == "csv",
+                           "unknown output format " << value);
+                options.format = value;
+            } else if (key == "output") {
+                options.output = value;
+            } else if (key == "baseline") {
+                options.baseline = value;
+            } else if (key == "subsystems") {
+                std::istringstream in(value);
+                std::string subsystem;
+                while (std::getline(in, subsystem, ','))
+                    options.subsystems.insert(subsystem);
+            }
+        }
+    }
 
-        /* PAPI code
-        lflop = flop;
-        PAPI_flops(&real_time, &proc_time, &flop, &mflops);
-        */
+    // baseline median times read from a former csv output
+    std::map<std::string, Real> readBaseline(const std::string& fileName) {
+        std::ifstream in(fileName.c_str());
+        QL_REQUIRE(in, "could not open baseline file " << fileName);
+
+        std::map<std::string, Real> baseline;
+        std::string line;
+        std::getline(in, line);
+        while (std::getline(in, line)) {
+            std::vector<std::string> fields;
+            std::istringstream fin(line);
+            std::string field;
+            while (std::getline(fin, field, ','))
+                fields.push_back(field);
+            if (fields.size() > 6)
+                baseline[fields[0]] = std::atof(fields[6].c_str());
+        }
+        return baseline;
     }
 
-    void stopTimer() {
-        runTimes.push_back(t.elapsed());
+    void writeCsv(std::ostream& out) {
+        out << "name,subsystem,unit,ops,repetitions,min,median,mean,"
+            << "stddev,ops_per_second,allocations,allocated_bytes"
+            << std::endl;
+        out << std::setprecision(8);
+        for (Size i=0; i<bm.size(); ++i) {
+            if (results.find(bm[i].name()) == results.end())
+                continue;
+            const BenchmarkResult& r = results[bm[i].name()];
+            out << bm[i].name() << ','
+                << bm[i].subsystem() << ','
+                << bm[i].unit() << ','
+                << bm[i].ops() << ','
+                << r.times.size() << ','
+                << r.min() << ','
+                << r.median() << ','
+                << r.mean() << ','
+                << r.standardDeviation() << ','
+                << bm[i].ops()/r.median() << ','
+                << r.allocations << ','
+                << r.allocatedBytes << std::endl;
+        }
+    }
 
-        /* PAPI code
-        PAPI_flops(&real_time, &proc_time, &flop, &mflops);
-        printf("Real_time: %f Proc_time: %f Total mflop: %f\n",
-               real_time, proc_time, (flop-lflop)/1e6);
-        */
+    void writeJson(std::ostream& out) {
+        out << std::setprecision(8);
+        out << "{" << std::endl
+            << "  \"library\": \"" << escapeJson(libraryName()) << "\","
+            << std::endl
+            << "  \"threads\": " << numberOfThreads() << "," << std::endl
+            << "  \"repetitions\": " << options.repetitions << ","
+            << std::endl
+            << "  \"benchmarks\": [" << std::endl;
+
+        bool first = true;
+        for (Size i=0; i<bm.size(); ++i) {
+            if (results.find(bm[i].name()) == results.end())
+                continue;
+            const BenchmarkResult& r = results[bm[i].name()];
+            if (!first)
+                out << "," << std::endl;
+            first = false;
+            out << "    {\"name\": \"" << escapeJson(bm[i].name())
+                << "\", \"subsystem\": \"" << bm[i].subsystem()
+                << "\", \"unit\": \"" << bm[i].unit()
+                << "\", \"ops\": " << bm[i].ops()
+                << ", \"min\": " << r.min()
+                << ", \"median\": " << r.median()
+                << ", \"mean\": " << r.mean()
+                << ", \"stddev\": " << r.standardDeviation()
+                << ", \"ops_per_second\": " << bm[i].ops()/r.median()
+                << ", \"allocations\": " << r.allocations
+                << ", \"allocated_bytes\": " << r.allocatedBytes
+                << "}";
+        }
+        out << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
+
+    void runBenchmark(Size i) {
+        const Benchmark& b = bm[i];
+        BenchmarkResult& r = results[b.name()];
+        r.allocations = r.allocatedBytes = 0.0;
+
+        for (Size k=0; k<options.repetitions; ++k) {
+            const unsigned long allocations = allocationCount;
+            const unsigned long bytes = allocatedBytes;
+            const Real start = wallClock();
+
+            b.run();
+
+            r.times.push_back(wallClock() - start);
+            r.allocations += Real(allocationCount - allocations);
+            r.allocatedBytes += Real(allocatedBytes - bytes);
+        }
+        r.allocations /= options.repetitions;
+        r.allocatedBytes /= options.repetitions;
     }
 
     void printResults() {
-        std::string header = "Benchmark Suite "
-        #ifdef BOOST_MSVC
-        QL_LIB_NAME;
-        #else
-        "QuantLib " QL_VERSION;
-        #endif
+        const std::string header = "Benchmark Suite " + libraryName();
 
         std::cout << std::endl
-                  << std::string(56,'-') << std::endl;
-        std::cout << header << std::endl;
-        std::cout << std::string(56,'-')
+                  << std::string(100,'-') << std::endl;
+        std::cout << header << " ("
+                  << numberOfThreads() << " threads, "
+                  << options.repetitions << " repetitions)" << std::endl;
+        std::cout << std::string(100,'-')
                   << std::endl << std::endl;
 
-        double sum=0;
-        std::list<double>::const_iterator iterT = runTimes.begin();
-        std::list<Benchmark>::const_iterator iterBM = bm.begin();
-
-        while (iterT != runTimes.end()) {
-            const double mflopsPerSec = iterBM->getMflop()/(*iterT);
-            std::cout << iterBM->getName()
-                      << std::string(42-iterBM->getName().length(),' ') << ":"
-                      << std::fixed << std::setw(6) << std::setprecision(1)
-                      << mflopsPerSec
-                      << " mflops" << std::endl;
-
-            sum+=mflopsPerSec;
-            iterT++;
-            iterBM++;
+        std::map<std::string, Real> baseline;
+        if (!options.baseline.empty())
+            baseline = readBaseline(options.baseline);
+
+        Real logRatioSum = 0.0;
+        Size compared = 0;
+        for (Size i=0; i<bm.size(); ++i) {
+            if (results.find(bm[i].name()) == results.end())
+                continue;
+            const BenchmarkResult& r = results[bm[i].name()];
+            const Real median = r.median();
+
+            std::cout << std::left << std::setw(48) << bm[i].name()
+                      << std::setw(12) << bm[i].subsystem() << std::right
+                      << std::fixed << std::setprecision(4)
+                      << std::setw(10) << median << " s +/-"
+                      << std::setw(7) << std::setprecision(1)
+                      << 100.0*r.standardDeviation()/median << "%"
+                      << std::scientific << std::setprecision(3)
+                      << std::setw(11) << bm[i].ops()/median << " "
+                      << bm[i].unit() << "/s"
+                      << std::fixed << std::setprecision(0)
+                      << std::setw(11) << r.allocations << " allocs";
+
+            std::map<std::string, Real>::const_iterator iter =
+                baseline.find(bm[i].name());
+            if (iter != baseline.end() && iter->second > 0.0) {
+                const Real ratio = median/iter->second;
+                logRatioSum += std::log(ratio);
+                ++compared;
+                std::cout << std::setprecision(3) << "  x" << ratio;
+                if (ratio > 1.0 + options.tolerance) {
+                    std::cout << " REGRESSION";
+                    BOOST_ERROR(bm[i].name() << " is slower than the baseline"
+                                << "\n    median time:   " << median
+                                << "\n    baseline time: " << iter->second
+                                << "\n    tolerance:     "
+                                << options.tolerance);
+                }
+            }
+            std::cout << std::endl;
+        }
+
+        std::cout << std::string(100,'-') << std::endl;
+        if (compared > 0)
+            std::cout << "geometric mean of time ratios vs baseline: "
+                      << std::fixed << std::setprecision(3)
+                      << std::exp(logRatioSum/compared) << std::endl;
+
+        if (options.format == "csv" || options.format == "json") {
+            std::ofstream file;
+            if (!options.output.empty()) {
+                file.open(options.output.c_str());
+                QL_REQUIRE(file, "could not open " << options.output);
+            }
+            std::ostream& out = options.output.empty() ? std::cout : file;
+            if (options.format == "csv")
+                writeCsv(out);
+            else
+                writeJson(out);
+        }
+    }
+
+
+    // dedicated kernels
+
+    void bootstrapSwapCurve() {
+        SavedSettings backup;
+
+        const Calendar calendar = TARGET();
+        const Date today = calendar.adjust(Date(15, March, 2016));
+        Settings::instance().evaluationDate() = today;
+        const Date settlement = calendar.advance(today, 2, Days);
+
+        const boost::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+
+        const Integer depositMonths[] = { 1, 2, 3, 6, 9, 12 };
+        const Integer swapYears[] = { 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                      12, 15, 20, 25, 30 };
+        const Size nDeposits = LENGTH(depositMonths);
+        const Size nSwaps = LENGTH(swapYears);
+
+        std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+        std::vector<boost::shared_ptr<RateHelper> > helpers;
+        for (Size i=0; i<nDeposits; ++i) {
+            quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                new SimpleQuote(0.01 + 0.0005*i)));
+            helpers.push_back(boost::shared_ptr<RateHelper>(
+                new DepositRateHelper(Handle<Quote>(quotes.back()),
+                                      depositMonths[i]*Months, 2, calendar,
+                                      ModifiedFollowing, true,
+                                      Actual360())));
+        }
+        for (Size i=0; i<nSwaps; ++i) {
+            quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                new SimpleQuote(0.015 + 0.001*i)));
+            helpers.push_back(boost::shared_ptr<RateHelper>(
+                new SwapRateHelper(Handle<Quote>(quotes.back()),
+                                   swapYears[i]*Years, calendar, Annual,
+                                   Unadjusted, Thirty360(), euribor6m)));
+        }
+
+        const boost::shared_ptr<YieldTermStructure> curve(
+            new PiecewiseYieldCurve<Discount, LogLinear>(
+                                   settlement, helpers, Actual365Fixed()));
+
+        // every bump triggers a full bootstrap
+        for (Size i=0; i<20; ++i) {
+            boost::shared_ptr<SimpleQuote> q = quotes[i % quotes.size()];
+            q->setValue(q->value() + 0.0001);
+            QL_REQUIRE(curve->discount(30.0) > 0.0, "invalid curve");
         }
-        std::cout << std::string(56,'-') << std::endl
-                  << "QuantLib Benchmark Index                  :"
-                  << std::fixed << std::setw(6) << std::setprecision(1)
-                  << sum/runTimes.size()
-                  << " mflops" << std::endl;
     }
+
+    boost::shared_ptr<BlackScholesMertonProcess> blackScholesProcess(
+                                                        const Date& today) {
+        const DayCounter dc = Actual365Fixed();
+        return boost::shared_ptr<BlackScholesMertonProcess>(
+            new BlackScholesMertonProcess(
+                Handle<Quote>(boost::shared_ptr<Quote>(
+                                                new SimpleQuote(100.0))),
+                Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+                Handle<YieldTermStructure>(flatRate(today, 0.03, dc)),
+                Handle<BlackVolTermStructure>(flatVol(today, 0.25, dc))));
+    }
+
+    void priceFdAmericanOptions() {
+        SavedSettings backup;
+
+        const Date today(15, March, 2016);
+        Settings::instance().evaluationDate() = today;
+
+        const boost::shared_ptr<PricingEngine> engine(
+            new FdBlackScholesVanillaEngine(blackScholesProcess(today),
+                                            200, 400));
+        const boost::shared_ptr<Exercise> exercise(
+                              new AmericanExercise(today, today + 2*Years));
+
+        for (Size i=0; i<5; ++i) {
+            VanillaOption option(
+                boost::shared_ptr<StrikedTypePayoff>(
+                    new PlainVanillaPayoff(Option::Put, 80.0 + 10.0*i)),
+                exercise);
+            option.setPricingEngine(engine);
+            QL_REQUIRE(option.NPV() > 0.0, "invalid option price");
+        }
+    }
+
+    void priceFdHestonOption() {
+        SavedSettings backup;
+
+        const Date today(15, March, 2016);
+        Settings::instance().evaluationDate() = today;
+        const DayCounter dc = Actual365Fixed();
+
+        const boost::shared_ptr<HestonProcess> process(new HestonProcess(
+            Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+            Handle<YieldTermStructure>(flatRate(today, 0.03, dc)),
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(100.0))),
+            0.04, 1.5, 0.04, 0.5, -0.7));
+
+        VanillaOption option(
+            boost::shared_ptr<StrikedTypePayoff>(
+                new PlainVanillaPayoff(Option::Call, 100.0)),
+            boost::shared_ptr<Exercise>(
+                new EuropeanExercise(today + Period(1, Years))));
+        option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new FdHestonVanillaEngine(boost::shared_ptr<HestonModel>(
+                                          new HestonModel(process)),
+                                      50, 200, 50)));
+        QL_REQUIRE(option.NPV() > 0.0, "invalid option price");
+    }
+
+    const Size fdSteps = 100;
+
+    // Douglas time steps on a Heston operator built once; after the
+    // first step has created the scratch buffers of the scheme and of
+    // the operator, stepping must not allocate any more.
+    class HestonDouglasSteps {
+      public:
+        HestonDouglasSteps() {
+            const Date today(15, March, 2016);
+            const DayCounter dc = Actual365Fixed();
+
+            const boost::shared_ptr<HestonProcess> process(
+                new HestonProcess(
+                    Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+                    Handle<YieldTermStructure>(flatRate(today, 0.03, dc)),
+                    Handle<Quote>(boost::shared_ptr<Quote>(
+                                                new SimpleQuote(100.0))),
+                    0.04, 1.5, 0.04, 0.5, -0.7));
+
+            std::vector<Size> dim(2);
+            dim[0] = 200; dim[1] = 50;
+            std::vector<std::pair<Real, Real> > boundaries;
+            boundaries.push_back(std::make_pair(std::log(20.0),
+                                                std::log(500.0)));
+            boundaries.push_back(std::make_pair(0.0, 1.0));
+            const boost::shared_ptr<FdmMesher> mesher(new UniformGridMesher(
+                boost::shared_ptr<FdmLinearOpLayout>(
+                                             new FdmLinearOpLayout(dim)),
+                boundaries));
+
+            scheme_ = boost::shared_ptr<DouglasScheme>(new DouglasScheme(
+                0.5, boost::shared_ptr<FdmLinearOpComposite>(
+                                     new FdmHestonOp(mesher, process))));
+            scheme_->setStep(1.0/fdSteps);
+
+            values_ = boost::shared_ptr<Array>(
+                                   new Array(mesher->layout()->size()));
+            const FdmLinearOpIterator endIter = mesher->layout()->end();
+            for (FdmLinearOpIterator iter = mesher->layout()->begin();
+                 iter != endIter; ++iter)
+                (*values_)[iter.index()] =
+                    std::max(std::exp(mesher->location(iter, 0))-100.0,
+                             0.0);
+
+            scheme_->step(*values_, 1.0);
+        }
+        void operator()() const {
+            const unsigned long allocations = allocationCount;
+            for (Size i=fdSteps; i>0; --i)
+                scheme_->step(*values_, Real(i)/fdSteps);
+            QL_REQUIRE(allocationCount == allocations,
+                       allocationCount - allocations
+                       << " heap allocations in " << fdSteps
+                       << " time steps");
+        }
+      private:
+        boost::shared_ptr<DouglasScheme> scheme_;
+        boost::shared_ptr<Array> values_;
+    };
+
+    const Size mcSamples = 50000;
+
+    void priceMcEuropeanOption() {
+        SavedSettings backup;
+
+        const Date today(15, March, 2016);
+        Settings::instance().evaluationDate() = today;
+
+        VanillaOption option(
+            boost::shared_ptr<StrikedTypePayoff>(
+                new PlainVanillaPayoff(Option::Call, 100.0)),
+            boost::shared_ptr<Exercise>(
+                new EuropeanExercise(today + Period(1, Years))));
+        option.setPricingEngine(
+            MakeMCEuropeanEngine<PseudoRandom>(blackScholesProcess(today))
+            .withSteps(10)
+            .withSamples(mcSamples)
+            .withSeed(42));
+        QL_REQUIRE(option.NPV() > 0.0, "invalid option price");
+    }
+
+    const Size cashFlowIterations = 200;
+
+    void analyzeFixedRateLeg() {
+        SavedSettings backup;
+
+        const Calendar calendar = TARGET();
+        const Date today(15, March, 2016);
+        Settings::instance().evaluationDate() = today;
+        const Date settlement = calendar.advance(today, 2, Days);
+        const DayCounter dc = Thirty360(Thirty360::BondBasis);
+
+        const Schedule schedule(settlement, settlement + 30*Years,
+                                Period(Semiannual), calendar,
+                                Unadjusted, Unadjusted,
+                                DateGeneration::Backward, false);
+        const Leg leg = FixedRateLeg(schedule)
+            .withNotionals(100.0)
+            .withCouponRates(0.04, dc);
+        const boost::shared_ptr<YieldTermStructure> curve =
+            flatRate(today, 0.03, Actual365Fixed());
+
+        Real sum = 0.0;
+        for (Size i=0; i<cashFlowIterations; ++i) {
+            const Real npv = CashFlows::npv(leg, *curve, false, settlement);
+            sum += CashFlows::bps(leg, *curve, false, settlement);
+            const Rate y = CashFlows::yield(leg, npv, dc, Compounded,
+                                            Semiannual, false, settlement);
+            sum += CashFlows::duration(leg, y, dc, Compounded, Semiannual,
+                                       Duration::Modified, false,
+                                       settlement);
+        }
+        QL_REQUIRE(sum > 0.0, "invalid cash-flow analytics");
+    }
+
+    const Size calendarDays = 3650;
+
+    void calendarArithmetic() {
+        const Calendar calendars[] = {
+            TARGET(),
+            UnitedStates(UnitedStates::NYSE),
+            JointCalendar(UnitedKingdom(UnitedKingdom::Exchange),
+                          Japan(), JoinHolidays) };
+
+        const Date start(1, January, 2016);
+        BigInteger sum = 0;
+        for (Size i=0; i<LENGTH(calendars); ++i) {
+            for (Size j=0; j<calendarDays; ++j) {
+                const Date d = start + BigInteger(j);
+                const Date next = calendars[i].advance(d, 2, Days);
+                sum += calendars[i].businessDaysBetween(d, next + 30);
+                sum += calendars[i].isEndOfMonth(d);
+            }
+        }
+        QL_REQUIRE(sum > 0, "invalid calendar arithmetic");
+    }
+
 }
 
 #if defined(QL_ENABLE_SESSIONS)
@@ -229,68 +741,85 @@ namespace QuantLib {
 
 test_suite* init_unit_test_suite(int, char*[]) {
 
-    bm.push_back(Benchmark("AmericanOption::FdAmericanGreeks",
-        &AmericanOptionTest::testFdAmericanGreeks, 518.31));
-    bm.push_back(Benchmark("AmericanOption::FdShoutGreeks",
-        &AmericanOptionTest::testFdShoutGreeks, 546.58));
-    bm.push_back(Benchmark("AsianOption::MCArithmeticAveragePrice",
-        &AsianOptionTest::testMCDiscreteArithmeticAveragePrice, 5186.13));
-    bm.push_back(Benchmark("BarrierOption::BabsiriValues",
-        &BarrierOptionTest::testBabsiriValues, 880.8));
-    bm.push_back(Benchmark("BasketOption::EuroTwoValues",
-        &BasketOptionTest::testEuroTwoValues, 340.04));
-    bm.push_back(Benchmark("BasketOption::TavellaValues",
-        &BasketOptionTest::testTavellaValues, 933.80));
-    bm.push_back(Benchmark("BasketOption::OddSamples",
-        &BasketOptionTest::testOddSamples, 642.46));
-    bm.push_back(Benchmark("BatesModel::DAXCalibration",
-        &BatesModelTest::testDAXCalibration, 1993.35));
-    bm.push_back(Benchmark("ConvertibleBondTest::testBond",
-        &ConvertibleBondTest::testBond, 159.85));
-    bm.push_back(Benchmark("DigitalOption::MCCashAtHit",
-        &DigitalOptionTest::testMCCashAtHit,995.87));
-    bm.push_back(Benchmark("DividendOption::FdEuropeanGreeks",
-        &DividendOptionTest::testFdEuropeanGreeks, 949.52));
-    bm.push_back(Benchmark("DividendOption::FdAmericanGreeks",
-        &DividendOptionTest::testFdAmericanGreeks, 1113.74));
-    bm.push_back(Benchmark("EuropeanOption::FdMcEngines",
-        &EuropeanOptionTest::testMcEngines, 1988.63));
-    bm.push_back(Benchmark("EuropeanOption::ImpliedVol",
-        &EuropeanOptionTest::testImpliedVol, 131.51));
-    bm.push_back(Benchmark("EuropeanOption::FdEngines",
-        &EuropeanOptionTest::testFdEngines, 148.43));
-    bm.push_back(Benchmark("EuropeanOption::PriceCurve",
-        &EuropeanOptionTest::testPriceCurve, 414.76));
-    bm.push_back(Benchmark("FdHestonTest::testFdmHestonAmerican",
-        &FdHestonTest::testFdmHestonAmerican, 234.21));
-    bm.push_back(Benchmark("HestonModel::DAXCalibration",
-        &HestonModelTest::testDAXCalibration, 555.19));
-    bm.push_back(Benchmark("InterpolationTest::testSabrInterpolation",
-        &InterpolationTest::testSabrInterpolation, 2266.06));
-    bm.push_back(Benchmark("JumpDiffusion::Greeks",
-        &JumpDiffusionTest::testGreeks, 433.77));
-    bm.push_back(Benchmark("MarketModelCmsTest::testCmSwapsSwaptions",
-        &MarketModelCmsTest::testMultiStepCmSwapsAndSwaptions,
-        11497.73));
-    bm.push_back(Benchmark("MarketModelSmmTest::testMultiSmmSwaptions",
-        &MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions,
-        11244.95));
-    bm.push_back(Benchmark("QuantoOption::ForwardGreeks",
-        &QuantoOptionTest::testForwardGreeks, 90.98));
-    bm.push_back(Benchmark("RandomNumber::MersenneTwisterDescrepancy",
-        &LowDiscrepancyTest::testMersenneTwisterDiscrepancy, 951.98));
-    bm.push_back(Benchmark("RiskStatistics::Results",
-        &RiskStatisticsTest::testResults, 300.28));
-    bm.push_back(Benchmark("ShortRateModel::Swaps",
-        &ShortRateModelTest::testSwaps, 454.73));
+    parseOptions(framework::master_test_suite().argc,
+                 framework::master_test_suite().argv);
+
+    bm.push_back(Benchmark("Curves::SwapCurveBootstrap", "curves",
+        &bootstrapSwapCurve, 20, "bootstraps"));
+    bm.push_back(Benchmark("FiniteDifferences::BlackScholesAmerican", "fd",
+        &priceFdAmericanOptions, 5, "prices"));
+    bm.push_back(Benchmark("FiniteDifferences::HestonEuropean", "fd",
+        &priceFdHestonOption, 1, "prices"));
+    bm.push_back(Benchmark("FiniteDifferences::HestonDouglasSteps", "fd",
+        HestonDouglasSteps(), fdSteps, "steps"));
+    bm.push_back(Benchmark("MonteCarlo::EuropeanPseudoRandom", "mc",
+        &priceMcEuropeanOption, mcSamples, "paths"));
+    bm.push_back(Benchmark("CashFlows::FixedRateLegAnalytics", "cashflows",
+        &analyzeFixedRateLeg, 4*cashFlowIterations, "evaluations"));
+    bm.push_back(Benchmark("Calendars::BusinessDayArithmetic", "calendars",
+        &calendarArithmetic, 3*2*calendarDays, "calls"));
+
+    bm.push_back(Benchmark("AmericanOption::FdAmericanGreeks", "fd",
+        &AmericanOptionTest::testFdAmericanGreeks));
+    bm.push_back(Benchmark("AmericanOption::FdShoutGreeks", "fd",
+        &AmericanOptionTest::testFdShoutGreeks));
+    bm.push_back(Benchmark("AsianOption::MCArithmeticAveragePrice", "mc",
+        &AsianOptionTest::testMCDiscreteArithmeticAveragePrice));
+    bm.push_back(Benchmark("BarrierOption::BabsiriValues", "analytic",
+        &BarrierOptionTest::testBabsiriValues));
+    bm.push_back(Benchmark("BasketOption::EuroTwoValues", "mc",
+        &BasketOptionTest::testEuroTwoValues));
+    bm.push_back(Benchmark("BasketOption::TavellaValues", "mc",
+        &BasketOptionTest::testTavellaValues));
+    bm.push_back(Benchmark("BasketOption::OddSamples", "mc",
+        &BasketOptionTest::testOddSamples));
+    bm.push_back(Benchmark("BatesModel::DAXCalibration", "calibration",
+        &BatesModelTest::testDAXCalibration));
+    bm.push_back(Benchmark("ConvertibleBond::Bond", "lattice",
+        &ConvertibleBondTest::testBond));
+    bm.push_back(Benchmark("DigitalOption::MCCashAtHit", "mc",
+        &DigitalOptionTest::testMCCashAtHit));
+    bm.push_back(Benchmark("DividendOption::FdEuropeanGreeks", "fd",
+        &DividendOptionTest::testFdEuropeanGreeks));
+    bm.push_back(Benchmark("DividendOption::FdAmericanGreeks", "fd",
+        &DividendOptionTest::testFdAmericanGreeks));
+    bm.push_back(Benchmark("EuropeanOption::McEngines", "mc",
+        &EuropeanOptionTest::testMcEngines));
+    bm.push_back(Benchmark("EuropeanOption::ImpliedVol", "analytic",
+        &EuropeanOptionTest::testImpliedVol));
+    bm.push_back(Benchmark("EuropeanOption::FdEngines", "fd",
+        &EuropeanOptionTest::testFdEngines));
+    bm.push_back(Benchmark("EuropeanOption::PriceCurve", "fd",
+        &EuropeanOptionTest::testPriceCurve));
+    bm.push_back(Benchmark("FdHeston::FdmHestonAmerican", "fd",
+        &FdHestonTest::testFdmHestonAmerican));
+    bm.push_back(Benchmark("HestonModel::DAXCalibration", "calibration",
+        &HestonModelTest::testDAXCalibration));
+    bm.push_back(Benchmark("Interpolation::SabrInterpolation", "calibration",
+        &InterpolationTest::testSabrInterpolation));
+    bm.push_back(Benchmark("JumpDiffusion::Greeks", "analytic",
+        &JumpDiffusionTest::testGreeks));
+    bm.push_back(Benchmark("MarketModelCms::MultiStepCmSwapsSwaptions",
+        "marketmodels",
+        &MarketModelCmsTest::testMultiStepCmSwapsAndSwaptions));
+    bm.push_back(Benchmark("MarketModelSmm::MultiStepCoterminalSwaptions",
+        "marketmodels",
+        &MarketModelSmmTest::testMultiStepCoterminalSwapsAndSwaptions));
+    bm.push_back(Benchmark("QuantoOption::ForwardGreeks", "analytic",
+        &QuantoOptionTest::testForwardGreeks));
+    bm.push_back(Benchmark("RandomNumber::MersenneTwisterDiscrepancy",
+        "random", &LowDiscrepancyTest::testMersenneTwisterDiscrepancy));
+    bm.push_back(Benchmark("RiskStatistics::Results", "statistics",
+        &RiskStatisticsTest::testResults));
+    bm.push_back(Benchmark("ShortRateModel::Swaps", "lattice",
+        &ShortRateModelTest::testSwaps));
 
     test_suite* test = BOOST_TEST_SUITE("QuantLib benchmark suite");
 
-    for (std::list<Benchmark>::const_iterator iter = bm.begin();
-         iter != bm.end(); ++iter) {
-        test->add(QUANTLIB_TEST_CASE(startTimer));
-        test->add(iter->getTestCase());
-        test->add(QUANTLIB_TEST_CASE(stopTimer));
+    for (Size i=0; i<bm.size(); ++i) {
+        if (options.subsystems.empty()
+            || options.subsystems.count(bm[i].subsystem()) > 0)
+            test->add(QUANTLIB_TEST_CASE(boost::bind(&runBenchmark, i)));
     }
 
     test->add(QUANTLIB_TEST_CASE(printResults));
@@ -29,6 +29,10 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/pricingengines/blackformula.hpp>
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+#endif
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -43,6 +47,34 @@ namespace {
     Real mul(Real x, Real y) { return x*y; }
     Real sub(Real x, Real y) { return x-y; }
 
+    class UpdateCounter : public Observer {
+      public:
+        UpdateCounter() : counter_(0) {}
+        void update() { ++counter_; }
+        Size counter() const { return counter_; }
+      private:
+        Size counter_;
+    };
+
+    // forwards notifications, as e.g. a rate helper would do
+    class Relay : public Observer, public Observable {
+      public:
+        void update() { notifyObservers(); }
+    };
+
+    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    void registerAndUnregister(const boost::shared_ptr<Quote>& q,
+                               Size times) {
+        for (Size i=0; i<times; ++i) {
+            Flag f;
+            f.registerWith(q);
+            boost::shared_ptr<Relay> r(new Relay);
+            r->registerWith(q);
+            f.registerWith(r);
+        }
+    }
+    #endif
+
 }
 
 
@@ -195,6 +227,83 @@ void QuoteTest::testForwardValueQuoteAndImpliedStdevQuote(){
 
 }
 
+void QuoteTest::testDeferredNotification() {
+
+    BOOST_TEST_MESSAGE("Testing deferred notification of quote changes...");
+
+    const Size n = 50;
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes(n);
+    std::vector<boost::shared_ptr<Relay> > relays(n);
+    UpdateCounter direct, indirect;
+    for (Size i=0; i<n; ++i) {
+        quotes[i] = boost::shared_ptr<SimpleQuote>(new SimpleQuote(0.0));
+        relays[i] = boost::shared_ptr<Relay>(new Relay);
+        relays[i]->registerWith(quotes[i]);
+        direct.registerWith(quotes[i]);
+        indirect.registerWith(relays[i]);
+    }
+
+    ObservableSettings& settings = ObservableSettings::instance();
+
+    settings.disableUpdates(true);
+    for (Size i=0; i<n; ++i)
+        quotes[i]->setValue(Real(i));
+    if (direct.counter() != 0 || indirect.counter() != 0)
+        BOOST_FAIL("observers notified while updates are deferred");
+    settings.enableUpdates();
+
+    if (direct.counter() != 1)
+        BOOST_ERROR("direct observer notified " << direct.counter()
+                    << " times (expected once)");
+    if (indirect.counter() != 1)
+        BOOST_ERROR("indirect observer notified " << indirect.counter()
+                    << " times (expected once)");
+
+    // disabled (not deferred) notifications are discarded
+    settings.disableUpdates();
+    for (Size i=0; i<n; ++i)
+        quotes[i]->setValue(Real(i+1));
+    settings.enableUpdates();
+    if (direct.counter() != 1 || indirect.counter() != 1)
+        BOOST_ERROR("discarded notifications were sent");
+
+    // observers destroyed before the commit must not be notified
+    Flag* flag = new Flag;
+    flag->registerWith(quotes[0]);
+    settings.disableUpdates(true);
+    quotes[0]->setValue(42.0);
+    delete flag;
+    settings.enableUpdates();
+    if (direct.counter() != 2 || indirect.counter() != 2)
+        BOOST_ERROR("deferred notifications not sent after commit");
+
+    // back to immediate notification
+    quotes[0]->setValue(0.0);
+    if (direct.counter() != 3 || indirect.counter() != 3)
+        BOOST_ERROR("immediate notifications not restored");
+}
+
+void QuoteTest::testThreadSafeRegistration() {
+
+    BOOST_TEST_MESSAGE("Testing concurrent registration with quotes...");
+
+    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    boost::shared_ptr<SimpleQuote> me(new SimpleQuote(0.0));
+
+    boost::thread_group threads;
+    for (Size i=0; i<4; ++i)
+        threads.create_thread(boost::bind(registerAndUnregister,
+                                          me, Size(10000)));
+    threads.join_all();
+
+    Flag f;
+    f.registerWith(me);
+    me->setValue(3.14);
+    if (!f.isUp())
+        BOOST_FAIL("Observer was not notified of quote change");
+    #endif
+}
+
 
 test_suite* QuoteTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Quote tests");
@@ -204,6 +313,10 @@ test_suite* QuoteTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testComposite));
     suite->add(QUANTLIB_TEST_CASE(
                       &QuoteTest::testForwardValueQuoteAndImpliedStdevQuote));
+    suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testDeferredNotification));
+    #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    suite->add(QUANTLIB_TEST_CASE(&QuoteTest::testThreadSafeRegistration));
+    #endif
     return suite;
 }
 
@@ -24,6 +24,8 @@
 #include "shortratemodels.hpp"
 #include "utilities.hpp"
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/twofactormodels/g2.hpp>
+#include <ql/discretizedasset.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
@@ -50,6 +52,103 @@ namespace {
         Volatility volatility;
     };
 
+    // pays a coupon on each of the given dates; the accrued value is capped
+    class DiscretizedCappedNote : public DiscretizedAsset {
+      public:
+        DiscretizedCappedNote(const std::vector<Time>& paymentTimes,
+                              Real coupon, Real cap)
+        : paymentTimes_(paymentTimes), coupon_(coupon), cap_(cap) {}
+        void reset(Size size) {
+            values_ = Array(size, 1.0);
+            adjustValues();
+        }
+        std::vector<Time> mandatoryTimes() const {
+            return paymentTimes_;
+        }
+      protected:
+        void postAdjustValuesImpl() {
+            for (Size i=0; i<paymentTimes_.size(); ++i) {
+                if (isOnTime(paymentTimes_[i])) {
+                    for (Size j=0; j<values_.size(); ++j)
+                        values_[j] = std::min(values_[j]+coupon_, cap_);
+                }
+            }
+        }
+      private:
+        std::vector<Time> paymentTimes_;
+        Real coupon_, cap_;
+    };
+
+    template <class Tree>
+    Real referenceDiscountBond(const Tree& tree, Size branches) {
+        const TimeGrid& grid = tree.timeGrid();
+        Array values(tree.size(grid.size()-1), 1.0);
+        for (Size i=grid.size()-1; i>0; --i) {
+            Array newValues(tree.size(i-1));
+            for (Size j=0; j<newValues.size(); ++j) {
+                Real value = 0.0;
+                for (Size l=0; l<branches; ++l)
+                    value += tree.probability(i-1,j,l) *
+                             values[tree.descendant(i-1,j,l)];
+                newValues[j] = value*tree.discount(i-1,j);
+            }
+            values.swap(newValues);
+        }
+        return values[0];
+    }
+
+    void checkLatticeRollback(const boost::shared_ptr<Lattice>& lattice,
+                              const std::vector<Time>& paymentTimes,
+                              Time maturity, Real expectedBond,
+                              const std::string& tag) {
+        Real tolerance = 1.0e-12;
+
+        DiscretizedDiscountBond bond;
+        bond.initialize(lattice, maturity);
+        bond.rollback(0.0);
+        if (std::fabs(bond.values()[0]-expectedBond) > tolerance)
+            BOOST_ERROR("failed to reproduce reference rollback on "
+                        << tag << " lattice:"
+                        << QL_FIXED << std::setprecision(12)
+                        << "\n    calculated: " << bond.values()[0]
+                        << "\n    expected:   " << expectedBond);
+
+        DiscretizedCappedNote note1(paymentTimes, 0.02, 1.05);
+        DiscretizedCappedNote note2(paymentTimes, 0.05, 1.10);
+        note1.initialize(lattice, maturity);
+        note1.rollback(0.0);
+        note2.initialize(lattice, maturity);
+        note2.rollback(0.0);
+
+        DiscretizedDiscountBond jointBond;
+        DiscretizedCappedNote jointNote1(paymentTimes, 0.02, 1.05);
+        DiscretizedCappedNote jointNote2(paymentTimes, 0.05, 1.10);
+        jointBond.initialize(lattice, maturity);
+        jointNote1.initialize(lattice, maturity);
+        jointNote2.initialize(lattice, maturity);
+        std::vector<DiscretizedAsset*> assets;
+        assets.push_back(&jointBond);
+        assets.push_back(&jointNote1);
+        assets.push_back(&jointNote2);
+        lattice->rollback(assets, 0.0);
+
+        Real single[] = { bond.values()[0],
+                          note1.values()[0], note2.values()[0] };
+        for (Size k=0; k<assets.size(); ++k) {
+            if (assets[k]->time() != 0.0)
+                BOOST_ERROR("joint rollback on " << tag << " lattice "
+                            "left asset #" << k << " at time "
+                            << assets[k]->time());
+            if (std::fabs(assets[k]->values()[0]-single[k]) > tolerance)
+                BOOST_ERROR("joint rollback on " << tag << " lattice "
+                            "does not match single-asset rollback "
+                            "for asset #" << k << ":"
+                            << QL_FIXED << std::setprecision(12)
+                            << "\n    joint:  " << assets[k]->values()[0]
+                            << "\n    single: " << single[k]);
+        }
+    }
+
 }
 
 
@@ -427,6 +526,41 @@ void ShortRateModelTest::testFuturesConvexityBias() {
     }
 }
 
+void ShortRateModelTest::testLatticeRollback() {
+    BOOST_TEST_MESSAGE("Testing joint rollback of assets on short-rate trees...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(
+                                  flatRate(today, 0.04, Actual360()));
+
+    Time maturity = 5.0;
+    std::vector<Time> paymentTimes;
+    for (Size i=1; i<=5; ++i)
+        paymentTimes.push_back(Real(i));
+    TimeGrid grid(paymentTimes.begin(), paymentTimes.end(), 60);
+
+    boost::shared_ptr<HullWhite> hullWhite(
+                               new HullWhite(termStructure, 0.1, 0.01));
+    boost::shared_ptr<Lattice> tree1D = hullWhite->tree(grid);
+    boost::shared_ptr<OneFactorModel::ShortRateTree> shortRateTree1D =
+        boost::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(tree1D);
+    QL_REQUIRE(shortRateTree1D, "unexpected Hull-White tree type");
+    checkLatticeRollback(tree1D, paymentTimes, maturity,
+                         referenceDiscountBond(*shortRateTree1D, 3),
+                         "Hull-White");
+
+    boost::shared_ptr<G2> g2(new G2(termStructure));
+    boost::shared_ptr<Lattice> tree2D = g2->tree(grid);
+    boost::shared_ptr<TwoFactorModel::ShortRateTree> shortRateTree2D =
+        boost::dynamic_pointer_cast<TwoFactorModel::ShortRateTree>(tree2D);
+    QL_REQUIRE(shortRateTree2D, "unexpected G2 tree type");
+    checkLatticeRollback(tree2D, paymentTimes, maturity,
+                         referenceDiscountBond(*shortRateTree2D, 9),
+                         "G2");
+}
+
 test_suite* ShortRateModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
@@ -434,6 +568,7 @@ test_suite* ShortRateModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testLatticeRollback));
     return suite;
 }
 
@@ -32,6 +32,7 @@ class ShortRateModelTest {
     static void testCachedHullWhiteFixedReversion();
     static void testCachedHullWhite2();
     static void testSwaps();
+    static void testLatticeRollback();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -25,6 +25,8 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actual360.hpp>
@@ -334,6 +336,98 @@ void TermStructureTest::testLinkToNullUnderlying() {
     underlying.linkTo(boost::shared_ptr<YieldTermStructure>());
 }
 
+void TermStructureTest::testBatchEvaluation() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing batch evaluation of discount factors and forwards...");
+
+    CommonVars vars;
+
+    Date today = Settings::instance().evaluationDate();
+    Date settlement = vars.termStructure->referenceDate();
+    DayCounter dc = Actual360();
+
+    std::vector<Date> dates;
+    std::vector<Rate> zeros;
+    std::vector<DiscountFactor> dfs;
+    for (Size i=0; i<8; ++i) {
+        dates.push_back(settlement + Period(2*i*i, Months));
+        zeros.push_back(0.02 + 0.003*i);
+        dfs.push_back(std::exp(-0.03*dc.yearFraction(settlement,
+                                                      dates.back())));
+    }
+    dfs[0] = 1.0;
+
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(
+                 boost::shared_ptr<Quote>(new SimpleQuote(0.995))));
+    std::vector<Date> jumpDates(1, settlement + 18*Months);
+
+    Handle<Quote> spread(boost::shared_ptr<Quote>(new SimpleQuote(0.005)));
+    Handle<YieldTermStructure> base(vars.termStructure);
+
+    std::vector<boost::shared_ptr<YieldTermStructure> > curves;
+    curves.push_back(vars.termStructure);
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                              new FlatForward(today, 0.04, dc)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                              new DiscountCurve(dates, dfs, dc)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+        new InterpolatedDiscountCurve<LogLinear>(dates, dfs, dc, Calendar(),
+                                                 jumps, jumpDates)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+        new ZeroCurve(dates, zeros, dc, Calendar(), jumps, jumpDates)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                    new ForwardSpreadedTermStructure(base, spread)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                    new ZeroSpreadedTermStructure(base, spread)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+        new ZeroSpreadedTermStructure(base, spread, Compounded, Annual)));
+
+    std::vector<Time> t1, t2;
+    for (Size i=0; i<50; ++i) {
+        // unsorted and repeated times are allowed
+        Time t = 0.37*((i*7) % 50);
+        t1.push_back(t);
+        t2.push_back(i%10 == 0 ? t : t + 0.5);
+    }
+    t1.push_back(0.0);
+    t2.push_back(0.25);
+
+    Real tolerance = 1.0e-14;
+    for (Size k=0; k<curves.size(); ++k) {
+        const YieldTermStructure& curve = *curves[k];
+        std::vector<DiscountFactor> discounts(t1.size());
+        std::vector<Rate> forwards(t1.size());
+        curve.discounts(t1, &discounts[0], true);
+        curve.forwardRates(t1, t2, Continuous, NoFrequency,
+                           &forwards[0], true);
+        for (Size i=0; i<t1.size(); ++i) {
+            DiscountFactor expected = curve.discount(t1[i], true);
+            if (std::fabs(discounts[i]-expected) > tolerance)
+                BOOST_ERROR("batch discount mismatch for curve #" << k
+                            << std::setprecision(16)
+                            << "\n    time:       " << t1[i]
+                            << "\n    calculated: " << discounts[i]
+                            << "\n    expected:   " << expected);
+            Rate expectedForward =
+                curve.forwardRate(t1[i], t2[i], Continuous, NoFrequency,
+                                  true);
+            if (std::fabs(forwards[i]-expectedForward) > 1.0e-12)
+                BOOST_ERROR("batch forward mismatch for curve #" << k
+                            << std::setprecision(16)
+                            << "\n    times:      " << t1[i]
+                            << ", " << t2[i]
+                            << "\n    calculated: " << forwards[i]
+                            << "\n    expected:   " << expectedForward);
+        }
+    }
+
+    // out-of-range times are still checked
+    std::vector<Time> tooLong(1, 100.0);
+    DiscountFactor df;
+    BOOST_CHECK_THROW(curves[2]->discounts(tooLong, &df), Error);
+}
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -347,6 +441,7 @@ test_suite* TermStructureTest::suite() {
                          &TermStructureTest::testCreateWithNullUnderlying));
     suite->add(QUANTLIB_TEST_CASE(
                              &TermStructureTest::testLinkToNullUnderlying));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBatchEvaluation));
     return suite;
 }
 